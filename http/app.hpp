@@ -93,6 +93,7 @@ class App
     void run()
     {
         validate();
+        startup::mark("router");
 #ifdef BMCWEB_ENABLE_SSL
         if (-1 == socketFd)
         {
@@ -0,0 +1,747 @@
+#pragma once
+#include "bmcweb_config.h"
+
+#include "authorization.hpp"
+#include "http_connection.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "http_utility.hpp"
+#include "logging.hpp"
+#include "nghttp2_adapters.hpp"
+#include "timer_queue.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/stream_traits.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/ssl/ssl_stream.hpp>
+#include <security_headers.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace crow
+{
+
+// Settings advertised to HTTP/2 clients.  Every stream holds a complete
+// request and response in memory, so keep the number that may be in flight on
+// one connection small.
+constexpr uint32_t http2MaxConcurrentStreams = 32;
+constexpr uint32_t http2InitialWindowSize = 256 * 1024;
+
+struct Http2StreamData
+{
+    boost::beast::http::request<boost::beast::http::string_body> parserReq;
+    std::optional<crow::Request> req;
+    crow::Response res;
+    std::shared_ptr<persistent_data::UserSession> userSession;
+    size_t sentSofar = 0;
+    // Set once the request headers have been authenticated, so trailers
+    // don't authenticate the stream again
+    bool authenticated = false;
+    // Set when the client has reset or closed the stream while its handler is
+    // still running.  The stream is dropped once the handler completes.
+    bool closed = false;
+};
+
+// One HTTP/2 connection, multiplexing any number of requests over a single
+// socket.  nghttp2 handles the framing, HPACK and flow control; this class
+// feeds it bytes from the socket, turns complete streams into crow::Requests
+// for the router, and queues the responses back up as they complete, in
+// whatever order the handlers finish.
+template <typename Adaptor, typename Handler>
+class HTTP2Connection :
+    public std::enable_shared_from_this<HTTP2Connection<Adaptor, Handler>>
+{
+    using self_type = HTTP2Connection<Adaptor, Handler>;
+
+  public:
+    HTTP2Connection(
+        Adaptor&& adaptorIn, Handler* handlerIn,
+        std::function<std::string()>& getCachedDateStrF,
+        detail::TimerQueue& timerQueueIn,
+        std::shared_ptr<persistent_data::UserSession> transportSession) :
+        adaptor(std::move(adaptorIn)),
+        handler(handlerIn), getCachedDateStr(getCachedDateStrF),
+        timerQueue(timerQueueIn), userSession(std::move(transportSession))
+    {
+        http2::SessionCallbacks callbacks;
+        callbacks.setOnFrameRecvCallback(onFrameRecvCallbackStatic);
+        callbacks.setOnStreamCloseCallback(onStreamCloseCallbackStatic);
+        callbacks.setOnHeaderCallback(onHeaderCallbackStatic);
+        callbacks.setOnBeginHeadersCallback(onBeginHeadersCallbackStatic);
+        callbacks.setOnDataChunkRecvCallback(onDataChunkRecvCallbackStatic);
+
+        http2::SessionOption option;
+        // Responses are small and mostly unique, so a large dynamic table
+        // buys little for the memory it costs per connection
+        option.setMaxDeflateDynamicTableSize(4096);
+
+        // nghttp2 copies the callbacks and options, so they only need to
+        // live until the session is created
+        ngSession.emplace(callbacks, option, this);
+    }
+
+    ~HTTP2Connection()
+    {
+        cancelDeadlineTimer();
+        for (std::pair<const int32_t, std::unique_ptr<Http2StreamData>>&
+                 stream : streams)
+        {
+            stream.second->res.setCompleteRequestHandler(nullptr);
+            releaseSession(*stream.second);
+        }
+    }
+
+    HTTP2Connection(const HTTP2Connection&) = delete;
+    HTTP2Connection& operator=(const HTTP2Connection&) = delete;
+    HTTP2Connection(HTTP2Connection&&) = delete;
+    HTTP2Connection& operator=(HTTP2Connection&&) = delete;
+
+    void start()
+    {
+        if (!ngSession->valid())
+        {
+            close();
+            return;
+        }
+        std::array<nghttp2_settings_entry, 2> settings = {{
+            {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+             http2MaxConcurrentStreams},
+            {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, http2InitialWindowSize},
+        }};
+        if (ngSession->submitSettings(settings) != 0)
+        {
+            BMCWEB_LOG_ERROR << this << " Failed to submit HTTP/2 settings";
+            close();
+            return;
+        }
+        // Allow uploads on the connection as a whole to move as fast as the
+        // per stream window does
+        ngSession->setLocalWindowSize(
+            static_cast<int32_t>(http2InitialWindowSize));
+
+        readClientIp();
+        startDeadline();
+        writeBuffer();
+        doRead();
+    }
+
+  private:
+    static HTTP2Connection& userPtrToSelf(void* userPtr)
+    {
+        return *static_cast<HTTP2Connection*>(userPtr);
+    }
+
+    Http2StreamData* findStream(int32_t streamId)
+    {
+        auto it = streams.find(streamId);
+        if (it == streams.end())
+        {
+            return nullptr;
+        }
+        return it->second.get();
+    }
+
+    static int onBeginHeadersCallbackStatic(nghttp2_session* /* session */,
+                                            const nghttp2_frame* frame,
+                                            void* userData)
+    {
+        return userPtrToSelf(userData).onBeginHeadersCallback(*frame);
+    }
+
+    int onBeginHeadersCallback(const nghttp2_frame& frame)
+    {
+        if (frame.hd.type != NGHTTP2_HEADERS ||
+            frame.headers.cat != NGHTTP2_HCAT_REQUEST)
+        {
+            return 0;
+        }
+        BMCWEB_LOG_DEBUG << this << " New HTTP/2 stream "
+                         << frame.hd.stream_id;
+        std::unique_ptr<Http2StreamData>& stream =
+            streams[frame.hd.stream_id];
+        stream = std::make_unique<Http2StreamData>();
+        stream->parserReq.version(11);
+        return 0;
+    }
+
+    static int onHeaderCallbackStatic(nghttp2_session* /* session */,
+                                      const nghttp2_frame* frame,
+                                      const uint8_t* name, size_t namelen,
+                                      const uint8_t* value, size_t vallen,
+                                      uint8_t /* flags */, void* userData)
+    {
+        std::string_view nameSv(reinterpret_cast<const char*>(name), namelen);
+        std::string_view valueSv(reinterpret_cast<const char*>(value),
+                                 vallen);
+        return userPtrToSelf(userData).onHeaderCallback(*frame, nameSv,
+                                                        valueSv);
+    }
+
+    int onHeaderCallback(const nghttp2_frame& frame, std::string_view name,
+                         std::string_view value)
+    {
+        if (frame.hd.type != NGHTTP2_HEADERS ||
+            frame.headers.cat != NGHTTP2_HCAT_REQUEST)
+        {
+            return 0;
+        }
+        Http2StreamData* stream = findStream(frame.hd.stream_id);
+        if (stream == nullptr)
+        {
+            return 0;
+        }
+        boost::beast::http::request<boost::beast::http::string_body>& req =
+            stream->parserReq;
+        if (name == ":method")
+        {
+            boost::beast::http::verb verb =
+                boost::beast::http::string_to_verb(value);
+            if (verb == boost::beast::http::verb::unknown)
+            {
+                BMCWEB_LOG_ERROR << this << " Unknown method " << value;
+                return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+            }
+            req.method(verb);
+        }
+        else if (name == ":path")
+        {
+            req.target(value);
+        }
+        else if (name == ":authority")
+        {
+            req.set(boost::beast::http::field::host, value);
+        }
+        else if (!name.starts_with(':'))
+        {
+            // nghttp2 has already rejected malformed and connection specific
+            // header fields
+            req.insert(name, value);
+        }
+        return 0;
+    }
+
+    static int onDataChunkRecvCallbackStatic(nghttp2_session* /* session */,
+                                             uint8_t /* flags */,
+                                             int32_t streamId,
+                                             const uint8_t* data, size_t len,
+                                             void* userData)
+    {
+        std::string_view chunk(reinterpret_cast<const char*>(data), len);
+        return userPtrToSelf(userData).onDataChunkRecvCallback(streamId,
+                                                               chunk);
+    }
+
+    int onDataChunkRecvCallback(int32_t streamId, std::string_view chunk)
+    {
+        Http2StreamData* stream = findStream(streamId);
+        if (stream == nullptr)
+        {
+            return 0;
+        }
+        std::string& body = stream->parserReq.body();
+        size_t limit = stream->userSession != nullptr
+                           ? httpReqBodyLimit
+                           : static_cast<size_t>(loggedOutPostBodyLimit);
+        if (body.size() + chunk.size() > limit)
+        {
+            BMCWEB_LOG_DEBUG << this << " Stream " << streamId
+                             << " body larger than limit " << limit;
+            ngSession->submitRstStream(streamId, NGHTTP2_REFUSED_STREAM);
+            return 0;
+        }
+        body += chunk;
+        return 0;
+    }
+
+    static int onFrameRecvCallbackStatic(nghttp2_session* /* session */,
+                                         const nghttp2_frame* frame,
+                                         void* userData)
+    {
+        return userPtrToSelf(userData).onFrameRecvCallback(*frame);
+    }
+
+    int onFrameRecvCallback(const nghttp2_frame& frame)
+    {
+        if (frame.hd.type != NGHTTP2_HEADERS && frame.hd.type != NGHTTP2_DATA)
+        {
+            return 0;
+        }
+        Http2StreamData* stream = findStream(frame.hd.stream_id);
+        if (stream == nullptr)
+        {
+            return 0;
+        }
+        if (frame.hd.type == NGHTTP2_HEADERS &&
+            (frame.hd.flags & NGHTTP2_FLAG_END_HEADERS) != 0 &&
+            !stream->authenticated)
+        {
+            // Authenticate as soon as the headers are in, the same as the
+            // HTTP/1 connection does, so that the body limit is known
+            stream->authenticated = true;
+            stream->userSession = crow::authorization::authenticate(
+                clientIp, stream->res, stream->parserReq.method(),
+                stream->parserReq.base(), userSession);
+        }
+        if ((frame.hd.flags & NGHTTP2_FLAG_END_STREAM) != 0)
+        {
+            handleStream(frame.hd.stream_id, *stream);
+        }
+        return 0;
+    }
+
+    static int onStreamCloseCallbackStatic(nghttp2_session* /* session */,
+                                           int32_t streamId,
+                                           uint32_t /* errorCode */,
+                                           void* userData)
+    {
+        return userPtrToSelf(userData).onStreamCloseCallback(streamId);
+    }
+
+    int onStreamCloseCallback(int32_t streamId)
+    {
+        auto it = streams.find(streamId);
+        if (it == streams.end())
+        {
+            return 0;
+        }
+        Http2StreamData& stream = *it->second;
+        if (stream.req && !stream.res.isCompleted())
+        {
+            // The handler still holds a reference to the response
+            BMCWEB_LOG_DEBUG << this << " Stream " << streamId
+                             << " closed while its handler is running";
+            stream.closed = true;
+            return 0;
+        }
+        // A stream reset before its END_STREAM never reaches completeRequest
+        releaseSession(stream);
+        streams.erase(it);
+        return 0;
+    }
+
+    void handleStream(int32_t streamId, Http2StreamData& stream)
+    {
+        std::error_code reqEc;
+        crow::Request& thisReq =
+            stream.req.emplace(std::move(stream.parserReq), reqEc);
+        crow::Response& res = stream.res;
+        if (reqEc)
+        {
+            BMCWEB_LOG_DEBUG << "Request failed to construct" << reqEc;
+            res.result(boost::beast::http::status::bad_request);
+            completeRequest(streamId);
+            return;
+        }
+        thisReq.session = stream.userSession;
+        thisReq.ipAddress = clientIp;
+        thisReq.ioService = static_cast<decltype(thisReq.ioService)>(
+            &adaptor.get_executor().context());
+
+        BMCWEB_LOG_INFO << "Request: " << this << " HTTP/2 stream "
+                        << streamId << ' ' << thisReq.methodString() << " "
+                        << thisReq.target() << " " << thisReq.ipAddress;
+
+        res.isAliveHelper = [this]() -> bool { return isAlive(); };
+
+        if (res.completed)
+        {
+            completeRequest(streamId);
+            return;
+        }
+
+        if (!crow::authorization::isOnWhitelist(thisReq.url,
+                                                thisReq.method()) &&
+            thisReq.session == nullptr)
+        {
+            BMCWEB_LOG_WARNING << "[AuthMiddleware] authorization failed";
+            forward_unauthorized::sendUnauthorized(
+                thisReq.url, thisReq.getHeaderValue("User-Agent"),
+                thisReq.getHeaderValue("Accept"), res);
+            completeRequest(streamId);
+            return;
+        }
+
+        res.setCompleteRequestHandler(
+            [self(shared_from_this()), streamId] {
+                boost::asio::post(self->adaptor.get_executor(),
+                                  [self, streamId] {
+                                      self->completeRequest(streamId);
+                                  });
+            });
+        auto asyncResp = std::make_shared<bmcweb::AsyncResp>(res);
+        handler->handle(thisReq, asyncResp);
+    }
+
+    // Basic auth gives every stream a session of its own, which has to go
+    // however the stream ends
+    static void releaseSession(Http2StreamData& stream)
+    {
+        if (stream.userSession != nullptr &&
+            stream.userSession->persistence ==
+                persistent_data::PersistenceType::SINGLE_REQUEST)
+        {
+            persistent_data::SessionStore::getInstance().removeSession(
+                stream.userSession);
+        }
+        stream.userSession = nullptr;
+    }
+
+    void completeRequest(int32_t streamId)
+    {
+        auto it = streams.find(streamId);
+        if (it == streams.end())
+        {
+            return;
+        }
+        Http2StreamData& stream = *it->second;
+        crow::Response& res = stream.res;
+        // delete lambda with self shared_ptr
+        // to enable connection destruction
+        res.setCompleteRequestHandler(nullptr);
+        if (!stream.req)
+        {
+            return;
+        }
+        crow::Request& req = *stream.req;
+        releaseSession(stream);
+
+        if (stream.closed)
+        {
+            streams.erase(it);
+            return;
+        }
+
+        BMCWEB_LOG_INFO << "Response: " << this << " HTTP/2 stream "
+                        << streamId << ' ' << req.url << ' '
+                        << res.resultInt();
+
+        addSecurityHeaders(req, res);
+
+        if (res.body().empty() && !res.jsonValue.empty())
+        {
+            if (http_helpers::requestPrefersHtml(req.getHeaderValue("Accept")))
+            {
+                prettyPrintJson(res);
+            }
+            else
+            {
+                res.jsonMode();
+                res.body() = res.jsonValue.dump(
+                    2, ' ', true, nlohmann::json::error_handler_t::replace);
+            }
+        }
+
+        if (res.resultInt() >= 400 && res.body().empty())
+        {
+            res.body() = std::string(res.reason());
+        }
+
+        if (res.result() == boost::beast::http::status::no_content)
+        {
+            BMCWEB_LOG_CRITICAL
+                << this << " Response content provided but code was no-content";
+            res.body().clear();
+        }
+
+        res.addHeader(boost::beast::http::field::date, getCachedDateStr());
+        res.preparePayload();
+
+        sendResponse(streamId, stream);
+    }
+
+    void sendResponse(int32_t streamId, Http2StreamData& stream)
+    {
+        crow::Response::response_type& response = *stream.res.stringResponse;
+
+        std::string status = std::to_string(response.result_int());
+        // HTTP/2 field names are lower case, and nghttp2 copies the names and
+        // values when the response is submitted, so these only need to live
+        // for the duration of this call
+        std::vector<std::pair<std::string, std::string_view>> fields;
+        fields.reserve(16);
+        for (const boost::beast::http::fields::value_type& field : response)
+        {
+            if (isConnectionSpecificField(field.name()))
+            {
+                continue;
+            }
+            std::string name(field.name_string());
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](unsigned char c) {
+                               return static_cast<char>(std::tolower(c));
+                           });
+            fields.emplace_back(std::move(name), field.value());
+        }
+
+        std::vector<nghttp2_nv> headers;
+        headers.reserve(fields.size() + 1);
+        headers.push_back(makeNv(":status", status));
+        for (const std::pair<std::string, std::string_view>& field : fields)
+        {
+            headers.push_back(makeNv(field.first, field.second));
+        }
+
+        stream.sentSofar = 0;
+        nghttp2_data_provider dataProvider{};
+        dataProvider.source.ptr = nullptr;
+        dataProvider.read_callback = onReadCallbackStatic;
+
+        int rv = ngSession->submitResponse(
+            streamId, headers,
+            response.body().empty() ? nullptr : &dataProvider);
+        if (rv != 0)
+        {
+            BMCWEB_LOG_ERROR << this << " Failed to submit response on stream "
+                             << streamId << ": " << nghttp2_strerror(rv);
+            streams.erase(streamId);
+            return;
+        }
+        // This may be running from inside an nghttp2 callback, which isn't
+        // allowed to call back into the session to send
+        boost::asio::post(adaptor.get_executor(),
+                          [self(shared_from_this())] { self->writeBuffer(); });
+    }
+
+    // Connection specific fields are not allowed in HTTP/2
+    static bool isConnectionSpecificField(boost::beast::http::field field)
+    {
+        switch (field)
+        {
+            case boost::beast::http::field::connection:
+            case boost::beast::http::field::keep_alive:
+            case boost::beast::http::field::proxy_connection:
+            case boost::beast::http::field::transfer_encoding:
+            case boost::beast::http::field::upgrade:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static nghttp2_nv makeNv(std::string_view name, std::string_view value)
+    {
+        nghttp2_nv nv{};
+        // nghttp2 takes non const pointers, but with no copy flags set it
+        // only ever reads from them
+        nv.name = reinterpret_cast<uint8_t*>(const_cast<char*>(name.data()));
+        nv.namelen = name.size();
+        nv.value =
+            reinterpret_cast<uint8_t*>(const_cast<char*>(value.data()));
+        nv.valuelen = value.size();
+        nv.flags = NGHTTP2_NV_FLAG_NONE;
+        return nv;
+    }
+
+    static ssize_t onReadCallbackStatic(nghttp2_session* /* session */,
+                                        int32_t streamId, uint8_t* buf,
+                                        size_t length, uint32_t* dataFlags,
+                                        nghttp2_data_source* /* source */,
+                                        void* userData)
+    {
+        return userPtrToSelf(userData).onReadCallback(
+            streamId, std::span<uint8_t>(buf, length), *dataFlags);
+    }
+
+    ssize_t onReadCallback(int32_t streamId, std::span<uint8_t> out,
+                           uint32_t& dataFlags)
+    {
+        Http2StreamData* stream = findStream(streamId);
+        if (stream == nullptr)
+        {
+            return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+        }
+        const std::string& body = stream->res.body();
+        size_t toSend = std::min(body.size() - stream->sentSofar, out.size());
+        std::memcpy(out.data(), body.data() + stream->sentSofar, toSend);
+        stream->sentSofar += toSend;
+        if (stream->sentSofar >= body.size())
+        {
+            dataFlags |= NGHTTP2_DATA_FLAG_EOF;
+        }
+        return static_cast<ssize_t>(toSend);
+    }
+
+    void writeBuffer()
+    {
+        if (isWriting)
+        {
+            return;
+        }
+        std::span<const uint8_t> data = ngSession->memSend();
+        if (data.empty())
+        {
+            if (!ngSession->wantRead() && !ngSession->wantWrite())
+            {
+                BMCWEB_LOG_DEBUG << this << " HTTP/2 session finished";
+                close();
+            }
+            return;
+        }
+        // The buffer returned by nghttp2 stays valid until the next call to
+        // memSend, which can't happen while this write is outstanding
+        isWriting = true;
+        boost::asio::async_write(
+            adaptor, boost::asio::const_buffer(data.data(), data.size()),
+            [self(shared_from_this())](const boost::system::error_code& ec,
+                                       std::size_t bytesTransferred) {
+                self->afterWriteBuffer(ec, bytesTransferred);
+            });
+    }
+
+    void afterWriteBuffer(const boost::system::error_code& ec,
+                          std::size_t bytesTransferred)
+    {
+        isWriting = false;
+        BMCWEB_LOG_DEBUG << this << " HTTP/2 wrote " << bytesTransferred
+                         << " bytes";
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << this << " Error while writing: "
+                             << ec.message();
+            close();
+            return;
+        }
+        writeBuffer();
+    }
+
+    void doRead()
+    {
+        adaptor.async_read_some(
+            boost::asio::buffer(inBuffer),
+            [self(shared_from_this())](const boost::system::error_code& ec,
+                                       std::size_t bytesTransferred) {
+                self->afterDoRead(ec, bytesTransferred);
+            });
+    }
+
+    void afterDoRead(const boost::system::error_code& ec,
+                     std::size_t bytesTransferred)
+    {
+        BMCWEB_LOG_DEBUG << this << " HTTP/2 read " << bytesTransferred
+                         << " bytes";
+        if (ec)
+        {
+            BMCWEB_LOG_DEBUG << this << " Error while reading: "
+                             << ec.message();
+            close();
+            return;
+        }
+        startDeadline();
+
+        ssize_t readLen = ngSession->memRecv(
+            std::span<const uint8_t>(inBuffer.data(), bytesTransferred));
+        if (readLen < 0)
+        {
+            BMCWEB_LOG_ERROR << this << " nghttp2 failed to process input: "
+                             << nghttp2_strerror(static_cast<int>(readLen));
+            close();
+            return;
+        }
+        writeBuffer();
+        if (isAlive())
+        {
+            doRead();
+        }
+    }
+
+    bool isAlive()
+    {
+        return boost::beast::get_lowest_layer(adaptor).is_open();
+    }
+
+    void close()
+    {
+        cancelDeadlineTimer();
+        boost::beast::get_lowest_layer(adaptor).close();
+#ifdef BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
+        if (userSession != nullptr)
+        {
+            BMCWEB_LOG_DEBUG << this << " Removing TLS session: "
+                             << userSession->uniqueId;
+            persistent_data::SessionStore::getInstance().removeSession(
+                userSession);
+            userSession = nullptr;
+        }
+#endif // BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
+    }
+
+    void readClientIp()
+    {
+        boost::system::error_code ec;
+        boost::asio::ip::tcp::endpoint endpoint =
+            boost::beast::get_lowest_layer(adaptor).remote_endpoint(ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to get the client's IP Address. ec : "
+                             << ec;
+            return;
+        }
+        clientIp = endpoint.address();
+    }
+
+    void cancelDeadlineTimer()
+    {
+        if (timerCancelKey)
+        {
+            timerQueue.cancel(*timerCancelKey);
+            timerCancelKey.reset();
+        }
+    }
+
+    // Drops the connection once it has been idle for the keep-alive timeout.
+    // Streams with a handler still running keep the connection open.
+    void startDeadline()
+    {
+        cancelDeadlineTimer();
+        timerCancelKey = timerQueue.add(
+            keepAliveIdleTimeout, [self(shared_from_this())] {
+                self->timerCancelKey.reset();
+                if (!self->isAlive())
+                {
+                    return;
+                }
+                if (!self->streams.empty())
+                {
+                    self->startDeadline();
+                    return;
+                }
+                BMCWEB_LOG_DEBUG << self.get() << " HTTP/2 idle timeout";
+                self->close();
+            });
+    }
+
+    Adaptor adaptor;
+    std::optional<http2::Session> ngSession;
+
+    std::array<uint8_t, 8192> inBuffer{};
+    bool isWriting = false;
+
+    // Stream data is heap allocated so that the Response handed to a handler
+    // stays put while other streams come and go
+    std::map<int32_t, std::unique_ptr<Http2StreamData>> streams;
+
+    Handler* handler;
+    std::function<std::string()>& getCachedDateStr;
+    detail::TimerQueue& timerQueue;
+    std::optional<detail::TimerQueue::key_type> timerCancelKey;
+
+    boost::asio::ip::address clientIp;
+    // Session established by the transport (mutual TLS), if any
+    std::shared_ptr<persistent_data::UserSession> userSession;
+
+    using std::enable_shared_from_this<self_type>::shared_from_this;
+};
+} // namespace crow
@@ -21,8 +21,11 @@
 #include <security_headers.hpp>
 #include <ssl_key_handler.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <deque>
+#include <memory>
 #include <vector>
 
 namespace crow
@@ -47,13 +50,17 @@ constexpr uint64_t loggedOutPostBodyLimit = 4096;
 
 constexpr uint32_t httpHeaderLimit = 8192;
 
-// drop all connections after 3 minutes, this time limit was chosen
-// arbitrarily and can be adjusted later if needed
-static constexpr const size_t loggedInAttempts =
-    (180 / timerQueueTimeoutSeconds);
-
-static constexpr const size_t loggedOutAttempts =
-    (15 / timerQueueTimeoutSeconds);
+// Deadlines for each phase of a connection.  These limits were chosen
+// arbitrarily and can be adjusted later if needed.
+// Time allowed for the TLS handshake and the first request headers
+constexpr std::chrono::seconds headerTimeout(15);
+// Time allowed to read a body or write a response for an anonymous client
+constexpr std::chrono::seconds loggedOutBodyTimeout(15);
+// Logged in clients get longer, and the deadline is extended as long as an
+// upload keeps making progress
+constexpr std::chrono::seconds loggedInBodyTimeout(180);
+// Time a keep-alive connection may sit idle between requests
+constexpr std::chrono::seconds keepAliveIdleTimeout(120);
 
 template <typename Adaptor, typename Handler>
 class Connection :
@@ -67,9 +74,7 @@ class Connection :
         handler(handlerIn), getCachedDateStr(getCachedDateStrF),
         timerQueue(timerQueueIn)
     {
-        parser.emplace(std::piecewise_construct, std::make_tuple());
-        parser->body_limit(httpReqBodyLimit);
-        parser->header_limit(httpHeaderLimit);
+        resetParser();
 
 #ifdef BMCWEB_ENABLE_MUTUAL_TLS_AUTHENTICATION
         prepareMutualTls();
@@ -84,7 +89,10 @@ class Connection :
 
     ~Connection()
     {
-        res.setCompleteRequestHandler(nullptr);
+        for (std::unique_ptr<InFlightRequest>& request : inFlight)
+        {
+            request->res.setCompleteRequestHandler(nullptr);
+        }
         cancelDeadlineTimer();
 #ifdef BMCWEB_ENABLE_DEBUG
         connectionCount--;
@@ -104,15 +112,23 @@ class Connection :
                                .tls)
         {
             adaptor.set_verify_mode(boost::asio::ssl::verify_peer);
-            std::string id = "bmcweb";
-            int ret = SSL_set_session_id_context(
-                adaptor.native_handle(),
-                reinterpret_cast<const unsigned char*>(id.c_str()),
-                static_cast<unsigned int>(id.length()));
-            if (ret == 0)
+            // A resumed session skips certificate verification, and with it
+            // the callback below that creates the user session.  Give every
+            // mutual TLS connection its own session id context and no
+            // tickets so that it always performs a full handshake.
+            std::array<unsigned char, 16> id{};
+            int ret = RAND_bytes(id.data(), static_cast<int>(id.size()));
+            if (ret == 1)
+            {
+                ret = SSL_set_session_id_context(
+                    adaptor.native_handle(), id.data(),
+                    static_cast<unsigned int>(id.size()));
+            }
+            if (ret != 1)
             {
                 BMCWEB_LOG_ERROR << this << " failed to set SSL id";
             }
+            SSL_set_options(adaptor.native_handle(), SSL_OP_NO_TICKET);
         }
 
         adaptor.set_verify_callback([this](
@@ -263,10 +279,12 @@ class Connection :
             }
             sslUser.resize(lastChar);
             std::string unsupportedClientId = "";
+            boost::asio::ip::address ip;
+            getClientIp(ip);
             sessionIsFromTransport = true;
             userSession = persistent_data::SessionStore::getInstance()
                               .generateUserSession(
-                                  sslUser, req->ipAddress.to_string(),
+                                  sslUser, ip.to_string(),
                                   unsupportedClientId,
                                   persistent_data::PersistenceType::TIMEOUT);
             if (userSession != nullptr)
@@ -286,8 +304,7 @@ class Connection :
 
     void start()
     {
-
-        startDeadline(0);
+        startDeadline(headerTimeout);
 
         // TODO(ed) Abstract this to a more clever class with the idea of an
         // asynchronous "start"
@@ -306,6 +323,15 @@ class Connection :
                                                 << ec.message();
                                             return;
                                         }
+                                        ensuressl::recordHandshake(
+                                            adaptor.native_handle());
+#ifdef BMCWEB_ENABLE_HTTP2
+                                        if (alpnSelectedHttp2())
+                                        {
+                                            upgradeToHttp2();
+                                            return;
+                                        }
+#endif
                                         doReadHeaders();
                                     });
         }
@@ -315,20 +341,80 @@ class Connection :
         }
     }
 
-    void handle()
+#ifdef BMCWEB_ENABLE_HTTP2
+    bool alpnSelectedHttp2()
+    {
+        const unsigned char* alpn = nullptr;
+        unsigned int alpnLen = 0;
+        SSL_get0_alpn_selected(adaptor.native_handle(), &alpn, &alpnLen);
+        if (alpn == nullptr)
+        {
+            return false;
+        }
+        std::string_view selected(reinterpret_cast<const char*>(alpn),
+                                  alpnLen);
+        return selected == "h2";
+    }
+
+    // Hands the socket over to an HTTP/2 connection.  This object is released
+    // once the handshake callback returns.
+    void upgradeToHttp2()
     {
+        BMCWEB_LOG_DEBUG << this << " ALPN selected h2, upgrading";
         cancelDeadlineTimer();
+        std::shared_ptr<persistent_data::UserSession> transportSession;
+        if (sessionIsFromTransport)
+        {
+            transportSession = std::move(userSession);
+        }
+        auto http2 = std::make_shared<HTTP2Connection<Adaptor, Handler>>(
+            std::move(adaptor), handler, getCachedDateStr, timerQueue,
+            std::move(transportSession));
+        http2->start();
+    }
+#endif // BMCWEB_ENABLE_HTTP2
+
+    void handle()
+    {
+        if (!inFlight.empty() && !canPipeline(parser->get()))
+        {
+            // Anything that isn't a plain keep-alive GET runs on its own, once
+            // everything ahead of it has been answered
+            BMCWEB_LOG_DEBUG << this << " Waiting for " << inFlight.size()
+                             << " requests before handling";
+            handlePending = true;
+            return;
+        }
+        if (!isWriting)
+        {
+            cancelDeadlineTimer();
+        }
+
+        bool pipelinable = canPipeline(parser->get());
+        std::unique_ptr<InFlightRequest>& current =
+            inFlight.emplace_back(std::move(reading));
+        current->pipelinable = pipelinable;
+        crow::Response& res = current->res;
+
         std::error_code reqEc;
-        crow::Request& thisReq = req.emplace(parser->release(), reqEc);
+        crow::Request& thisReq = current->req.emplace(parser->release(), reqEc);
+        resetParser();
         if (reqEc)
         {
             BMCWEB_LOG_DEBUG << "Request failed to construct" << reqEc;
+            close();
             return;
         }
         thisReq.session = userSession;
+        // If the session was built from the transport, we don't need to
+        // clear it.  All other sessions are generated per request.
+        if (!sessionIsFromTransport)
+        {
+            userSession = nullptr;
+        }
 
         // Fetch the client IP address
-        readClientIp();
+        readClientIp(thisReq);
 
         // Check for HTTP version 1.1.
         if (thisReq.version() == 11)
@@ -336,7 +422,7 @@ class Connection :
             if (thisReq.getHeaderValue(boost::beast::http::field::host).empty())
             {
                 res.result(boost::beast::http::status::bad_request);
-                completeRequest();
+                completeRequest(*current);
                 return;
             }
         }
@@ -355,25 +441,29 @@ class Connection :
 
         if (res.completed)
         {
-            completeRequest();
+            completeRequest(*current);
             return;
         }
 
-        if (!crow::authorization::isOnWhitelist(req->url, req->method()) &&
+        if (!crow::authorization::isOnWhitelist(thisReq.url,
+                                                thisReq.method()) &&
             thisReq.session == nullptr)
         {
             BMCWEB_LOG_WARNING << "[AuthMiddleware] authorization failed";
             forward_unauthorized::sendUnauthorized(
-                req->url, req->getHeaderValue("User-Agent"),
-                req->getHeaderValue("Accept"), res);
-            completeRequest();
+                thisReq.url, thisReq.getHeaderValue("User-Agent"),
+                thisReq.getHeaderValue("Accept"), res);
+            completeRequest(*current);
             return;
         }
 
-        res.setCompleteRequestHandler([self(shared_from_this())] {
-            boost::asio::post(self->adaptor.get_executor(),
-                              [self] { self->completeRequest(); });
-        });
+        res.setCompleteRequestHandler(
+            [self(shared_from_this()), request{current.get()}] {
+                boost::asio::post(self->adaptor.get_executor(),
+                                  [self, request] {
+                                      self->completeRequest(*request);
+                                  });
+            });
 
         if (thisReq.isUpgrade() &&
             boost::iequals(
@@ -387,12 +477,11 @@ class Connection :
             return;
         }
 
-        std::string url(req->target());
-        if (boost::contains(url, "/Dump/Entries/") &&
-            boost::ends_with(url, "/attachment"))
+        if (isAttachmentStream(thisReq.target()) ||
+            isEnumerateStream(thisReq.target()))
         {
             BMCWEB_LOG_DEBUG << "upgrade stream connection";
-            handler->handleUpgrade(*req, res, std::move(adaptor));
+            handler->handleUpgrade(thisReq, res, std::move(adaptor));
             // delete lambda with self shared_ptr
             // to enable connection destruction
             res.completeRequestHandler = nullptr;
@@ -400,6 +489,8 @@ class Connection :
         }
         auto asyncResp = std::make_shared<bmcweb::AsyncResp>(res);
         handler->handle(thisReq, asyncResp);
+
+        readNextIfReady();
     }
 
     bool isAlive()
@@ -439,18 +530,156 @@ class Connection :
         }
     }
 
-    void completeRequest()
+    void readClientIp(crow::Request& thisReq)
+    {
+        boost::asio::ip::address ip;
+        boost::system::error_code ec = getClientIp(ip);
+        if (ec)
+        {
+            return;
+        }
+        thisReq.ipAddress = ip;
+    }
+
+    boost::system::error_code getClientIp(boost::asio::ip::address& ip)
+    {
+        boost::system::error_code ec;
+        BMCWEB_LOG_DEBUG << "Fetch the client IP address";
+        boost::asio::ip::tcp::endpoint endpoint =
+            boost::beast::get_lowest_layer(adaptor).remote_endpoint(ec);
+
+        if (ec)
+        {
+            // If remote endpoint fails keep going. "ClientOriginIPAddress"
+            // will be empty.
+            BMCWEB_LOG_ERROR << "Failed to get the client's IP Address. ec : "
+                             << ec;
+            return ec;
+        }
+        ip = endpoint.address();
+        return ec;
+    }
+
+  private:
+    // State for one request, from the moment its headers are read until its
+    // response has been written.  Heap allocated so the Response a handler
+    // holds on to stays put while other pipelined requests come and go.
+    struct InFlightRequest
+    {
+        std::optional<crow::Request> req;
+        crow::Response res;
+        // The response is finished and waiting its turn on the wire
+        bool ready = false;
+        // Further requests may be read while this one is being handled
+        bool pipelinable = false;
+    };
+
+    static bool isAttachmentStream(std::string_view target)
+    {
+        return boost::contains(target, "/Dump/Entries/") &&
+               boost::ends_with(target, "/attachment");
+    }
+
+    // The streaming enumerate of the D-Bus REST API
+    static bool isEnumerateStream(std::string_view target)
+    {
+#ifdef BMCWEB_ENABLE_DBUS_REST
+        return boost::starts_with(target, "/stream/");
+#else
+        return false;
+#endif
+    }
+
+    // Only idempotent requests that leave the connection open are pipelined.
+    // Everything else is handled with nothing else in flight, the same as a
+    // client that doesn't pipeline.
+    static bool canPipeline(
+        const boost::beast::http::request<boost::beast::http::string_body>&
+            msg)
+    {
+        if (msg.method() != boost::beast::http::verb::get &&
+            msg.method() != boost::beast::http::verb::head)
+        {
+            return false;
+        }
+        return msg.keep_alive() && !boost::beast::websocket::is_upgrade(msg) &&
+               !isAttachmentStream(msg.target()) &&
+               !isEnumerateStream(msg.target());
+    }
+
+    void resetParser()
+    {
+        parser.emplace(std::piecewise_construct, std::make_tuple());
+        parser->body_limit(httpReqBodyLimit);
+        parser->header_limit(httpHeaderLimit);
+    }
+
+    // Reuse the storage of the last written request, so that a client that
+    // doesn't pipeline never allocates per request
+    std::unique_ptr<InFlightRequest> takeRequestSlot()
+    {
+        if (spare)
+        {
+            return std::move(spare);
+        }
+        return std::make_unique<InFlightRequest>();
+    }
+
+    void recycleRequestSlot(std::unique_ptr<InFlightRequest> slot)
     {
-        if (!req)
+        // Destroy the Request via the std::optional
+        slot->req.reset();
+        slot->res.clear();
+        slot->ready = false;
+        slot->pipelinable = false;
+        spare = std::move(slot);
+    }
+
+    // Starts reading the next request, unless the requests already in flight
+    // don't allow it yet.  Called after each request is dispatched and after
+    // each response is written.
+    void readNextIfReady()
+    {
+        if (isReading || readClosed || !isAlive())
+        {
+            return;
+        }
+        if (handlePending)
+        {
+            if (inFlight.empty())
+            {
+                handlePending = false;
+                handle();
+            }
+            return;
+        }
+        if (!inFlight.empty() && (!inFlight.back()->pipelinable ||
+                                  inFlight.size() >= bmcwebHttpPipelineDepth))
         {
             return;
         }
-        BMCWEB_LOG_INFO << "Response: " << this << ' ' << req->url << ' '
-                        << res.resultInt() << " keepalive=" << req->keepAlive();
+        if (!isWriting)
+        {
+            startDeadline(keepAliveIdleTimeout);
+        }
+        doReadHeaders();
+    }
+
+    void completeRequest(InFlightRequest& current)
+    {
+        if (!current.req)
+        {
+            return;
+        }
+        crow::Request& thisReq = *current.req;
+        crow::Response& res = current.res;
+        BMCWEB_LOG_INFO << "Response: " << this << ' ' << thisReq.url << ' '
+                        << res.resultInt()
+                        << " keepalive=" << thisReq.keepAlive();
 
-        addSecurityHeaders(*req, res);
+        addSecurityHeaders(thisReq, res);
 
-        crow::authorization::cleanupTempSession(*req);
+        crow::authorization::cleanupTempSession(thisReq);
 
         if (!isAlive())
         {
@@ -466,7 +695,8 @@ class Connection :
         }
         if (res.body().empty() && !res.jsonValue.empty())
         {
-            if (http_helpers::requestPrefersHtml(req->getHeaderValue("Accept")))
+            if (http_helpers::requestPrefersHtml(
+                    thisReq.getHeaderValue("Accept")))
             {
                 prettyPrintJson(res);
             }
@@ -495,8 +725,11 @@ class Connection :
 
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
 
-        res.keepAlive(req->keepAlive());
+        res.keepAlive(thisReq.keepAlive());
 
+        // Responses go out in the order the requests came in, so this one
+        // may have to wait for slower requests ahead of it
+        current.ready = true;
         doWrite();
 
         // delete lambda with self shared_ptr
@@ -504,42 +737,28 @@ class Connection :
         res.setCompleteRequestHandler(nullptr);
     }
 
-    void readClientIp()
+    // Stops reading after a read error.  Responses to requests that were
+    // already read are still written; the connection closes after the last.
+    void handleReadError()
     {
-        boost::asio::ip::address ip;
-        boost::system::error_code ec = getClientIp(ip);
-        if (ec)
-        {
-            return;
-        }
-        req->ipAddress = ip;
-    }
-
-    boost::system::error_code getClientIp(boost::asio::ip::address& ip)
-    {
-        boost::system::error_code ec;
-        BMCWEB_LOG_DEBUG << "Fetch the client IP address";
-        boost::asio::ip::tcp::endpoint endpoint =
-            boost::beast::get_lowest_layer(adaptor).remote_endpoint(ec);
-
-        if (ec)
+        cancelDeadlineTimer();
+        readClosed = true;
+        handlePending = false;
+        if (inFlight.empty())
         {
-            // If remote endpoint fails keep going. "ClientOriginIPAddress"
-            // will be empty.
-            BMCWEB_LOG_ERROR << "Failed to get the client's IP Address. ec : "
-                             << ec;
-            return ec;
+            close();
         }
-        ip = endpoint.address();
-        return ec;
     }
 
-  private:
     void doReadHeaders()
     {
         BMCWEB_LOG_DEBUG << this << " doReadHeaders";
 
-        // Clean up any previous Connection.
+        if (!reading)
+        {
+            reading = takeRequestSlot();
+        }
+        isReading = true;
         boost::beast::http::async_read_header(
             adaptor, buffer, *parser,
             [this,
@@ -547,6 +766,7 @@ class Connection :
                                        std::size_t bytesTransferred) {
                 BMCWEB_LOG_WARNING << this << " async_read_header "
                                    << bytesTransferred << " Bytes";
+                isReading = false;
                 bool errorWhileReading = false;
                 if (ec)
                 {
@@ -565,17 +785,19 @@ class Connection :
                     }
                 }
 
-                cancelDeadlineTimer();
+                if (!isWriting)
+                {
+                    cancelDeadlineTimer();
+                }
 
                 if (errorWhileReading)
                 {
-                    close();
+                    handleReadError();
                     BMCWEB_LOG_DEBUG << this << " from read(1)";
                     return;
                 }
 
                 boost::beast::http::verb method = parser->get().method();
-                readClientIp();
 
                 boost::asio::ip::address ip;
                 if (getClientIp(ip))
@@ -584,11 +806,15 @@ class Connection :
                 }
                 sessionIsFromTransport = false;
                 userSession = crow::authorization::authenticate(
-                    ip, res, method, parser->get().base(), userSession);
+                    ip, reading->res, method, parser->get().base(),
+                    userSession);
                 bool loggedIn = userSession != nullptr;
                 if (loggedIn)
                 {
-                    startDeadline(loggedInAttempts);
+                    if (!isWriting)
+                    {
+                        startDeadline(loggedInBodyTimeout);
+                    }
                     BMCWEB_LOG_DEBUG << "Starting slow deadline";
                 }
                 else
@@ -604,7 +830,10 @@ class Connection :
                         return;
                     }
 
-                    startDeadline(loggedOutAttempts);
+                    if (!isWriting)
+                    {
+                        startDeadline(loggedOutBodyTimeout);
+                    }
                     BMCWEB_LOG_DEBUG << "Starting quick deadline";
                 }
                 doRead();
@@ -615,6 +844,7 @@ class Connection :
     {
         BMCWEB_LOG_DEBUG << this << " doRead";
 
+        isReading = true;
         boost::beast::http::async_read(
             adaptor, buffer, *parser,
             [this,
@@ -622,6 +852,7 @@ class Connection :
                                        std::size_t bytesTransferred) {
                 BMCWEB_LOG_DEBUG << this << " async_read " << bytesTransferred
                                  << " Bytes";
+                isReading = false;
 
                 bool errorWhileReading = false;
                 if (ec)
@@ -630,29 +861,13 @@ class Connection :
                         << this << " Error while reading: " << ec.message();
                     errorWhileReading = true;
                 }
-                else
+                else if (!isAlive())
                 {
-                    if (isAlive())
-                    {
-                        cancelDeadlineTimer();
-                        if (userSession != nullptr)
-                        {
-                            startDeadline(loggedInAttempts);
-                        }
-                        else
-                        {
-                            startDeadline(loggedOutAttempts);
-                        }
-                    }
-                    else
-                    {
-                        errorWhileReading = true;
-                    }
+                    errorWhileReading = true;
                 }
                 if (errorWhileReading)
                 {
-                    cancelDeadlineTimer();
-                    close();
+                    handleReadError();
                     BMCWEB_LOG_DEBUG << this << " from read(1)";
                     return;
                 }
@@ -660,20 +875,28 @@ class Connection :
             });
     }
 
+    // Writes the response at the head of the queue, if it's ready
     void doWrite()
     {
-        bool loggedIn = req && req->session;
+        if (isWriting || inFlight.empty() || !inFlight.front()->ready)
+        {
+            return;
+        }
+        InFlightRequest& current = *inFlight.front();
+        crow::Response& res = current.res;
+        bool loggedIn = current.req && current.req->session;
         if (loggedIn)
         {
-            startDeadline(loggedInAttempts);
+            startDeadline(loggedInBodyTimeout);
         }
         else
         {
-            startDeadline(loggedOutAttempts);
+            startDeadline(loggedOutBodyTimeout);
         }
         BMCWEB_LOG_DEBUG << this << " doWrite";
         res.preparePayload();
         serializer.emplace(*res.stringResponse);
+        isWriting = true;
         boost::beast::http::async_write(
             adaptor, *serializer,
             [this,
@@ -682,38 +905,34 @@ class Connection :
                 BMCWEB_LOG_DEBUG << this << " async_write " << bytesTransferred
                                  << " bytes";
 
+                isWriting = false;
                 cancelDeadlineTimer();
 
                 if (ec)
                 {
+                    close();
                     BMCWEB_LOG_DEBUG << this << " from write(2)";
                     return;
                 }
-                if (!res.keepAlive())
+                bool keepAlive = inFlight.front()->res.keepAlive();
+                serializer.reset();
+                BMCWEB_LOG_DEBUG << this << " Clearing response";
+                recycleRequestSlot(std::move(inFlight.front()));
+                inFlight.pop_front();
+
+                if (!keepAlive || (readClosed && inFlight.empty()))
                 {
                     close();
                     BMCWEB_LOG_DEBUG << this << " from write(1)";
                     return;
                 }
 
-                serializer.reset();
-                BMCWEB_LOG_DEBUG << this << " Clearing response";
-                res.clear();
-                parser.emplace(std::piecewise_construct, std::make_tuple());
-                parser->body_limit(httpReqBodyLimit); // reset body limit for
-                                                      // newly created parser
-                buffer.consume(buffer.size());
-
-                // If the session was built from the transport, we don't need to
-                // clear it.  All other sessions are generated per request.
-                if (!sessionIsFromTransport)
+                if (isReading)
                 {
-                    userSession = nullptr;
+                    startDeadline(keepAliveIdleTimeout);
                 }
-
-                // Destroy the Request via the std::optional
-                req.reset();
-                doReadHeaders();
+                doWrite();
+                readNextIfReady();
             });
     }
 
@@ -728,18 +947,13 @@ class Connection :
         }
     }
 
-    void startDeadline(size_t timerIterations)
+    void startDeadline(std::chrono::seconds timeout)
     {
         cancelDeadlineTimer();
 
-        if (timerIterations)
-        {
-            timerIterations--;
-        }
-
-        timerCancelKey =
-            timerQueue.add([self(shared_from_this()), timerIterations,
-                            readCount{parser->get().body().size()}] {
+        timerCancelKey = timerQueue.add(
+            timeout, [self(shared_from_this()), timeout,
+                      readCount{parser->get().body().size()}] {
                 // Mark timer as not active to avoid canceling it during
                 // Connection destructor which leads to double free issue
                 self->timerCancelKey.reset();
@@ -748,33 +962,30 @@ class Connection :
                     return;
                 }
 
-                bool loggedIn = self->req && self->req->session;
-                // allow slow uploads for logged in users
-                if (loggedIn && self->parser->get().body().size() > readCount)
+                // A client waiting on slow handlers isn't idle, even if it
+                // has nothing more to send
+                if (!self->isWriting && !self->inFlight.empty())
                 {
-                    BMCWEB_LOG_DEBUG << self.get()
-                                     << " restart timer - read in progress";
-                    self->startDeadline(timerIterations);
+                    self->startDeadline(timeout);
                     return;
                 }
 
-                // Threshold can be used to drop slow connections
-                // to protect against slow-rate DoS attack
-                if (timerIterations)
+                bool loggedIn = self->userSession != nullptr;
+                // allow slow uploads for logged in users
+                if (loggedIn && self->parser->get().body().size() > readCount)
                 {
-                    BMCWEB_LOG_DEBUG << self.get() << " restart timer";
-                    self->startDeadline(timerIterations);
+                    BMCWEB_LOG_DEBUG << self.get()
+                                     << " restart timer - read in progress";
+                    self->startDeadline(timeout);
                     return;
                 }
 
+                // Dropping connections that miss their deadline protects
+                // against slow-rate DoS attacks
+                BMCWEB_LOG_DEBUG << self.get() << " deadline expired";
                 self->close();
             });
 
-        if (!timerCancelKey)
-        {
-            close();
-            return;
-        }
         BMCWEB_LOG_DEBUG << this << " timer added: " << &timerQueue << ' '
                          << *timerCancelKey;
     }
@@ -794,13 +1005,24 @@ class Connection :
         boost::beast::http::string_body>>
         serializer;
 
-    std::optional<crow::Request> req;
-    crow::Response res;
+    // The request whose headers and body are currently being read
+    std::unique_ptr<InFlightRequest> reading;
+    // Requests that have been dispatched, oldest first.  Their responses are
+    // written in this order, as each reaches the front and is ready.
+    std::deque<std::unique_ptr<InFlightRequest>> inFlight;
+    std::unique_ptr<InFlightRequest> spare;
+
+    bool isReading = false;
+    bool isWriting = false;
+    // A complete request that has to wait for inFlight to drain
+    bool handlePending = false;
+    // The client has stopped sending; finish what's in flight and close
+    bool readClosed = false;
 
     bool sessionIsFromTransport = false;
     std::shared_ptr<persistent_data::UserSession> userSession;
 
-    std::optional<size_t> timerCancelKey;
+    std::optional<detail::TimerQueue::key_type> timerCancelKey;
 
     std::function<std::string()>& getCachedDateStr;
     detail::TimerQueue& timerQueue;
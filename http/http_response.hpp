@@ -18,10 +18,15 @@ namespace crow
 template <typename Adaptor, typename Handler>
 class Connection;
 
+template <typename Adaptor, typename Handler>
+class HTTP2Connection;
+
 struct Response
 {
     template <typename Adaptor, typename Handler>
     friend class crow::Connection;
+    template <typename Adaptor, typename Handler>
+    friend class crow::HTTP2Connection;
     using response_type =
         boost::beast::http::response<boost::beast::http::string_body>;
 
@@ -102,7 +107,15 @@ struct Response
     void clear()
     {
         BMCWEB_LOG_DEBUG << this << " Clearing response containers";
+        // Hang on to a modestly sized body buffer so that the next request on
+        // a keep-alive connection can render into it without reallocating
+        std::string oldBody = std::move(stringResponse->body());
         stringResponse.emplace(response_type{});
+        if (oldBody.capacity() <= retainedBodyCapacity)
+        {
+            oldBody.clear();
+            stringResponse->body() = std::move(oldBody);
+        }
         jsonValue.clear();
         completed = false;
     }
@@ -145,6 +158,8 @@ struct Response
     }
 
   private:
+    static constexpr size_t retainedBodyCapacity = 16 * 1024;
+
     bool completed{};
     std::function<void()> completeRequestHandler;
     std::function<bool()> isAliveHelper;
@@ -1,24 +1,35 @@
 #pragma once
 
 #include "http_connection.hpp"
+#ifdef BMCWEB_ENABLE_HTTP2
+#include "http2_connection.hpp"
+#endif
 #include "logging.hpp"
+#include "pool_allocator.hpp"
 #include "timer_queue.hpp"
+#include "websocket.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/beast/ssl/ssl_stream.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <ssl_key_handler.hpp>
+#include <startup_timing.hpp>
 
 #include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <filesystem>
 #include <future>
+#include <functional>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -74,9 +85,23 @@ class Server
         dateStr.resize(dateStrSz);
     }
 
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+    Server(Server&&) = delete;
+    Server& operator=(Server&&) = delete;
+
+    ~Server()
+    {
+#ifdef BMCWEB_ENABLE_SSL
+        if (certThread.joinable())
+        {
+            certThread.join();
+        }
+#endif
+    }
+
     void run()
     {
-        loadCertificate();
         updateDateStr();
 
         getCachedDateStr = [this]() -> std::string {
@@ -91,7 +116,7 @@ class Server
             return this->dateStr;
         };
 
-        timer.expires_after(std::chrono::seconds(1));
+        timer.expires_after(detail::TimerQueue::tick);
 
         timerHandler = [this](const boost::system::error_code& ec) {
             if (ec)
@@ -99,44 +124,137 @@ class Server
                 return;
             }
             timerQueue.process();
-            timer.expires_after(std::chrono::seconds(1));
+            timer.expires_after(detail::TimerQueue::tick);
             timer.async_wait(timerHandler);
         };
         timer.async_wait(timerHandler);
+#ifdef BMCWEB_ENABLE_SSL
+        scheduleTicketKeyRotation();
+#endif
+        scheduleStatsLog();
 
-        BMCWEB_LOG_INFO << "bmcweb server is running, local endpoint "
-                        << acceptor->local_endpoint();
         startAsyncWaitForSignal();
-        doAccept();
+        // The acceptor is already listening, connections wait in its backlog
+        // until the certificate is ready
+        loadCertificate([this]() {
+            BMCWEB_LOG_INFO << "bmcweb server is running, local endpoint "
+                            << acceptor->local_endpoint();
+            doAccept();
+            startup::Timings::getInstance().accepting();
+        });
     }
 
-    void loadCertificate()
+    /**
+     * @brief Checks the certificate, and makes a new one if it isn't valid,
+     * then calls onLoaded.
+     *
+     * Making a key can take seconds on a BMC, so the check runs on a thread
+     * of its own while the io_context carries on.  Only the check runs
+     * there; the SSL context is built back on the io_context.
+     */
+    void loadCertificate(std::function<void()>&& onLoaded)
     {
 #ifdef BMCWEB_ENABLE_SSL
-        namespace fs = std::filesystem;
-        // Cleanup older certificate file existing in the system
-        fs::path oldCert = "/home/root/server.pem";
-        if (fs::exists(oldCert))
+        if (certThread.joinable())
         {
-            fs::remove("/home/root/server.pem");
+            // Reload again once the running check is done, it may have read
+            // the files before they changed
+            BMCWEB_LOG_INFO << "Certificate is already being loaded, "
+                               "reloading after it";
+            reloadPending = true;
+            return;
         }
-        fs::path certPath = "/etc/ssl/certs/https/";
-        // if path does not exist create the path so that
-        // self signed certificate can be created in the
-        // path
-        if (!fs::exists(certPath))
+        std::string sslPemFile = ensuressl::serverCertFile();
+
+        int readyFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (readyFd < 0)
         {
-            fs::create_directories(certPath);
+            BMCWEB_LOG_ERROR << "eventfd failed, checking the certificate "
+                                "inline";
+            ensuressl::ensureOpensslKeyPresentAndValid(sslPemFile);
+            useCertificate(sslPemFile);
+            onLoaded();
+            return;
         }
-        fs::path certFile = certPath / "server.pem";
-        BMCWEB_LOG_INFO << "Building SSL Context file=" << certFile;
-        std::string sslPemFile(certFile);
-        ensuressl::ensureOpensslKeyPresentAndValid(sslPemFile);
+        certReady.assign(readyFd);
+        certThread = std::thread([sslPemFile, readyFd]() {
+            ensuressl::ensureOpensslKeyPresentAndValid(sslPemFile);
+            uint64_t done = 1;
+            if (write(readyFd, &done, sizeof(done)) != sizeof(done))
+            {
+                BMCWEB_LOG_ERROR << "Failed to signal the certificate is ready";
+            }
+        });
+        certReady.async_wait(
+            boost::asio::posix::stream_descriptor::wait_read,
+            [this, sslPemFile, onLoaded{std::move(onLoaded)}](
+                const boost::system::error_code ec) {
+                // The check is over once the thread is joined, whether or
+                // not the wait saw it finish
+                certThread.join();
+                certReady.close();
+                if (ec)
+                {
+                    BMCWEB_LOG_ERROR << "Waiting for the certificate failed: "
+                                     << ec.message();
+                }
+                useCertificate(sslPemFile);
+                onLoaded();
+                if (reloadPending)
+                {
+                    reloadPending = false;
+                    reloadCertificate();
+                }
+            });
+#else
+        onLoaded();
+#endif
+    }
+
+#ifdef BMCWEB_ENABLE_SSL
+    void useCertificate(const std::string& sslPemFile)
+    {
+        BMCWEB_LOG_INFO << "Building SSL Context file=" << sslPemFile;
         std::shared_ptr<boost::asio::ssl::context> sslContext =
             ensuressl::getSslContext(sslPemFile);
         adaptorCtx = sslContext;
         handler->ssl(std::move(sslContext));
+    }
 #endif
+
+#ifdef BMCWEB_ENABLE_SSL
+    void scheduleTicketKeyRotation()
+    {
+        timerQueue.add(ensuressl::ticketKeyRotationInterval, [this] {
+            ensuressl::TicketKeys::getInstance().rotate();
+            scheduleTicketKeyRotation();
+        });
+    }
+#endif
+
+    static constexpr std::chrono::hours statsLogInterval{1};
+
+    void scheduleStatsLog()
+    {
+        timerQueue.add(statsLogInterval, [this] {
+            logStats();
+            scheduleStatsLog();
+        });
+    }
+
+    void reloadCertificate()
+    {
+        loadCertificate([this]() {
+            // The pending accept completes with an error and starts another
+            // one with the new certificate
+            boost::system::error_code ec;
+            acceptor->cancel(ec);
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR << "Error while canceling async operations:"
+                                 << ec.message();
+            }
+        });
     }
 
     void startAsyncWaitForSignal()
@@ -152,15 +270,7 @@ class Server
                 if (signalNo == SIGHUP)
                 {
                     BMCWEB_LOG_INFO << "Receivied reload signal";
-                    loadCertificate();
-                    boost::system::error_code ec2;
-                    acceptor->cancel(ec2);
-                    if (ec2)
-                    {
-                        BMCWEB_LOG_ERROR
-                            << "Error while canceling async operations:"
-                            << ec2.message();
-                    }
+                    reloadCertificate();
                     this->startAsyncWaitForSignal();
                 }
                 else
@@ -173,18 +283,52 @@ class Server
 
     void stop()
     {
+        logStats();
         ioService->stop();
     }
 
+    // Logs the connection pool, TLS handshake and websocket compression
+    // counters
+    void logStats() const
+    {
+        const detail::BlockPool::Stats& pool = connectionPool->getStats();
+        BMCWEB_LOG_INFO << "Connection pool: " << pool.allocations
+                        << " allocations, " << pool.reused << " reused, "
+                        << pool.heapAllocations << " from the heap, "
+                        << pool.outstanding << " outstanding";
+#ifdef BMCWEB_ENABLE_SSL
+        const ensuressl::SslSessionStats& tls =
+            ensuressl::getSslSessionStats();
+        BMCWEB_LOG_INFO << "TLS handshakes: " << tls.resumedHandshakes
+                        << " resumed, " << tls.fullHandshakes << " full";
+#endif
+        for (const auto& [route, stats] : websocket::getCompressionStats())
+        {
+            BMCWEB_LOG_INFO << "Websocket " << route << ": "
+                            << stats->connections << " connections, "
+                            << stats->compressedConnections
+                            << " compressed, " << stats->messages
+                            << " messages, " << stats->payloadBytes
+                            << " bytes sent as " << stats->wireBytes
+                            << ", ratio " << stats->ratio();
+        }
+    }
+
     void doAccept()
     {
+        const detail::BlockPool::Stats& stats = connectionPool->getStats();
+        BMCWEB_LOG_DEBUG << "Connection pool: " << stats.allocations
+                         << " allocations, " << stats.reused << " reused, "
+                         << stats.outstanding << " outstanding";
         std::optional<Adaptor> adaptorTemp;
         if constexpr (std::is_same<Adaptor,
                                    boost::beast::ssl_stream<
                                        boost::asio::ip::tcp::socket>>::value)
         {
             adaptorTemp = Adaptor(*ioService, *adaptorCtx);
-            auto p = std::make_shared<Connection<Adaptor, Handler>>(
+            auto p = std::allocate_shared<Connection<Adaptor, Handler>>(
+                detail::PoolAllocator<Connection<Adaptor, Handler>>(
+                    connectionPool),
                 handler, getCachedDateStr, timerQueue,
                 std::move(adaptorTemp.value()));
 
@@ -202,7 +346,9 @@ class Server
         else
         {
             adaptorTemp = Adaptor(*ioService);
-            auto p = std::make_shared<Connection<Adaptor, Handler>>(
+            auto p = std::allocate_shared<Connection<Adaptor, Handler>>(
+                detail::PoolAllocator<Connection<Adaptor, Handler>>(
+                    connectionPool),
                 handler, getCachedDateStr, timerQueue,
                 std::move(adaptorTemp.value()));
 
@@ -220,11 +366,20 @@ class Server
 
   private:
     std::shared_ptr<boost::asio::io_context> ioService;
+    std::shared_ptr<detail::BlockPool> connectionPool =
+        std::make_shared<detail::BlockPool>();
     detail::TimerQueue timerQueue;
     std::function<std::string()> getCachedDateStr;
     std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
     boost::asio::signal_set signals;
     boost::asio::steady_timer timer;
+#ifdef BMCWEB_ENABLE_SSL
+    // Checks the certificate in the background, see loadCertificate()
+    std::thread certThread;
+    boost::asio::posix::stream_descriptor certReady{*ioService};
+    // A SIGHUP came in while the certificate was being checked
+    bool reloadPending{false};
+#endif
 
     std::string dateStr;
 
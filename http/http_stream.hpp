@@ -7,6 +7,13 @@
 #include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core/ostream.hpp>
 #include <boost/beast/http/basic_dynamic_body.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/write.hpp>
+
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <string_view>
 
 namespace crow
 {
@@ -14,6 +21,20 @@ namespace crow
 namespace streaming_response
 {
 
+// Frames data as one chunk of a body sent with chunked transfer encoding.
+// Empty data gives the last chunk, which ends the body.
+inline std::string makeChunk(std::string_view data)
+{
+    std::array<char, 20> size{};
+    int len = std::snprintf(size.data(), size.size(), "%zx\r\n", data.size());
+    std::string chunk(size.data(), static_cast<size_t>(len));
+    chunk.reserve(chunk.size() + data.size() + 4);
+    chunk += data;
+    // After the last chunk this ends the (empty) trailer section
+    chunk += "\r\n";
+    return chunk;
+}
+
 struct Connection : std::enable_shared_from_this<Connection>
 {
   public:
@@ -26,6 +47,14 @@ struct Connection : std::enable_shared_from_this<Connection>
     virtual void sendStreamHeaders(const std::string& streamDataSize,
                                    const std::string& contentType) = 0;
     virtual void sendStreamErrorStatus(boost::beast::http::status status) = 0;
+    // Sends the headers of a response whose body follows as chunks framed
+    // with makeChunk(), and calls handler once they have been written
+    virtual void sendChunkedHeaders(const std::string& contentType,
+                                    std::function<void()> handler) = 0;
+    // Sends a whole response and closes the connection
+    virtual void sendCompleteResponse(boost::beast::http::status status,
+                                      const std::string& contentType,
+                                      std::string_view body) = 0;
     virtual ~Connection() = default;
 
     boost::beast::http::request<boost::beast::http::string_body> req;
@@ -99,6 +128,56 @@ class ConnectionImpl : public Connection
                 }
             });
     }
+    void sendChunkedHeaders(const std::string& contentType,
+                            std::function<void()> handler) override
+    {
+        streamres.addHeader(boost::beast::http::field::content_type,
+                            contentType);
+        streamres.keepAlive(false);
+        streamres.bufferResponse->chunked(true);
+        // Only the header is written here; the chunks are appended to the
+        // body buffer by sendMessage()
+        headerSerializer.emplace(*streamres.bufferResponse);
+        boost::beast::http::async_write_header(
+            adaptor, *headerSerializer,
+            [this, self(shared_from_this()), handler{std::move(handler)}](
+                const boost::system::error_code& ec2, std::size_t) {
+                headerSerializer.reset();
+                if (ec2)
+                {
+                    BMCWEB_LOG_DEBUG << "Error while writing on socket" << ec2;
+                    close();
+                    return;
+                }
+                handler();
+            });
+    }
+
+    void sendCompleteResponse(boost::beast::http::status status,
+                              const std::string& contentType,
+                              std::string_view body) override
+    {
+        streamres.result(status);
+        streamres.addHeader(boost::beast::http::field::content_type,
+                            contentType);
+        streamres.keepAlive(false);
+        auto bytes = boost::asio::buffer_copy(
+            streamres.bufferResponse->body().prepare(body.size()),
+            boost::asio::buffer(body));
+        streamres.bufferResponse->body().commit(bytes);
+        streamres.preparePayload();
+        boost::beast::http::async_write(
+            adaptor, *streamres.bufferResponse,
+            [this, self(shared_from_this())](
+                const boost::system::error_code& ec2, std::size_t) {
+                if (ec2)
+                {
+                    BMCWEB_LOG_DEBUG << "Error while writing on socket" << ec2;
+                }
+                close();
+            });
+    }
+
     void sendMessage(const boost::asio::mutable_buffer& buffer,
                      std::function<void()> handler) override
     {
@@ -147,6 +226,9 @@ class ConnectionImpl : public Connection
     std::function<void(Connection&)> closeHandler;
     std::function<void(Connection&)> errorHandler;
     std::function<void()> handlerFunc;
+    std::optional<boost::beast::http::response_serializer<
+        crow::DynamicResponse::response_type::body_type>>
+        headerSerializer;
     crow::Request req;
 };
 } // namespace streaming_response
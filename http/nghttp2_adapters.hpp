@@ -0,0 +1,210 @@
+#pragma once
+
+extern "C"
+{
+#include <nghttp2/nghttp2.h>
+}
+
+#include "logging.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace crow
+{
+namespace http2
+{
+
+// RAII wrappers for the nghttp2 structures.  They stay as close to the C calls
+// as possible while making the lifetimes of the underlying objects safe.
+
+class SessionCallbacks
+{
+  public:
+    SessionCallbacks()
+    {
+        if (nghttp2_session_callbacks_new(&ptr) != 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to allocate nghttp2 callbacks";
+            ptr = nullptr;
+        }
+    }
+
+    ~SessionCallbacks()
+    {
+        nghttp2_session_callbacks_del(ptr);
+    }
+
+    SessionCallbacks(const SessionCallbacks&) = delete;
+    SessionCallbacks& operator=(const SessionCallbacks&) = delete;
+    SessionCallbacks(SessionCallbacks&&) = delete;
+    SessionCallbacks& operator=(SessionCallbacks&&) = delete;
+
+    void setOnFrameRecvCallback(nghttp2_on_frame_recv_callback callback)
+    {
+        nghttp2_session_callbacks_set_on_frame_recv_callback(ptr, callback);
+    }
+
+    void setOnStreamCloseCallback(nghttp2_on_stream_close_callback callback)
+    {
+        nghttp2_session_callbacks_set_on_stream_close_callback(ptr, callback);
+    }
+
+    void setOnHeaderCallback(nghttp2_on_header_callback callback)
+    {
+        nghttp2_session_callbacks_set_on_header_callback(ptr, callback);
+    }
+
+    void setOnBeginHeadersCallback(nghttp2_on_begin_headers_callback callback)
+    {
+        nghttp2_session_callbacks_set_on_begin_headers_callback(ptr, callback);
+    }
+
+    void setOnDataChunkRecvCallback(
+        nghttp2_on_data_chunk_recv_callback callback)
+    {
+        nghttp2_session_callbacks_set_on_data_chunk_recv_callback(ptr,
+                                                                  callback);
+    }
+
+    nghttp2_session_callbacks* get()
+    {
+        return ptr;
+    }
+
+  private:
+    nghttp2_session_callbacks* ptr = nullptr;
+};
+
+class SessionOption
+{
+  public:
+    SessionOption()
+    {
+        if (nghttp2_option_new(&ptr) != 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to allocate nghttp2 options";
+            ptr = nullptr;
+        }
+    }
+
+    ~SessionOption()
+    {
+        nghttp2_option_del(ptr);
+    }
+
+    SessionOption(const SessionOption&) = delete;
+    SessionOption& operator=(const SessionOption&) = delete;
+    SessionOption(SessionOption&&) = delete;
+    SessionOption& operator=(SessionOption&&) = delete;
+
+    void setMaxDeflateDynamicTableSize(size_t size)
+    {
+        nghttp2_option_set_max_deflate_dynamic_table_size(ptr, size);
+    }
+
+    void setMaxSendHeaderBlockLength(size_t length)
+    {
+        nghttp2_option_set_max_send_header_block_length(ptr, length);
+    }
+
+    nghttp2_option* get()
+    {
+        return ptr;
+    }
+
+  private:
+    nghttp2_option* ptr = nullptr;
+};
+
+class Session
+{
+  public:
+    Session(SessionCallbacks& callbacks, SessionOption& option,
+            void* userData)
+    {
+        if (nghttp2_session_server_new2(&ptr, callbacks.get(), userData,
+                                        option.get()) != 0)
+        {
+            BMCWEB_LOG_ERROR << "Failed to create nghttp2 session";
+            ptr = nullptr;
+        }
+    }
+
+    ~Session()
+    {
+        nghttp2_session_del(ptr);
+    }
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+    Session(Session&&) = delete;
+    Session& operator=(Session&&) = delete;
+
+    bool valid() const
+    {
+        return ptr != nullptr;
+    }
+
+    int submitSettings(std::span<const nghttp2_settings_entry> settings)
+    {
+        return nghttp2_submit_settings(ptr, NGHTTP2_FLAG_NONE,
+                                       settings.data(), settings.size());
+    }
+
+    int setLocalWindowSize(int32_t windowSize)
+    {
+        return nghttp2_session_set_local_window_size(ptr, NGHTTP2_FLAG_NONE,
+                                                     0, windowSize);
+    }
+
+    ssize_t memRecv(std::span<const uint8_t> buffer)
+    {
+        return nghttp2_session_mem_recv(ptr, buffer.data(), buffer.size());
+    }
+
+    std::span<const uint8_t> memSend()
+    {
+        const uint8_t* bytes = nullptr;
+        ssize_t size = nghttp2_session_mem_send(ptr, &bytes);
+        if (size <= 0)
+        {
+            return {};
+        }
+        return {bytes, static_cast<size_t>(size)};
+    }
+
+    int submitResponse(int32_t streamId, std::span<const nghttp2_nv> headers,
+                       const nghttp2_data_provider* dataProvider)
+    {
+        return nghttp2_submit_response(ptr, streamId, headers.data(),
+                                       headers.size(), dataProvider);
+    }
+
+    int submitRstStream(int32_t streamId, uint32_t errorCode)
+    {
+        return nghttp2_submit_rst_stream(ptr, NGHTTP2_FLAG_NONE, streamId,
+                                         errorCode);
+    }
+
+    int terminate(uint32_t errorCode)
+    {
+        return nghttp2_session_terminate_session(ptr, errorCode);
+    }
+
+    bool wantRead()
+    {
+        return nghttp2_session_want_read(ptr) != 0;
+    }
+
+    bool wantWrite()
+    {
+        return nghttp2_session_want_write(ptr) != 0;
+    }
+
+  private:
+    nghttp2_session* ptr = nullptr;
+};
+
+} // namespace http2
+} // namespace crow
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace detail
+{
+
+// Recycles fixed size blocks of memory.  Servers use this to keep the storage
+// for Connection objects (parser, 8k read buffer, response) around between
+// accepts instead of going back to the global heap for every socket.
+// The block size is fixed by the first allocation; anything of another size
+// is passed straight through to operator new.
+class BlockPool
+{
+  public:
+    struct Stats
+    {
+        size_t allocations = 0;
+        size_t reused = 0;
+        size_t heapAllocations = 0;
+        size_t outstanding = 0;
+    };
+
+    explicit BlockPool(size_t maxRetainedIn = 64) : maxRetained(maxRetainedIn)
+    {}
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+    BlockPool(BlockPool&&) = delete;
+    BlockPool& operator=(BlockPool&&) = delete;
+
+    ~BlockPool()
+    {
+        for (void* block : freeBlocks)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    void* allocate(size_t size)
+    {
+        stats.allocations++;
+        stats.outstanding++;
+        if (blockSize == 0)
+        {
+            blockSize = size;
+        }
+        if (size == blockSize && !freeBlocks.empty())
+        {
+            void* block = freeBlocks.back();
+            freeBlocks.pop_back();
+            stats.reused++;
+            return block;
+        }
+        stats.heapAllocations++;
+        return ::operator new(size);
+    }
+
+    void deallocate(void* block, size_t size)
+    {
+        stats.outstanding--;
+        if (size == blockSize && freeBlocks.size() < maxRetained)
+        {
+            freeBlocks.push_back(block);
+            return;
+        }
+        ::operator delete(block);
+    }
+
+    const Stats& getStats() const
+    {
+        return stats;
+    }
+
+    size_t retained() const
+    {
+        return freeBlocks.size();
+    }
+
+  private:
+    size_t maxRetained;
+    size_t blockSize = 0;
+    std::vector<void*> freeBlocks;
+    Stats stats;
+};
+
+// Minimal allocator over a BlockPool, suitable for std::allocate_shared so
+// that the object and its control block share one recycled block.  The
+// allocator keeps the pool alive, so objects may outlive whoever created it.
+template <typename T>
+class PoolAllocator
+{
+  public:
+    using value_type = T;
+
+    explicit PoolAllocator(std::shared_ptr<BlockPool> poolIn) noexcept :
+        pool(std::move(poolIn))
+    {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept :
+        pool(other.pool)
+    {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        pool->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept
+    {
+        return pool == other.pool;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept
+    {
+        return pool != other.pool;
+    }
+
+  private:
+    template <typename U>
+    friend class PoolAllocator;
+
+    std::shared_ptr<BlockPool> pool;
+};
+
+} // namespace detail
+} // namespace crow
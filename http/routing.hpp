@@ -321,8 +321,11 @@ class WebSocketRule : public BaseRule
     using self_t = WebSocketRule;
 
   public:
-    WebSocketRule(const std::string& ruleIn) : BaseRule(ruleIn)
-    {}
+    WebSocketRule(const std::string& ruleIn) :
+        BaseRule(ruleIn), stats(std::make_shared<websocket::CompressionStats>())
+    {
+        websocket::getCompressionStats()[ruleIn] = stats;
+    }
 
     void validate() override
     {}
@@ -342,7 +345,7 @@ class WebSocketRule : public BaseRule
             myConnection = std::make_shared<
                 crow::websocket::ConnectionImpl<boost::asio::ip::tcp::socket>>(
                 req, std::move(adaptor), openHandler, messageHandler,
-                closeHandler, errorHandler);
+                closeHandler, errorHandler, compressionOptions, stats);
         myConnection->start();
     }
 #ifdef BMCWEB_ENABLE_SSL
@@ -355,7 +358,7 @@ class WebSocketRule : public BaseRule
             myConnection = std::make_shared<crow::websocket::ConnectionImpl<
                 boost::beast::ssl_stream<boost::asio::ip::tcp::socket>>>(
                 req, std::move(adaptor), openHandler, messageHandler,
-                closeHandler, errorHandler);
+                closeHandler, errorHandler, compressionOptions, stats);
         myConnection->start();
     }
 #endif
@@ -388,6 +391,13 @@ class WebSocketRule : public BaseRule
         return *this;
     }
 
+    // permessage-deflate settings, websocket::noCompression turns it off
+    self_t& compression(const websocket::Compression& options)
+    {
+        compressionOptions = options;
+        return *this;
+    }
+
   protected:
     std::function<void(crow::websocket::Connection&,
                        std::shared_ptr<bmcweb::AsyncResp>)>
@@ -397,6 +407,8 @@ class WebSocketRule : public BaseRule
     std::function<void(crow::websocket::Connection&, const std::string&)>
         closeHandler;
     std::function<void(crow::websocket::Connection&)> errorHandler;
+    websocket::Compression compressionOptions;
+    std::shared_ptr<websocket::CompressionStats> stats;
 };
 
 class StreamingResponseRule : public BaseRule
@@ -2,97 +2,290 @@
 
 #include "logging.hpp"
 
-#include <boost/circular_buffer.hpp>
-#include <boost/circular_buffer/space_optimized.hpp>
-
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace crow
 {
 
-constexpr const size_t timerQueueTimeoutSeconds = 5;
 namespace detail
 {
 
-constexpr const size_t maxSize = 300;
-// fast timer queue for fixed tick value.
+// Hierarchical timing wheel.  Every pending timer lives in an intrusive list
+// hanging off one slot of one wheel level, so add() and cancel() are O(1)
+// regardless of how many timers are outstanding, and there is no cap on the
+// number of timers.  Timers that are further out than the lowest level can
+// represent are cascaded down into finer levels as time advances.
+// process() is expected to be called at least once per tick; all timers that
+// expired since the last call are collected first and run as one batch.
 class TimerQueue
 {
   public:
-    TimerQueue()
+    using clock = std::chrono::steady_clock;
+    using key_type = uint64_t;
+
+    // Resolution of the wheel.  Deadlines are rounded up to a whole tick.
+    static constexpr std::chrono::seconds tick{1};
+
+    TimerQueue() : startTime(clock::now())
     {
-        dq.set_capacity(maxSize);
+        for (std::array<uint32_t, slotsPerLevel>& level : wheel)
+        {
+            level.fill(npos);
+        }
     }
 
-    void cancel(size_t k)
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+    TimerQueue(TimerQueue&&) = delete;
+    TimerQueue& operator=(TimerQueue&&) = delete;
+    ~TimerQueue() = default;
+
+    // Cancels a pending timer.  Cancelling a timer that has already fired or
+    // been cancelled is a no-op.
+    void cancel(key_type k)
     {
-        size_t index = k - step;
-        if (index < dq.size())
+        uint32_t index = static_cast<uint32_t>(k);
+        uint32_t generation = static_cast<uint32_t>(k >> 32);
+        if (index >= nodes.size())
         {
-            dq[index].second = nullptr;
+            return;
         }
-        while (dq.begin() != dq.end() && dq.front().second == nullptr)
+        Node& node = nodes[index];
+        if (!node.active || node.generation != generation)
         {
-            dq.pop_front();
-            step++;
+            return;
         }
+        unlink(index);
+        release(index);
     }
 
-    std::optional<size_t> add(std::function<void()> f)
+    // Schedules f to be called once timeout has elapsed.  Returns a key that
+    // can be handed to cancel().
+    key_type add(clock::duration timeout, std::function<void()> f)
     {
-        if (dq.size() == maxSize)
+        uint64_t expiry = ticksAt(clock::now() + timeout, true);
+        if (expiry <= currentTick)
+        {
+            expiry = currentTick + 1;
+        }
+        if (expiry - currentTick >= maxTicks)
         {
-            BMCWEB_LOG_ERROR << "timer add: dq.size has hit maxSize";
-            return std::nullopt;
+            expiry = currentTick + maxTicks - 1;
         }
 
-        dq.push_back(
-            std::make_pair(std::chrono::steady_clock::now(), std::move(f)));
-        size_t ret = step + dq.size() - 1;
+        uint32_t index = 0;
+        if (freeList.empty())
+        {
+            index = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+        }
+        else
+        {
+            index = freeList.back();
+            freeList.pop_back();
+        }
+        Node& node = nodes[index];
+        node.expiry = expiry;
+        node.callback = std::move(f);
+        node.active = true;
+        place(index);
+        activeCount++;
 
-        BMCWEB_LOG_DEBUG << "timer add inside: " << this << ' ' << ret;
+        key_type ret = (static_cast<key_type>(node.generation) << 32) | index;
+        BMCWEB_LOG_DEBUG << "timer add inside: " << this << ' ' << ret
+                         << " expires at tick " << expiry;
         return ret;
     }
 
+    // Advances the wheel to the current time and runs every expired timer.
     void process()
     {
-        auto now = std::chrono::steady_clock::now();
-        while (!dq.empty())
+        process(clock::now());
+    }
+
+    void process(clock::time_point now)
+    {
+        uint64_t nowTick = ticksAt(now, false);
+        while (currentTick < nowTick)
+        {
+            currentTick++;
+            cascade();
+            collectExpired(wheel[0][currentTick & slotMask]);
+        }
+        if (expired.empty())
+        {
+            return;
+        }
+
+        // Callbacks are free to add or cancel timers, so run them from a
+        // local batch rather than from the wheel itself.
+        std::vector<std::function<void()>> batch;
+        batch.swap(expired);
+        BMCWEB_LOG_DEBUG << "timer call: " << this << ' ' << batch.size()
+                         << " expired at tick " << currentTick;
+        for (std::function<void()>& callback : batch)
+        {
+            callback();
+        }
+        batch.clear();
+        if (expired.empty())
+        {
+            // Hand the allocation back for the next batch
+            expired.swap(batch);
+        }
+    }
+
+    size_t size() const
+    {
+        return activeCount;
+    }
+
+  private:
+    static constexpr size_t slotBits = 6;
+    static constexpr size_t slotsPerLevel = 1U << slotBits;
+    static constexpr uint64_t slotMask = slotsPerLevel - 1;
+    static constexpr size_t levels = 4;
+    static constexpr uint64_t maxTicks = uint64_t{1} << (slotBits * levels);
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    struct Node
+    {
+        uint64_t expiry = 0;
+        uint32_t prev = npos;
+        uint32_t next = npos;
+        uint32_t* head = nullptr;
+        uint32_t generation = 0;
+        bool active = false;
+        std::function<void()> callback;
+    };
+
+    uint64_t ticksAt(clock::time_point time, bool roundUp) const
+    {
+        if (time <= startTime)
         {
-            auto& x = dq.front();
-            // Check expiration time only for active handlers,
-            // remove canceled ones immediately
-            if (x.second)
+            return 0;
+        }
+        clock::duration sinceStart = time - startTime;
+        clock::duration tickDuration = tick;
+        uint64_t ticks =
+            static_cast<uint64_t>(sinceStart.count() / tickDuration.count());
+        if (roundUp && sinceStart.count() % tickDuration.count() != 0)
+        {
+            ticks++;
+        }
+        return ticks;
+    }
+
+    void place(uint32_t index)
+    {
+        Node& node = nodes[index];
+        uint64_t delta =
+            node.expiry > currentTick ? node.expiry - currentTick : 0;
+        size_t level = 0;
+        while (level < levels - 1 &&
+               delta >= (uint64_t{1} << (slotBits * (level + 1))))
+        {
+            level++;
+        }
+        size_t slot = (node.expiry >> (slotBits * level)) & slotMask;
+        uint32_t& head = wheel[level][slot];
+
+        node.head = &head;
+        node.prev = npos;
+        node.next = head;
+        if (head != npos)
+        {
+            nodes[head].prev = index;
+        }
+        head = index;
+    }
+
+    void unlink(uint32_t index)
+    {
+        Node& node = nodes[index];
+        if (node.prev != npos)
+        {
+            nodes[node.prev].next = node.next;
+        }
+        else
+        {
+            *node.head = node.next;
+        }
+        if (node.next != npos)
+        {
+            nodes[node.next].prev = node.prev;
+        }
+        node.prev = npos;
+        node.next = npos;
+        node.head = nullptr;
+    }
+
+    void release(uint32_t index)
+    {
+        Node& node = nodes[index];
+        node.active = false;
+        node.callback = nullptr;
+        node.generation++;
+        freeList.push_back(index);
+        activeCount--;
+    }
+
+    // When a level wraps, redistribute the timers in the next slot of the
+    // coarser level into the finer ones.  Coarser levels go first so that
+    // everything they hand down is already in place for the finer cascades.
+    void cascade()
+    {
+        for (size_t level = levels - 1; level > 0; level--)
+        {
+            uint64_t lowBits = (uint64_t{1} << (slotBits * level)) - 1;
+            if ((currentTick & lowBits) != 0)
+            {
+                continue;
+            }
+            uint32_t& head =
+                wheel[level][(currentTick >> (slotBits * level)) & slotMask];
+            uint32_t index = head;
+            head = npos;
+            while (index != npos)
             {
-                if (now - x.first <
-                    std::chrono::seconds(timerQueueTimeoutSeconds))
-                {
-                    break;
-                }
-
-                BMCWEB_LOG_DEBUG << "timer call: " << this << ' ' << step;
-                // we know that timer handlers are very simple currently; call
-                // here
-                x.second();
+                uint32_t next = nodes[index].next;
+                place(index);
+                index = next;
             }
-            dq.pop_front();
-            step++;
         }
     }
 
-  private:
-    using storage_type =
-        std::pair<std::chrono::time_point<std::chrono::steady_clock>,
-                  std::function<void()>>;
+    void collectExpired(uint32_t& head)
+    {
+        uint32_t index = head;
+        head = npos;
+        while (index != npos)
+        {
+            Node& node = nodes[index];
+            uint32_t next = node.next;
+            node.prev = npos;
+            node.next = npos;
+            node.head = nullptr;
+            expired.emplace_back(std::move(node.callback));
+            release(index);
+            index = next;
+        }
+    }
 
-    boost::circular_buffer_space_optimized<storage_type,
-                                           std::allocator<storage_type>>
-        dq{};
+    clock::time_point startTime;
+    uint64_t currentTick = 0;
+    size_t activeCount = 0;
 
-    // boost::circular_buffer<storage_type> dq{20};
-    // std::deque<storage_type> dq{};
-    size_t step{};
+    std::array<std::array<uint32_t, slotsPerLevel>, levels> wheel{};
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeList;
+    std::vector<std::function<void()>> expired;
 };
 } // namespace detail
 } // namespace crow
@@ -0,0 +1,59 @@
+#include "pool_allocator.hpp"
+
+#include <array>
+#include <memory>
+
+#include "gmock/gmock.h"
+
+using crow::detail::BlockPool;
+using crow::detail::PoolAllocator;
+
+namespace
+{
+struct FakeConnection
+{
+    std::array<char, 8192> buffer{};
+};
+} // namespace
+
+TEST(PoolAllocator, RecyclesBlocks)
+{
+    std::shared_ptr<BlockPool> pool = std::make_shared<BlockPool>();
+    for (int i = 0; i < 100; i++)
+    {
+        std::shared_ptr<FakeConnection> conn =
+            std::allocate_shared<FakeConnection>(
+                PoolAllocator<FakeConnection>(pool));
+        EXPECT_EQ(pool->getStats().outstanding, 1);
+    }
+    const BlockPool::Stats& stats = pool->getStats();
+    EXPECT_EQ(stats.allocations, 100);
+    EXPECT_EQ(stats.heapAllocations, 1);
+    EXPECT_EQ(stats.reused, 99);
+    EXPECT_EQ(stats.outstanding, 0);
+    EXPECT_EQ(pool->retained(), 1);
+}
+
+TEST(PoolAllocator, RetainsBoundedNumberOfBlocks)
+{
+    std::shared_ptr<BlockPool> pool = std::make_shared<BlockPool>(4);
+    std::vector<std::shared_ptr<FakeConnection>> conns;
+    for (int i = 0; i < 10; i++)
+    {
+        conns.emplace_back(std::allocate_shared<FakeConnection>(
+            PoolAllocator<FakeConnection>(pool)));
+    }
+    EXPECT_EQ(pool->getStats().heapAllocations, 10);
+    conns.clear();
+    EXPECT_EQ(pool->retained(), 4);
+    EXPECT_EQ(pool->getStats().outstanding, 0);
+}
+
+TEST(PoolAllocator, ObjectsMayOutlivePoolOwner)
+{
+    std::shared_ptr<BlockPool> pool = std::make_shared<BlockPool>();
+    std::shared_ptr<FakeConnection> conn = std::allocate_shared<FakeConnection>(
+        PoolAllocator<FakeConnection>(pool));
+    pool.reset();
+    conn.reset();
+}
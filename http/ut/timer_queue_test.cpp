@@ -0,0 +1,99 @@
+#include "timer_queue.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+using crow::detail::TimerQueue;
+
+TEST(TimerQueue, FiresAfterDeadline)
+{
+    TimerQueue queue;
+    TimerQueue::clock::time_point start = TimerQueue::clock::now();
+    int fired = 0;
+    queue.add(std::chrono::seconds(15), [&fired] { fired++; });
+    EXPECT_EQ(queue.size(), 1);
+
+    queue.process(start + std::chrono::seconds(14));
+    EXPECT_EQ(fired, 0);
+
+    queue.process(start + std::chrono::seconds(17));
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(TimerQueue, CancelIsIdempotent)
+{
+    TimerQueue queue;
+    TimerQueue::clock::time_point start = TimerQueue::clock::now();
+    int fired = 0;
+    TimerQueue::key_type key =
+        queue.add(std::chrono::seconds(5), [&fired] { fired++; });
+    queue.cancel(key);
+    queue.cancel(key);
+    EXPECT_EQ(queue.size(), 0);
+
+    // A recycled slot must not be cancelled through the stale key
+    queue.add(std::chrono::seconds(5), [&fired] { fired += 10; });
+    queue.cancel(key);
+    queue.process(start + std::chrono::seconds(7));
+    EXPECT_EQ(fired, 10);
+}
+
+TEST(TimerQueue, CascadesLongTimeouts)
+{
+    TimerQueue queue;
+    TimerQueue::clock::time_point start = TimerQueue::clock::now();
+    std::vector<int> order;
+    std::vector<int> timeouts = {3, 70, 180, 4100, 300000, 90};
+    for (int timeout : timeouts)
+    {
+        queue.add(std::chrono::seconds(timeout),
+                  [&order, timeout] { order.push_back(timeout); });
+    }
+
+    for (int second = 0; second <= 300002; second++)
+    {
+        queue.process(start + std::chrono::seconds(second));
+        if (second == 100)
+        {
+            EXPECT_THAT(order, testing::ElementsAre(3, 70, 90));
+        }
+    }
+    EXPECT_THAT(order, testing::ElementsAre(3, 70, 90, 180, 4100, 300000));
+}
+
+TEST(TimerQueue, NoCapacityLimit)
+{
+    TimerQueue queue;
+    TimerQueue::clock::time_point start = TimerQueue::clock::now();
+    size_t fired = 0;
+    for (size_t i = 0; i < 10000; i++)
+    {
+        queue.add(std::chrono::seconds(1 + i % 200), [&fired] { fired++; });
+    }
+    EXPECT_EQ(queue.size(), 10000);
+    queue.process(start + std::chrono::seconds(202));
+    EXPECT_EQ(fired, 10000);
+}
+
+TEST(TimerQueue, CallbackMayRearm)
+{
+    TimerQueue queue;
+    TimerQueue::clock::time_point start = TimerQueue::clock::now();
+    int fired = 0;
+    std::function<void()> rearm = [&] {
+        fired++;
+        if (fired < 3)
+        {
+            queue.add(std::chrono::seconds(10), rearm);
+        }
+    };
+    queue.add(std::chrono::seconds(10), rearm);
+    for (int second = 0; second <= 40; second++)
+    {
+        queue.process(start + std::chrono::seconds(second));
+    }
+    EXPECT_EQ(fired, 3);
+}
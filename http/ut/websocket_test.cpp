@@ -0,0 +1,101 @@
+#include "websocket.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/read.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+
+using boost::asio::ip::tcp;
+using crow::websocket::CompressionStats;
+
+namespace
+{
+
+// Runs one connection over loopback, a Beast client that offers
+// permessage-deflate reads the message the server sends when it opens
+std::string sendToClient(const crow::websocket::Compression& compression,
+                         const std::shared_ptr<CompressionStats>& stats,
+                         const std::string& message)
+{
+    boost::asio::io_context ioc;
+    tcp::acceptor acceptor(ioc, {boost::asio::ip::address_v4::loopback(), 0});
+    tcp::socket serverSide(ioc);
+    boost::beast::websocket::stream<tcp::socket> client(ioc);
+    client.next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(serverSide);
+
+    boost::beast::websocket::permessage_deflate deflate;
+    deflate.client_enable = true;
+    client.set_option(deflate);
+
+    boost::beast::flat_buffer serverBuffer;
+    boost::beast::http::request<boost::beast::http::string_body> upgrade;
+    boost::beast::http::async_read(
+        serverSide, serverBuffer, upgrade,
+        [&](const boost::system::error_code& ec, size_t) {
+            ASSERT_FALSE(ec);
+            std::error_code reqEc;
+            crow::Request req(upgrade, reqEc);
+            req.session = std::make_shared<persistent_data::UserSession>();
+            std::make_shared<crow::websocket::ConnectionImpl<tcp::socket>>(
+                req, std::move(serverSide),
+                [&message](crow::websocket::Connection& conn,
+                           const std::shared_ptr<bmcweb::AsyncResp>&) {
+                    conn.sendText(message);
+                },
+                nullptr, nullptr, nullptr, compression, stats)
+                ->start();
+        });
+
+    boost::beast::flat_buffer clientBuffer;
+    std::string received;
+    client.async_handshake(
+        "localhost", "/console0", [&](const boost::system::error_code& ec) {
+            ASSERT_FALSE(ec);
+            client.async_read(clientBuffer, [&](const boost::system::error_code&
+                                                    readEc,
+                                                size_t size) {
+                ASSERT_FALSE(readEc);
+                received.assign(
+                    static_cast<const char*>(clientBuffer.data().data()),
+                    size);
+                client.next_layer().close();
+            });
+        });
+    ioc.run_for(std::chrono::seconds(5));
+    return received;
+}
+
+} // namespace
+
+TEST(WebSocket, CompressesWhenTheClientOffersDeflate)
+{
+    auto stats = std::make_shared<CompressionStats>();
+    std::string scrollback;
+    for (int i = 0; i < 200; i++)
+    {
+        scrollback += "[  OK  ] Started Phosphor Console Muxer\r\n";
+    }
+    EXPECT_EQ(sendToClient({}, stats, scrollback), scrollback);
+    EXPECT_EQ(stats->connections, 1U);
+    EXPECT_EQ(stats->compressedConnections, 1U);
+    EXPECT_EQ(stats->payloadBytes, scrollback.size());
+    EXPECT_LT(stats->wireBytes, scrollback.size() / 10);
+    EXPECT_GT(stats->ratio(), 10.0);
+}
+
+TEST(WebSocket, RoutesCanTurnDeflateOff)
+{
+    auto stats = std::make_shared<CompressionStats>();
+    std::string frame(1000, 'x');
+    EXPECT_EQ(sendToClient(crow::websocket::noCompression, stats, frame),
+              frame);
+    EXPECT_EQ(stats->compressedConnections, 0U);
+    // A 1000 byte frame from the server has a 4 byte header
+    EXPECT_EQ(stats->wireBytes, frame.size() + 4);
+}
@@ -7,7 +7,13 @@
 #include <boost/beast/websocket.hpp>
 
 #include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
 
 #ifdef BMCWEB_ENABLE_SSL
 #include <boost/beast/websocket/ssl.hpp>
@@ -18,6 +24,145 @@ namespace crow
 namespace websocket
 {
 
+// Time allowed to complete the websocket upgrade
+constexpr std::chrono::seconds handshakeTimeout(30);
+// An idle stream is pinged halfway through this period and dropped if the
+// peer has not answered by the end of it
+constexpr std::chrono::seconds pingTimeout(300);
+
+/**
+ * @brief permessage-deflate (RFC 7692) settings of a route.
+ *
+ * Deflate is offered to any client that asks for it.  Each connection that
+ * negotiates it holds a deflate and an inflate stream, about
+ * (1 << (windowBits + 2)) + (1 << (memLevel + 9)) bytes for deflate and
+ * (1 << windowBits) for inflate, so keep both low where many connections are
+ * expected.  Streams that are already compressed, like KVM video or virtual
+ * media, only pay for it and should turn it off.
+ */
+struct Compression
+{
+    bool enabled = true;
+    // Log2 of the LZ77 window, 9 to 15
+    int windowBits = 15;
+    // Memory for the compression state, 1 to 9
+    int memLevel = 4;
+    // zlib compression level, 0 to 9
+    int level = 6;
+};
+
+constexpr Compression noCompression{false};
+
+// Totals for every connection made to one route
+struct CompressionStats
+{
+    uint64_t connections = 0;
+    // Connections where the client accepted permessage-deflate
+    uint64_t compressedConnections = 0;
+    uint64_t messages = 0;
+    // Bytes handed to sendText() and sendBinary()
+    uint64_t payloadBytes = 0;
+    // Bytes written for those messages after framing and compression, before
+    // TLS
+    uint64_t wireBytes = 0;
+
+    double ratio() const
+    {
+        if (wireBytes == 0)
+        {
+            return 1.0;
+        }
+        return static_cast<double>(payloadBytes) /
+               static_cast<double>(wireBytes);
+    }
+};
+
+// Stats of each websocket route, by route
+inline std::map<std::string, std::shared_ptr<CompressionStats>>&
+    getCompressionStats()
+{
+    static std::map<std::string, std::shared_ptr<CompressionStats>> stats;
+    return stats;
+}
+
+/**
+ * @brief Passes reads and writes through to Stream, counting the bytes
+ * written.
+ *
+ * Sits between the websocket stream and the socket, which is the only place
+ * the size of a message after compression can be seen.
+ */
+template <typename Stream>
+class CountingStream
+{
+  public:
+    using next_layer_type = Stream;
+    using executor_type = typename Stream::executor_type;
+
+    explicit CountingStream(Stream&& streamIn) : stream(std::move(streamIn))
+    {}
+
+    executor_type get_executor() noexcept
+    {
+        return stream.get_executor();
+    }
+
+    next_layer_type& next_layer()
+    {
+        return stream;
+    }
+
+    const next_layer_type& next_layer() const
+    {
+        return stream;
+    }
+
+    template <typename MutableBuffers, typename Handler>
+    void async_read_some(const MutableBuffers& buffers, Handler&& handler)
+    {
+        stream.async_read_some(buffers, std::forward<Handler>(handler));
+    }
+
+    template <typename ConstBuffers, typename Handler>
+    void async_write_some(const ConstBuffers& buffers, Handler&& handler)
+    {
+        stream.async_write_some(
+            buffers, [this, handler{std::forward<Handler>(handler)}](
+                         const boost::system::error_code& ec,
+                         std::size_t bytesWritten) mutable {
+                written += bytesWritten;
+                handler(ec, bytesWritten);
+            });
+    }
+
+    // Bytes written since the last call
+    uint64_t takeWritten()
+    {
+        return std::exchange(written, 0);
+    }
+
+  private:
+    Stream stream;
+    uint64_t written = 0;
+};
+
+template <typename Stream>
+void teardown(boost::beast::role_type role, CountingStream<Stream>& stream,
+              boost::system::error_code& ec)
+{
+    using boost::beast::websocket::teardown;
+    teardown(role, stream.next_layer(), ec);
+}
+
+template <typename Stream, typename Handler>
+void async_teardown(boost::beast::role_type role,
+                    CountingStream<Stream>& stream, Handler&& handler)
+{
+    using boost::beast::websocket::async_teardown;
+    async_teardown(role, stream.next_layer(),
+                   std::forward<Handler>(handler));
+}
+
 struct Connection : std::enable_shared_from_this<Connection>
 {
   public:
@@ -70,20 +215,48 @@ class ConnectionImpl : public Connection
         std::function<void(Connection&, const std::string&, bool)>
             messageHandler,
         std::function<void(Connection&, const std::string&)> closeHandler,
-        std::function<void(Connection&)> errorHandler) :
+        std::function<void(Connection&)> errorHandler,
+        const Compression& compression = {},
+        std::shared_ptr<CompressionStats> statsIn = nullptr) :
         Connection(reqIn, reqIn.session->username),
-        ws(std::move(adaptorIn)), inString(), inBuffer(inString, 131088),
-        openHandler(std::move(openHandler)),
+        ws(CountingStream<Adaptor>(std::move(adaptorIn))), inString(),
+        inBuffer(inString, 131088), openHandler(std::move(openHandler)),
         messageHandler(std::move(messageHandler)),
         closeHandler(std::move(closeHandler)),
-        errorHandler(std::move(errorHandler)), session(reqIn.session)
+        errorHandler(std::move(errorHandler)), session(reqIn.session),
+        stats(std::move(statsIn))
     {
+        if (stats == nullptr)
+        {
+            stats = std::make_shared<CompressionStats>();
+        }
+        stats->connections++;
+        if (compression.enabled)
+        {
+            boost::beast::websocket::permessage_deflate deflate;
+            deflate.server_enable = true;
+            deflate.server_max_window_bits = compression.windowBits;
+            deflate.client_max_window_bits = compression.windowBits;
+            deflate.memLevel = compression.memLevel;
+            deflate.compLevel = compression.level;
+            ws.set_option(deflate);
+        }
+
         /* Turn on the timeouts on websocket stream to server role */
-        ws.set_option(boost::beast::websocket::stream_base::timeout::suggested(
-            boost::beast::role_type::server));
+        boost::beast::websocket::stream_base::timeout timeouts{};
+        timeouts.handshake_timeout = handshakeTimeout;
+        timeouts.idle_timeout = pingTimeout;
+        timeouts.keep_alive_pings = true;
+        ws.set_option(timeouts);
         BMCWEB_LOG_DEBUG << "Creating new connection " << this;
     }
 
+    ~ConnectionImpl() override
+    {
+        BMCWEB_LOG_DEBUG << "Websocket " << this << " sent " << payloadBytes
+                         << " bytes as " << wireBytes << " on the wire";
+    }
+
     boost::asio::io_context& getIoContext() override
     {
         return static_cast<boost::asio::io_context&>(
@@ -99,8 +272,13 @@ class ConnectionImpl : public Connection
         std::string_view protocol = req[bf::sec_websocket_protocol];
 
         ws.set_option(boost::beast::websocket::stream_base::decorator(
-            [session{session}, protocol{std::string(protocol)}](
+            [session{session}, protocol{std::string(protocol)},
+             deflateAccepted{&deflateAccepted}](
                 boost::beast::websocket::response_type& m) {
+                // Beast has already added the extensions it agreed to
+                *deflateAccepted =
+                    m[bf::sec_websocket_extensions].find(
+                        "permessage-deflate") != std::string_view::npos;
 
 #ifndef BMCWEB_INSECURE_DISABLE_CSRF_PREVENTION
                 if (session != nullptr)
@@ -140,6 +318,12 @@ class ConnectionImpl : public Connection
                 BMCWEB_LOG_ERROR << "Error in ws.async_accept " << ec;
                 return;
             }
+            if (deflateAccepted)
+            {
+                stats->compressedConnections++;
+            }
+            // Leave the upgrade response out of the counts
+            ws.next_layer().takeWritten();
             acceptDone();
         });
     }
@@ -249,9 +433,11 @@ class ConnectionImpl : public Connection
         doingWrite = true;
         ws.async_write(boost::asio::buffer(outBuffer.front()),
                        [this, self(shared_from_this())](
-                           boost::beast::error_code ec, std::size_t) {
+                           boost::beast::error_code ec,
+                           std::size_t bytesWritten) {
                            doingWrite = false;
                            outBuffer.erase(outBuffer.begin());
+                           countWrite(bytesWritten);
                            if (ec == boost::beast::websocket::error::closed)
                            {
                                // Do nothing here.  doRead handler will call the
@@ -270,7 +456,19 @@ class ConnectionImpl : public Connection
     }
 
   private:
-    boost::beast::websocket::stream<Adaptor, false> ws;
+    // Pings and close frames written since the last message are counted with
+    // this one
+    void countWrite(std::size_t bytesWritten)
+    {
+        uint64_t wire = ws.next_layer().takeWritten();
+        payloadBytes += bytesWritten;
+        wireBytes += wire;
+        stats->messages++;
+        stats->payloadBytes += bytesWritten;
+        stats->wireBytes += wire;
+    }
+
+    boost::beast::websocket::stream<CountingStream<Adaptor>, true> ws;
 
     std::string inString;
     boost::asio::dynamic_string_buffer<std::string::value_type,
@@ -279,6 +477,8 @@ class ConnectionImpl : public Connection
         inBuffer;
     std::vector<std::string> outBuffer;
     bool doingWrite = false;
+    // Set by the upgrade response when permessage-deflate was negotiated
+    bool deflateAccepted = false;
 
     std::function<void(Connection&, std::shared_ptr<bmcweb::AsyncResp>)>
         openHandler;
@@ -286,6 +486,9 @@ class ConnectionImpl : public Connection
     std::function<void(Connection&, const std::string&)> closeHandler;
     std::function<void(Connection&)> errorHandler;
     std::shared_ptr<persistent_data::UserSession> session;
+    std::shared_ptr<CompressionStats> stats;
+    uint64_t payloadBytes = 0;
+    uint64_t wireBytes = 0;
 };
 } // namespace websocket
 } // namespace crow
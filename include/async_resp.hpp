@@ -1,8 +1,10 @@
 #pragma once
 
 #include "http_response.hpp"
+#include "request_arena.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace bmcweb
 {
@@ -35,8 +37,22 @@ class AsyncResp
         res.end();
     }
 
+    // Memory for the coroutine frames of the handlers of this request, made
+    // on first use
+    const std::shared_ptr<crow::RequestArena>& arena()
+    {
+        if (frameArena == nullptr)
+        {
+            frameArena = std::make_shared<crow::RequestArena>();
+        }
+        return frameArena;
+    }
+
     crow::Response& res;
     std::function<void()> func;
+
+  private:
+    std::shared_ptr<crow::RequestArena> frameArena;
 };
 
 } // namespace bmcweb
@@ -0,0 +1,631 @@
+#pragma once
+
+#include "async_resp.hpp"
+#include "logging.hpp"
+#include "request_arena.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace crow
+{
+namespace coro
+{
+
+/*
+ * Coroutines for route handlers, as an alternative to chains of callbacks.
+ *
+ *   inline coro::Task<>
+ *       getThing(std::shared_ptr<bmcweb::AsyncResp> asyncResp)
+ *   {
+ *       auto [a, b] = co_await coro::whenAll(getA(asyncResp),
+ *                                            getB(asyncResp));
+ *       ...
+ *   }
+ *
+ *   coro::spawn(getThing(asyncResp));
+ *
+ * A Task starts when it is awaited or spawned, and resumes whoever awaited it
+ * when it finishes.  A coroutine whose first parameter is the AsyncResp of
+ * the request, followed by at most five others, gets its frame from the arena
+ * of the request.  Parameters are kept in the frame as they are declared, so
+ * take the AsyncResp, and anything else that has to outlive the first
+ * co_await, by value.
+ */
+
+template <typename T = void>
+class Task;
+
+template <typename... T>
+class WhenAll;
+
+namespace detail
+{
+
+// Shared by the tasks of one whenAll(), the last one to finish resumes
+// whoever awaited them
+struct Join
+{
+    std::coroutine_handle<> parent;
+    size_t remaining = 0;
+};
+
+// Stands for any parameter of a coroutine after its AsyncResp, so that the
+// operator new below needn't be templates.  GCC reports an operator new
+// template and the usual operator delete as mismatched.
+struct AnyParam
+{
+    template <typename T>
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    AnyParam(const T& /*param*/)
+    {}
+};
+
+class PromiseBase
+{
+  public:
+    // Coroutines with more parameters than these take frames from the heap
+    static void* operator new(size_t size,
+                              const std::shared_ptr<bmcweb::AsyncResp>& resp)
+    {
+        return allocateFrameFor(size, resp);
+    }
+
+    static void* operator new(size_t size,
+                              const std::shared_ptr<bmcweb::AsyncResp>& resp,
+                              AnyParam)
+    {
+        return allocateFrameFor(size, resp);
+    }
+
+    static void* operator new(size_t size,
+                              const std::shared_ptr<bmcweb::AsyncResp>& resp,
+                              AnyParam, AnyParam)
+    {
+        return allocateFrameFor(size, resp);
+    }
+
+    static void* operator new(size_t size,
+                              const std::shared_ptr<bmcweb::AsyncResp>& resp,
+                              AnyParam, AnyParam, AnyParam)
+    {
+        return allocateFrameFor(size, resp);
+    }
+
+    static void* operator new(size_t size,
+                              const std::shared_ptr<bmcweb::AsyncResp>& resp,
+                              AnyParam, AnyParam, AnyParam, AnyParam)
+    {
+        return allocateFrameFor(size, resp);
+    }
+
+    static void* operator new(size_t size,
+                              const std::shared_ptr<bmcweb::AsyncResp>& resp,
+                              AnyParam, AnyParam, AnyParam, AnyParam, AnyParam)
+    {
+        return allocateFrameFor(size, resp);
+    }
+
+    static void* operator new(size_t size)
+    {
+        return allocateFrame(size, nullptr);
+    }
+
+    static void operator delete(void* frame, size_t size)
+    {
+        std::byte* block = static_cast<std::byte*>(frame) - headerSize;
+        FrameHeader* header =
+            std::launder(reinterpret_cast<FrameHeader*>(block));
+        // The arena may only be held by this frame by now
+        std::shared_ptr<RequestArena> arena = std::move(header->arena);
+        header->~FrameHeader();
+        if (arena == nullptr)
+        {
+            ::operator delete(block);
+            return;
+        }
+        arena->deallocate(block, size + headerSize);
+    }
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    struct FinalAwaiter
+    {
+        bool await_ready() noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            PromiseBase& promise = handle.promise();
+            if (promise.detached)
+            {
+                if (promise.exception)
+                {
+                    BMCWEB_LOG_ERROR << "Spawned coroutine threw";
+                }
+                handle.destroy();
+                return std::noop_coroutine();
+            }
+            if (promise.join != nullptr)
+            {
+                promise.join->remaining--;
+                if (promise.join->remaining == 0)
+                {
+                    return promise.join->parent;
+                }
+                return std::noop_coroutine();
+            }
+            if (promise.continuation)
+            {
+                return promise.continuation;
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+        exception = std::current_exception();
+    }
+
+    void rethrowIfFailed() const
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    std::coroutine_handle<> continuation;
+    Join* join = nullptr;
+    bool detached = false;
+
+  private:
+    struct FrameHeader
+    {
+        std::shared_ptr<RequestArena> arena;
+    };
+
+    static constexpr size_t headerSize =
+        (sizeof(FrameHeader) + RequestArena::alignment - 1) &
+        ~(RequestArena::alignment - 1);
+
+    static void*
+        allocateFrameFor(size_t size,
+                         const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+    {
+        if (asyncResp == nullptr)
+        {
+            return allocateFrame(size, nullptr);
+        }
+        return allocateFrame(size, asyncResp->arena());
+    }
+
+    // Not inlined, so that GCC doesn't pair the ::operator new in here with
+    // the operator delete of the promise and report them as mismatched
+    [[gnu::noinline]] static void*
+        allocateFrame(size_t size, std::shared_ptr<RequestArena> arena)
+    {
+        void* block = arena == nullptr ? ::operator new(size + headerSize)
+                                       : arena->allocate(size + headerSize);
+        new (block) FrameHeader{std::move(arena)};
+        return static_cast<std::byte*>(block) + headerSize;
+    }
+
+    std::exception_ptr exception;
+};
+
+template <typename T>
+class Promise : public PromiseBase
+{
+  public:
+    Task<T> get_return_object();
+
+    template <typename U>
+    void return_value(U&& valueIn)
+    {
+        value.emplace(std::forward<U>(valueIn));
+    }
+
+    T takeResult()
+    {
+        rethrowIfFailed();
+        return std::move(*value);
+    }
+
+  private:
+    std::optional<T> value;
+};
+
+template <>
+class Promise<void> : public PromiseBase
+{
+  public:
+    Task<void> get_return_object();
+
+    void return_void()
+    {}
+
+    void takeResult()
+    {
+        rethrowIfFailed();
+    }
+};
+
+} // namespace detail
+
+template <typename T>
+class [[nodiscard]] Task
+{
+  public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handleIn) : handle(handleIn)
+    {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr))
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+            {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume()
+    {
+        return handle.promise().takeResult();
+    }
+
+  private:
+    template <typename... U>
+    friend class WhenAll;
+    friend void spawn(Task<void>&& task);
+
+    Handle handle;
+};
+
+template <typename T>
+Task<T> detail::Promise<T>::get_return_object()
+{
+    return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+inline Task<void> detail::Promise<void>::get_return_object()
+{
+    return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+/**
+ * @brief Starts task without anyone to wait for it.
+ *
+ * The task frees itself when it finishes.  Its first co_await returns control
+ * to the caller, usually a route handler, which returns as it always has;
+ * the task keeps the request open through the AsyncResp it holds.
+ */
+inline void spawn(Task<void>&& task)
+{
+    Task<void>::Handle handle = std::exchange(task.handle, nullptr);
+    handle.promise().detached = true;
+    handle.resume();
+}
+
+// What whenAll() gives back for a Task<T>
+template <typename T>
+using TaskResult = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+/**
+ * @brief Awaits several tasks at once.
+ *
+ * All of the tasks are started before any of them is waited on, so the
+ * D-Bus calls they make are in flight together.  The result holds what each
+ * task returned, in order, with std::monostate for a Task<void>.  If a task
+ * threw, the first such exception is rethrown once all have finished.
+ */
+template <typename... T>
+class [[nodiscard]] WhenAll
+{
+  public:
+    explicit WhenAll(Task<T>&&... tasksIn) : tasks(std::move(tasksIn)...)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return sizeof...(T) == 0;
+    }
+
+    bool await_suspend(std::coroutine_handle<> awaiting)
+    {
+        join.parent = awaiting;
+        // Counts this call too, so a task that finishes before the rest are
+        // started can't resume the caller early
+        join.remaining = sizeof...(T) + 1;
+        std::apply(
+            [this](Task<T>&... task) {
+                ((task.handle.promise().join = &join, task.handle.resume()),
+                 ...);
+            },
+            tasks);
+        join.remaining--;
+        return join.remaining != 0;
+    }
+
+    std::tuple<TaskResult<T>...> await_resume()
+    {
+        return std::apply(
+            [](Task<T>&... task) {
+                return std::tuple<TaskResult<T>...>{takeResult(task)...};
+            },
+            tasks);
+    }
+
+  private:
+    template <typename U>
+    static TaskResult<U> takeResult(Task<U>& task)
+    {
+        if constexpr (std::is_void_v<U>)
+        {
+            task.handle.promise().takeResult();
+            return {};
+        }
+        else
+        {
+            return task.handle.promise().takeResult();
+        }
+    }
+
+    std::tuple<Task<T>...> tasks;
+    detail::Join join;
+};
+
+template <typename... T>
+WhenAll<T...> whenAll(Task<T>&&... tasks)
+{
+    return WhenAll<T...>(std::move(tasks)...);
+}
+
+// co_await sleepFor(ioc, duration) waits for duration, and returns the
+// error_code of the wait
+class [[nodiscard]] SleepFor
+{
+  public:
+    SleepFor(boost::asio::io_context& ioc,
+             std::chrono::steady_clock::duration duration) :
+        timer(ioc, duration)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting)
+    {
+        timer.async_wait(
+            [this, awaiting](const boost::system::error_code& ecIn) {
+                ec = ecIn;
+                awaiting.resume();
+            });
+    }
+
+    boost::system::error_code await_resume() const
+    {
+        return ec;
+    }
+
+  private:
+    boost::asio::steady_timer timer;
+    boost::system::error_code ec;
+};
+
+inline SleepFor sleepFor(boost::asio::io_context& ioc,
+                         std::chrono::steady_clock::duration duration)
+{
+    return {ioc, duration};
+}
+
+/**
+ * @brief Awaits an asio style asynchronous operation, like a socket read.
+ *
+ * initiate is called with the completion handler to start the operation,
+ * which must complete with (error_code, Values...).  co_await gives back a
+ * tuple of the same.
+ *
+ *   auto [ec, size] = co_await coro::asyncOp<size_t>([&](auto&& handler) {
+ *       socket.async_read_some(buffer, std::move(handler));
+ *   });
+ */
+template <typename Initiate, typename... Values>
+class [[nodiscard]] AsyncOp
+{
+  public:
+    explicit AsyncOp(Initiate&& initiateIn) : initiate(std::move(initiateIn))
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting)
+    {
+        initiate([this, awaiting](const boost::system::error_code& ec,
+                                  Values... values) {
+            result.emplace(ec, std::move(values)...);
+            awaiting.resume();
+        });
+    }
+
+    std::tuple<boost::system::error_code, Values...> await_resume()
+    {
+        return std::move(*result);
+    }
+
+  private:
+    Initiate initiate;
+    std::optional<std::tuple<boost::system::error_code, Values...>> result;
+};
+
+template <typename... Values, typename Initiate>
+AsyncOp<std::decay_t<Initiate>, Values...> asyncOp(Initiate&& initiate)
+{
+    return AsyncOp<std::decay_t<Initiate>, Values...>(
+        std::forward<Initiate>(initiate));
+}
+
+/**
+ * @brief Awaits a function that reports back through a callback, like one
+ * stage of a callback chain.
+ *
+ * initiate is called with the callback, which can be copied and is to be
+ * called with Values...  co_await gives back a tuple of the values, or
+ * std::nullopt if every copy of the callback was destroyed without being
+ * called, which is how a stage gives up once it has reported an error.
+ *
+ *   auto items = co_await coro::callbackOp<ItemsPtr>([&](auto&& done) {
+ *       getItems(asyncResp, std::move(done));
+ *   });
+ *   if (!items)
+ *   {
+ *       co_return;
+ *   }
+ */
+template <typename Initiate, typename... Values>
+class [[nodiscard]] CallbackOp
+{
+  public:
+    using Result = std::optional<std::tuple<Values...>>;
+
+    explicit CallbackOp(Initiate&& initiateIn) : initiate(std::move(initiateIn))
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting)
+    {
+        // The awaiter may be gone once initiate() returns, if the callback
+        // was called or dropped within it
+        initiate(Callback{std::make_shared<State>(awaiting, result)});
+    }
+
+    Result await_resume()
+    {
+        return std::move(result);
+    }
+
+  private:
+    // Shared by the copies of the callback, resumes the awaiting coroutine
+    // once the callback is called or the last copy is gone
+    struct State
+    {
+        State(std::coroutine_handle<> awaitingIn, Result& resultIn) :
+            awaiting(awaitingIn), result(resultIn)
+        {}
+
+        State(const State&) = delete;
+        State& operator=(const State&) = delete;
+
+        ~State()
+        {
+            if (awaiting)
+            {
+                awaiting.resume();
+            }
+        }
+
+        std::coroutine_handle<> awaiting;
+        Result& result;
+    };
+
+    struct Callback
+    {
+        template <typename... Args>
+        void operator()(Args&&... values) const
+        {
+            std::coroutine_handle<> awaiting =
+                std::exchange(state->awaiting, nullptr);
+            if (!awaiting)
+            {
+                return;
+            }
+            state->result.emplace(std::forward<Args>(values)...);
+            awaiting.resume();
+        }
+
+        std::shared_ptr<State> state;
+    };
+
+    Initiate initiate;
+    Result result;
+};
+
+template <typename... Values, typename Initiate>
+CallbackOp<std::decay_t<Initiate>, Values...> callbackOp(Initiate&& initiate)
+{
+    return CallbackOp<std::decay_t<Initiate>, Values...>(
+        std::forward<Initiate>(initiate));
+}
+
+} // namespace coro
+} // namespace crow
@@ -0,0 +1,342 @@
+#pragma once
+#include <tinyxml2.h>
+
+#include <boost/container/flat_map.hpp>
+#include <dbus_singleton.hpp>
+#include <dbus_utility.hpp>
+#include <logging.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace dbus_introspection
+{
+
+// Parsed form of the XML returned by org.freedesktop.DBus.Introspectable.
+// Attributes missing from the XML are left empty.
+struct Arg
+{
+    std::string name;
+    std::string type;
+    std::string direction;
+};
+
+struct Method
+{
+    std::string name;
+    std::vector<Arg> args;
+};
+
+struct Signal
+{
+    std::string name;
+    std::vector<Arg> args;
+};
+
+struct Property
+{
+    std::string name;
+    std::string type;
+    std::string access;
+};
+
+struct Interface
+{
+    std::string name;
+    std::vector<Method> methods;
+    std::vector<Signal> signals;
+    std::vector<Property> properties;
+};
+
+struct Node
+{
+    std::vector<Interface> interfaces;
+    // Names of the child nodes, relative to this one
+    std::vector<std::string> children;
+
+    const Interface* findInterface(std::string_view name) const
+    {
+        for (const Interface& interface : interfaces)
+        {
+            if (interface.name == name)
+            {
+                return &interface;
+            }
+        }
+        return nullptr;
+    }
+};
+
+inline std::string attribute(const tinyxml2::XMLElement* element,
+                             const char* name)
+{
+    const char* value = element->Attribute(name);
+    if (value == nullptr)
+    {
+        return {};
+    }
+    return value;
+}
+
+inline std::vector<Arg> parseArgs(const tinyxml2::XMLElement* parent)
+{
+    std::vector<Arg> args;
+    for (const tinyxml2::XMLElement* arg = parent->FirstChildElement("arg");
+         arg != nullptr; arg = arg->NextSiblingElement("arg"))
+    {
+        args.push_back({attribute(arg, "name"), attribute(arg, "type"),
+                        attribute(arg, "direction")});
+    }
+    return args;
+}
+
+// Returns nullptr if the XML has no root node
+inline std::shared_ptr<const Node> parse(std::string_view xml)
+{
+    tinyxml2::XMLDocument doc;
+    doc.Parse(xml.data(), xml.size());
+    const tinyxml2::XMLElement* root = doc.FirstChildElement("node");
+    if (root == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto node = std::make_shared<Node>();
+    for (const tinyxml2::XMLElement* child = root->FirstChildElement("node");
+         child != nullptr; child = child->NextSiblingElement("node"))
+    {
+        const char* name = child->Attribute("name");
+        if (name != nullptr)
+        {
+            node->children.emplace_back(name);
+        }
+    }
+
+    for (const tinyxml2::XMLElement* ifaceNode =
+             root->FirstChildElement("interface");
+         ifaceNode != nullptr;
+         ifaceNode = ifaceNode->NextSiblingElement("interface"))
+    {
+        Interface& interface = node->interfaces.emplace_back();
+        interface.name = attribute(ifaceNode, "name");
+        for (const tinyxml2::XMLElement* method =
+                 ifaceNode->FirstChildElement("method");
+             method != nullptr; method = method->NextSiblingElement("method"))
+        {
+            interface.methods.push_back(
+                {attribute(method, "name"), parseArgs(method)});
+        }
+        for (const tinyxml2::XMLElement* signal =
+                 ifaceNode->FirstChildElement("signal");
+             signal != nullptr; signal = signal->NextSiblingElement("signal"))
+        {
+            interface.signals.push_back(
+                {attribute(signal, "name"), parseArgs(signal)});
+        }
+        for (const tinyxml2::XMLElement* property =
+                 ifaceNode->FirstChildElement("property");
+             property != nullptr;
+             property = property->NextSiblingElement("property"))
+        {
+            interface.properties.push_back({attribute(property, "name"),
+                                            attribute(property, "type"),
+                                            attribute(property, "access")});
+        }
+    }
+    return node;
+}
+
+/**
+ * @brief Cache of parsed introspection data, keyed by service and object
+ * path.
+ *
+ * Interface definitions almost never change while a service runs, so entries
+ * are kept until the service's owner changes or interfaces are added to or
+ * removed from the object.  Replies that race with one of those signals are
+ * handed to the caller but not stored.
+ */
+class Cache
+{
+  public:
+    using Callback = std::function<void(const boost::system::error_code&,
+                                        const std::shared_ptr<const Node>&)>;
+
+    // Bounds the cache for clients that walk the whole bus
+    static constexpr size_t maxEntries = 1024;
+
+    static Cache& getInstance()
+    {
+        static Cache cache;
+        return cache;
+    }
+
+    // Calls callback with the parsed introspection data of path on service,
+    // or with nullptr if the service returned XML that couldn't be parsed.
+    // A cached entry is delivered before get() returns.
+    void get(const std::string& service, const std::string& path,
+             Callback&& callback)
+    {
+        watch();
+        auto it = entries.find(std::make_pair(service, path));
+        if (it != entries.end())
+        {
+            callback(boost::system::error_code(), it->second);
+            return;
+        }
+
+        dbus::utility::coalescedMethodCall<std::string>(
+            [this, service, path, generationAtCall{generation},
+             callback{std::move(callback)}](const boost::system::error_code ec,
+                                            const std::string& xml) {
+                if (ec)
+                {
+                    callback(ec, nullptr);
+                    return;
+                }
+                std::shared_ptr<const Node> node = parse(xml);
+                if (node != nullptr && generationAtCall == generation)
+                {
+                    if (entries.size() >= maxEntries)
+                    {
+                        entries.clear();
+                    }
+                    entries.insert_or_assign(std::make_pair(service, path),
+                                             node);
+                }
+                callback(ec, node);
+            },
+            service, path, "org.freedesktop.DBus.Introspectable",
+            "Introspect");
+    }
+
+    void invalidateService(std::string_view service)
+    {
+        generation++;
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (it->first.first == service)
+            {
+                it = entries.erase(it);
+                continue;
+            }
+            it++;
+        }
+    }
+
+    // Drops path itself and its parent, whose list of children may have
+    // changed
+    void invalidatePath(const std::string& path)
+    {
+        generation++;
+        std::string_view parent(path);
+        size_t lastSlash = parent.rfind('/');
+        parent = parent.substr(0, lastSlash == 0 ? 1 : lastSlash);
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (it->first.second == path || it->first.second == parent)
+            {
+                it = entries.erase(it);
+                continue;
+            }
+            it++;
+        }
+    }
+
+    // For a signal that couldn't be read, which could have changed anything
+    void invalidateAll()
+    {
+        generation++;
+        entries.clear();
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    Cache() = default;
+
+    // The matches can only be made once the bus connection exists, so they
+    // are set up on first use
+    void watch()
+    {
+        if (nameOwnerMatch != nullptr)
+        {
+            return;
+        }
+        nameOwnerMatch = std::make_unique<sdbusplus::bus::match::match>(
+            *crow::connections::systemBus,
+            "type='signal',sender='org.freedesktop.DBus',"
+            "interface='org.freedesktop.DBus',member='NameOwnerChanged'",
+            [this](sdbusplus::message::message& m) {
+                std::string name;
+                std::string oldOwner;
+                std::string newOwner;
+                try
+                {
+                    m.read(name, oldOwner, newOwner);
+                }
+                catch (const sdbusplus::exception::exception& e)
+                {
+                    BMCWEB_LOG_ERROR << "Failed to read NameOwnerChanged: "
+                                     << e.what();
+                    invalidateAll();
+                    return;
+                }
+                invalidateService(name);
+                if (!oldOwner.empty())
+                {
+                    invalidateService(oldOwner);
+                }
+            });
+        auto onInterfacesChanged = [this](sdbusplus::message::message& m) {
+            sdbusplus::message::object_path path;
+            try
+            {
+                m.read(path);
+            }
+            catch (const sdbusplus::exception::exception& e)
+            {
+                BMCWEB_LOG_ERROR << "Failed to read " << m.get_member() << ": "
+                                 << e.what();
+                invalidateAll();
+                return;
+            }
+            invalidatePath(path.str);
+        };
+        interfacesAddedMatch = std::make_unique<sdbusplus::bus::match::match>(
+            *crow::connections::systemBus,
+            "type='signal',interface='org.freedesktop.DBus.ObjectManager',"
+            "member='InterfacesAdded'",
+            onInterfacesChanged);
+        interfacesRemovedMatch =
+            std::make_unique<sdbusplus::bus::match::match>(
+                *crow::connections::systemBus,
+                "type='signal',interface='org.freedesktop.DBus.ObjectManager',"
+                "member='InterfacesRemoved'",
+                onInterfacesChanged);
+    }
+
+    boost::container::flat_map<std::pair<std::string, std::string>,
+                               std::shared_ptr<const Node>>
+        entries;
+    // Bumped on every invalidation, so a reply requested before one isn't
+    // cached
+    uint64_t generation = 0;
+    std::unique_ptr<sdbusplus::bus::match::match> nameOwnerMatch;
+    std::unique_ptr<sdbusplus::bus::match::match> interfacesAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match::match> interfacesRemovedMatch;
+};
+
+} // namespace dbus_introspection
+} // namespace crow
@@ -15,10 +15,22 @@
  */
 #pragma once
 
+#include "logging.hpp"
+
 #include <sdbusplus/message.hpp>
 
+#include <coroutine>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <regex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace dbus
 {
@@ -107,5 +119,287 @@ inline void checkDbusPathExists(const std::string& path, Callback&& callback)
         std::array<std::string, 0>());
 }
 
+struct CoalescedCallStats
+{
+    // Calls that were actually sent on the bus
+    uint64_t issued = 0;
+    // Calls that attached to an identical call already in flight
+    uint64_t coalesced = 0;
+};
+
+inline CoalescedCallStats& getCoalescedCallStats()
+{
+    static CoalescedCallStats stats;
+    return stats;
+}
+
+namespace details
+{
+
+template <typename Arg>
+inline void appendCallKey(std::string& key, const Arg& arg)
+{
+    if constexpr (std::is_convertible_v<const Arg&, std::string_view>)
+    {
+        key += std::string_view(arg);
+    }
+    else if constexpr (std::is_arithmetic_v<Arg>)
+    {
+        key += std::to_string(arg);
+    }
+    else
+    {
+        key += '[';
+        for (const auto& element : arg)
+        {
+            appendCallKey(key, element);
+        }
+        key += ']';
+    }
+    key += '\0';
+}
+
+template <typename ResponseType>
+using CallWaiter = std::function<void(const boost::system::error_code&,
+                                      const ResponseType&)>;
+
+// The callers waiting on each outstanding coalescedMethodCall(), keyed on
+// service, path, interface, method and arguments.  There is one table per
+// reply type and no more, so a key can only ever be shared by callers that
+// decode the reply the same way, whatever their callbacks look like.
+template <typename ResponseType>
+inline std::unordered_map<std::string, std::vector<CallWaiter<ResponseType>>>&
+    inFlightTable()
+{
+    static std::unordered_map<std::string,
+                              std::vector<CallWaiter<ResponseType>>>
+        inFlight;
+    return inFlight;
+}
+
+template <typename... Args>
+inline std::string makeCallKey(const std::string& service,
+                               const std::string& objpath,
+                               const std::string& interf,
+                               const std::string& method, const Args&... args)
+{
+    std::string key;
+    for (const std::string* part : {&service, &objpath, &interf, &method})
+    {
+        appendCallKey(key, *part);
+    }
+    (appendCallKey(key, args), ...);
+    return key;
+}
+
+// Queues callback on the call with key.  Returns true if it is the first
+// caller, which then has to send the call and pass the reply to
+// completeCall().
+template <typename ResponseType, typename Callback>
+inline bool joinCall(const std::string& key, Callback&& callback)
+{
+    // The callback may be move-only; keep it behind a shared_ptr so that
+    // the waiter stays copyable
+    auto handler = std::make_shared<std::decay_t<Callback>>(
+        std::forward<Callback>(callback));
+    CallWaiter<ResponseType> waiter =
+        [handler](const boost::system::error_code& ec,
+                  const ResponseType& resp) { (*handler)(ec, resp); };
+
+    CoalescedCallStats& stats = getCoalescedCallStats();
+    auto& inFlight = inFlightTable<ResponseType>();
+    auto it = inFlight.find(key);
+    if (it != inFlight.end())
+    {
+        stats.coalesced++;
+        it->second.emplace_back(std::move(waiter));
+        return false;
+    }
+    stats.issued++;
+    inFlight[key].emplace_back(std::move(waiter));
+    return true;
+}
+
+// Hands the reply of the call with key to everyone waiting on it
+template <typename ResponseType>
+inline void completeCall(const std::string& key,
+                         const boost::system::error_code& ec,
+                         const ResponseType& resp)
+{
+    // Detach the waiters first, so that a callback making the same call
+    // again starts a fresh one rather than joining this one
+    auto node = inFlightTable<ResponseType>().extract(key);
+    if (node.empty())
+    {
+        return;
+    }
+    for (const CallWaiter<ResponseType>& waiter : node.mapped())
+    {
+        waiter(ec, resp);
+    }
+}
+
+} // namespace details
+
+/**
+ * @brief Makes a read-only D-Bus method call, sharing the reply with any
+ * identical call that is already waiting on the bus.
+ *
+ * Calls are identical when the service, path, interface, method and
+ * arguments all match.  Callers that arrive while the first call is still
+ * outstanding are queued on it and get the same error code and reply; a
+ * caller arriving after the reply has been delivered starts a new call, so no
+ * reply is ever older than the request that receives it.
+ *
+ * Only use this for methods without side effects such as GetAll,
+ * GetManagedObjects or the mapper queries.  The callback receives the reply
+ * as a const reference because it is shared.
+ */
+template <typename ResponseType, typename Callback, typename... Args>
+inline void coalescedMethodCall(Callback&& callback, const std::string& service,
+                                const std::string& objpath,
+                                const std::string& interf,
+                                const std::string& method, const Args&... args)
+{
+    std::string key =
+        details::makeCallKey(service, objpath, interf, method, args...);
+    if (!details::joinCall<ResponseType>(key,
+                                         std::forward<Callback>(callback)))
+    {
+        BMCWEB_LOG_DEBUG << "Coalescing " << method << " on " << objpath;
+        return;
+    }
+
+    crow::connections::systemBus->async_method_call(
+        [key](const boost::system::error_code ec, const ResponseType& resp) {
+            details::completeCall(key, ec, resp);
+        },
+        service, objpath, interf, method, args...);
+}
+
+// What co_await methodCall() gives back
+template <typename T = void>
+struct MethodResult
+{
+    boost::system::error_code ec;
+    // Name and message of the D-Bus error the call failed with, if any
+    std::string errorName;
+    std::string errorMessage;
+    T value{};
+};
+
+template <>
+struct MethodResult<void>
+{
+    boost::system::error_code ec;
+    std::string errorName;
+    std::string errorMessage;
+};
+
+/**
+ * @brief A D-Bus method call for coroutines to co_await.
+ *
+ *   auto result = co_await dbus::utility::methodCall<ReplyType>(
+ *       service, path, interface, method, args...);
+ *
+ * The call is made when it is awaited.  The reply is moved into the result,
+ * which lives in the coroutine frame, so there is no callback to allocate.
+ */
+template <typename T, typename... Args>
+class [[nodiscard]] MethodCall
+{
+  public:
+    MethodCall(const std::string& serviceIn, const std::string& objpathIn,
+               const std::string& interfIn, const std::string& methodIn,
+               const Args&... argsIn) :
+        service(serviceIn),
+        objpath(objpathIn), interf(interfIn), method(methodIn), args(argsIn...)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting)
+    {
+        std::apply(
+            [this, awaiting](const Args&... callArgs) {
+                if constexpr (std::is_void_v<T>)
+                {
+                    crow::connections::systemBus->async_method_call(
+                        [this,
+                         awaiting](const boost::system::error_code ec,
+                                   const sdbusplus::message::message& msg) {
+                            setError(ec, msg);
+                            awaiting.resume();
+                        },
+                        service, objpath, interf, method, callArgs...);
+                }
+                else
+                {
+                    crow::connections::systemBus->async_method_call(
+                        [this,
+                         awaiting](const boost::system::error_code ec,
+                                   const sdbusplus::message::message& msg,
+                                   T& value) {
+                            setError(ec, msg);
+                            result.value = std::move(value);
+                            awaiting.resume();
+                        },
+                        service, objpath, interf, method, callArgs...);
+                }
+            },
+            args);
+    }
+
+    MethodResult<T> await_resume()
+    {
+        return std::move(result);
+    }
+
+  private:
+    void setError(const boost::system::error_code& ec,
+                  const sdbusplus::message::message& msg)
+    {
+        result.ec = ec;
+        if (!ec)
+        {
+            return;
+        }
+        const sd_bus_error* dbusError = msg.get_error();
+        if (dbusError == nullptr)
+        {
+            return;
+        }
+        if (dbusError->name != nullptr)
+        {
+            result.errorName = dbusError->name;
+        }
+        if (dbusError->message != nullptr)
+        {
+            result.errorMessage = dbusError->message;
+        }
+    }
+
+    std::string service;
+    std::string objpath;
+    std::string interf;
+    std::string method;
+    std::tuple<Args...> args;
+    MethodResult<T> result;
+};
+
+// String literals are kept as const char*
+template <typename T = void, typename... Args>
+MethodCall<T, std::decay_t<const Args>...>
+    methodCall(const std::string& service, const std::string& objpath,
+               const std::string& interf, const std::string& method,
+               const Args&... args)
+{
+    return MethodCall<T, std::decay_t<const Args>...>(service, objpath, interf,
+                                                      method, args...);
+}
+
 } // namespace utility
 } // namespace dbus
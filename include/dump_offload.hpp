@@ -10,6 +10,9 @@
 #include <boost/beast/http.hpp>
 #include <http_stream.hpp>
 #include <ibm/utils.hpp>
+#include <ranged_download.hpp>
+
+#include <algorithm>
 
 namespace crow
 {
@@ -79,7 +82,8 @@ class Handler : public std::enable_shared_from_this<Handler>
                 }
                 waitTimer.cancel();
                 this->connection->sendStreamHeaders(
-                    std::to_string(this->dumpSize), "application/octet-stream");
+                    std::to_string(this->remainingBytes),
+                    "application/octet-stream");
                 this->doReadStream();
             });
     }
@@ -194,6 +198,27 @@ class Handler : public std::enable_shared_from_this<Handler>
                     return;
                 }
                 this->dumpSize = *dumpsize;
+
+                // Dump entries never change, so the entry and its size are
+                // enough to validate a resumed download
+                std::string etag = "\"" + this->dumpType + "-" +
+                                   this->entryID + "-" +
+                                   std::to_string(dumpSize) + "\"";
+                std::optional<http_helpers::ByteRange> range =
+                    crow::ranged_download::selectRange(
+                        rangeHeaders, this->connection->streamres, dumpSize,
+                        etag);
+                if (!range)
+                {
+                    this->connection->sendStreamErrorStatus(
+                        boost::beast::http::status::range_not_satisfiable);
+                    this->connection->close();
+                    return;
+                }
+                // The dump manager always writes the whole dump, so the
+                // bytes before the range are read and dropped
+                this->skipBytes = range->offset;
+                this->remainingBytes = range->length;
                 this->initiateOffload();
                 this->doConnect();
             },
@@ -234,13 +259,40 @@ class Handler : public std::enable_shared_from_this<Handler>
                 }
 
                 outputBuffer.commit(bytesRead);
-                auto streamHandler = [this, bytesRead,
+
+                size_t skip = static_cast<size_t>(
+                    std::min<uint64_t>(skipBytes, outputBuffer.size()));
+                outputBuffer.consume(skip);
+                skipBytes -= skip;
+
+                size_t toSend = static_cast<size_t>(
+                    std::min<uint64_t>(remainingBytes, outputBuffer.size()));
+                if (toSend == 0)
+                {
+                    if (remainingBytes == 0)
+                    {
+                        this->connection->close();
+                        return;
+                    }
+                    this->doReadStream();
+                    return;
+                }
+                remainingBytes -= toSend;
+
+                auto streamHandler = [this, toSend,
                                       self(shared_from_this())]() {
-                    this->outputBuffer.consume(bytesRead);
+                    this->outputBuffer.consume(toSend);
+                    if (this->remainingBytes == 0)
+                    {
+                        // End of the requested range
+                        this->connection->close();
+                        return;
+                    }
                     this->doReadStream();
                 };
-                this->connection->sendMessage(outputBuffer.data(),
-                                              streamHandler);
+                this->connection->sendMessage(
+                    boost::asio::buffer(outputBuffer.data(), toSend),
+                    streamHandler);
             });
     }
 
@@ -250,6 +302,11 @@ class Handler : public std::enable_shared_from_this<Handler>
     std::filesystem::path unixSocketPath;
     boost::asio::local::stream_protocol::socket unixSocket;
     uint64_t dumpSize;
+    crow::ranged_download::RangeHeaders rangeHeaders;
+    // Bytes still to drop before the requested range starts
+    uint64_t skipBytes = 0;
+    // Bytes of the requested range not yet sent
+    uint64_t remainingBytes = 0;
     boost::asio::steady_timer waitTimer;
     crow::streaming_response::Connection* connection = nullptr;
     uint16_t connectRetryCount;
@@ -290,6 +347,8 @@ inline void requestRoutes(App& app)
             handlers[&conn] = std::make_shared<Handler>(
                 *ioCon, dumpId, dumpType, unixSocketPath);
             handlers[&conn]->connection = &conn;
+            handlers[&conn]->rangeHeaders =
+                crow::ranged_download::RangeHeaders(conn.req);
 
             if (!crow::ibm_utils::createDirectory(unixSocketPathDir))
             {
@@ -357,6 +416,8 @@ inline void requestRoutes(App& app)
             handlers[&conn] = std::make_shared<Handler>(
                 *ioCon, dumpId, dumpType, unixSocketPath);
             handlers[&conn]->connection = &conn;
+            handlers[&conn]->rangeHeaders =
+                crow::ranged_download::RangeHeaders(conn.req);
 
             if (!crow::ibm_utils::createDirectory(unixSocketPathDir))
             {
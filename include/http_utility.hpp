@@ -3,6 +3,9 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <charconv>
+#include <cstdint>
+
 namespace http_helpers
 {
 inline std::vector<std::string> parseAccept(std::string_view header)
@@ -74,4 +77,137 @@ inline std::string urlEncode(const std::string_view value)
 
     return escaped.str();
 }
+// A single byte range of a representation, already clamped to its size
+struct ByteRange
+{
+    uint64_t offset = 0;
+    uint64_t length = 0;
+};
+
+enum class RangeStatus
+{
+    // No usable Range header; send the whole representation
+    None,
+    Satisfiable,
+    Unsatisfiable,
+};
+
+inline bool parseRangeNumber(std::string_view str, uint64_t& value)
+{
+    if (str.empty())
+    {
+        return false;
+    }
+    const char* end = str.data() + str.size();
+    auto [ptr, ec] = std::from_chars(str.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+// Parses a Range header against a representation of size bytes.  Only a
+// single "bytes" range is supported; anything else is ignored, as RFC 7233
+// allows, and results in the full representation being sent.
+inline RangeStatus parseRange(std::string_view header, uint64_t size,
+                              ByteRange& range)
+{
+    constexpr std::string_view unit = "bytes=";
+    if (!boost::starts_with(header, unit))
+    {
+        return RangeStatus::None;
+    }
+    std::string_view spec = header.substr(unit.size());
+    if (spec.find(',') != std::string_view::npos)
+    {
+        return RangeStatus::None;
+    }
+    size_t dash = spec.find('-');
+    if (dash == std::string_view::npos)
+    {
+        return RangeStatus::None;
+    }
+    std::string_view firstStr = spec.substr(0, dash);
+    std::string_view lastStr = spec.substr(dash + 1);
+
+    uint64_t first = 0;
+    uint64_t last = 0;
+    if (firstStr.empty())
+    {
+        // Suffix range, the final N bytes
+        if (!parseRangeNumber(lastStr, last))
+        {
+            return RangeStatus::None;
+        }
+        if (last == 0 || size == 0)
+        {
+            return RangeStatus::Unsatisfiable;
+        }
+        range.length = std::min(last, size);
+        range.offset = size - range.length;
+        return RangeStatus::Satisfiable;
+    }
+    if (!parseRangeNumber(firstStr, first))
+    {
+        return RangeStatus::None;
+    }
+    if (lastStr.empty())
+    {
+        last = size - 1;
+    }
+    else if (!parseRangeNumber(lastStr, last) || last < first)
+    {
+        return RangeStatus::None;
+    }
+    if (first >= size)
+    {
+        return RangeStatus::Unsatisfiable;
+    }
+    last = std::min(last, size - 1);
+    range.offset = first;
+    range.length = last - first + 1;
+    return RangeStatus::Satisfiable;
+}
+
+// Checks an If-None-Match header against the entity tag of the current
+// representation.  RFC 7232 asks for the weak comparison here: "*" matches
+// anything, and otherwise any tag in the comma separated list whose opaque
+// tag equals that of etag, with or without a W/ prefix on either side.
+inline bool ifNoneMatchMatches(std::string_view header, std::string_view etag)
+{
+    if (boost::starts_with(etag, "W/"))
+    {
+        etag.remove_prefix(2);
+    }
+    while (true)
+    {
+        size_t start = header.find_first_not_of(" \t,");
+        if (start == std::string_view::npos)
+        {
+            return false;
+        }
+        header.remove_prefix(start);
+        if (header[0] == '*')
+        {
+            return true;
+        }
+        if (boost::starts_with(header, "W/"))
+        {
+            header.remove_prefix(2);
+        }
+        // An opaque tag may hold commas, so find its closing quote rather
+        // than splitting the list on them
+        if (header.empty() || header[0] != '"')
+        {
+            return false;
+        }
+        size_t end = header.find('"', 1);
+        if (end == std::string_view::npos)
+        {
+            return false;
+        }
+        if (header.substr(0, end + 1) == etag)
+        {
+            return true;
+        }
+        header.remove_prefix(end + 1);
+    }
+}
 } // namespace http_helpers
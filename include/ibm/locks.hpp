@@ -7,8 +7,14 @@
 #include <logging.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
 
 namespace crow
 {
@@ -37,10 +43,84 @@ using RcReleaseLockApi = std::pair<bool, std::variant<bool, RcRelaseLock>>;
 using SessionFlags = std::pair<SType, SType>;
 using ListOfSessionIds = std::vector<std::string>;
 
+/*
+ * Index of lock records, for finding the records an incoming lock record
+ * conflicts with without comparing it against the whole lock table.
+ *
+ * isConflictRecord() walks the segments of two records side by side.  While
+ * both segments are DontLock with the same length and the resource IDs agree
+ * on the bytes the segment covers it moves on to the next segment, and the
+ * first LockAll or LockSame segment of either record decides the outcome.
+ * Two records can therefore only conflict at that segment, and only if all
+ * of the segments before it matched.  A record is filed under one key per
+ * segment, up to and including its first LockAll or LockSame segment: the
+ * segment number, the lengths of the segments before it, and the resource
+ * ID masked down to the bytes those segments cover.  A lookup for that
+ * segment then only returns records that matched up to it.
+ */
+class LockIndex
+{
+  public:
+    // Transaction ID, and position of the record within the transaction
+    using RecordRef = std::pair<uint32_t, uint32_t>;
+
+    void insert(const LockRequest& record, const RecordRef& ref);
+    void erase(const LockRequest& record, const RecordRef& ref);
+
+    /*
+     * Returns the first record, in transaction order, that conflicts with
+     * the given one.  This is the record a scan of the lock table with
+     * isConflictRecord() would stop at.
+     */
+    std::optional<RecordRef> findConflict(const LockRequest& record) const;
+
+    /*
+     * Number of leading resource ID bytes isConflictRecord() compares for
+     * the first `count` segments.  It compares segment-length bytes once for
+     * every byte of the segment length.
+     */
+    static uint32_t comparedBytes(const SegmentFlags& segments, size_t count);
+
+  private:
+    enum class Flag : uint8_t
+    {
+        dontLock,
+        lockSame,
+        lockAll
+    };
+
+    // Masked resource ID, the segment number together with the lengths of
+    // the segments before it, and the slot of the record
+    using Key = std::tuple<uint64_t, uint32_t, uint8_t>;
+
+    static Flag getFlag(const SType& flag);
+    static size_t firstLockingSegment(const SegmentFlags& segments);
+    // Segments a record is filed under
+    static size_t indexedSegments(const SegmentFlags& segments);
+
+    // Records under one masked ID and segment are told apart by the flag and
+    // length of that segment and by the lock type
+    static uint8_t slot(Flag flag, uint32_t length, bool write);
+    static Key makeKey(const LockRequest& record, size_t segment);
+
+    std::map<Key, std::set<RecordRef>> buckets;
+};
+
 class Lock
 {
     uint32_t transactionId;
     boost::container::flat_map<uint32_t, LockRequests> lockTable;
+    LockIndex lockIndex;
+    // Transactions of each session
+    boost::container::flat_map<std::string, std::set<uint32_t>>
+        sessionTransactions;
+
+    /*
+     * These keep the lock table, the lock index and the session index in
+     * step.
+     */
+    void addTransaction(uint32_t id, const LockRequests& requests);
+    void eraseTransaction(uint32_t id);
 
   protected:
     /*
@@ -173,33 +253,222 @@ class Lock
     virtual ~Lock() = default;
 };
 
-inline RcGetLockList Lock::getLockList(const ListOfSessionIds& listSessionId)
+inline uint32_t LockIndex::comparedBytes(const SegmentFlags& segments,
+                                         size_t count)
 {
+    uint32_t bytes = 0;
+    for (size_t i = 0; i < count && i < segments.size(); i++)
+    {
+        bytes += segments[i].second * segments[i].second;
+    }
+    return std::min<uint32_t>(bytes, sizeof(uint64_t));
+}
 
-    std::vector<std::pair<uint32_t, LockRequests>> lockList;
+inline LockIndex::Flag LockIndex::getFlag(const SType& flag)
+{
+    if (flag == "LockAll")
+    {
+        return Flag::lockAll;
+    }
+    if (flag == "LockSame")
+    {
+        return Flag::lockSame;
+    }
+    return Flag::dontLock;
+}
+
+inline size_t LockIndex::firstLockingSegment(const SegmentFlags& segments)
+{
+    for (size_t i = 0; i < segments.size(); i++)
+    {
+        if (getFlag(segments[i].first) != Flag::dontLock)
+        {
+            return i;
+        }
+    }
+    return segments.size();
+}
+
+inline uint8_t LockIndex::slot(Flag flag, uint32_t length, bool write)
+{
+    return static_cast<uint8_t>(
+        ((static_cast<uint32_t>(flag) * 4 + (length - 1)) * 2) +
+        (write ? 1 : 0));
+}
+
+inline LockIndex::Key LockIndex::makeKey(const LockRequest& record,
+                                         size_t segment)
+{
+    const SegmentFlags& segments = std::get<4>(record);
+
+    // The first segment covers the most significant bytes of the ID
+    uint32_t bytes = comparedBytes(segments, segment);
+    uint64_t maskedId = std::get<3>(record);
+    if (bytes < sizeof(uint64_t))
+    {
+        // Shifting by the full width would be undefined
+        maskedId &= bytes == 0 ? 0
+                               : ~(std::numeric_limits<uint64_t>::max() >>
+                                   (bytes * 8));
+    }
+
+    uint32_t shape = static_cast<uint32_t>(segment);
+    for (size_t i = 0; i < segment; i++)
+    {
+        shape |= (segments[i].second - 1) << (3 + 2 * i);
+    }
+
+    return {maskedId, shape,
+            slot(getFlag(segments[segment].first), segments[segment].second,
+                 std::get<2>(record) != "Read")};
+}
+
+inline size_t LockIndex::indexedSegments(const SegmentFlags& segments)
+{
+    return std::min(firstLockingSegment(segments) + 1, segments.size());
+}
+
+inline void LockIndex::insert(const LockRequest& record, const RecordRef& ref)
+{
+    for (size_t segment = 0; segment < indexedSegments(std::get<4>(record));
+         segment++)
+    {
+        buckets[makeKey(record, segment)].insert(ref);
+    }
+}
+
+inline void LockIndex::erase(const LockRequest& record, const RecordRef& ref)
+{
+    for (size_t segment = 0; segment < indexedSegments(std::get<4>(record));
+         segment++)
+    {
+        auto bucket = buckets.find(makeKey(record, segment));
+        if (bucket == buckets.end())
+        {
+            continue;
+        }
+        bucket->second.erase(ref);
+        if (bucket->second.empty())
+        {
+            buckets.erase(bucket);
+        }
+    }
+}
+
+inline std::optional<LockIndex::RecordRef>
+    LockIndex::findConflict(const LockRequest& record) const
+{
+    const SegmentFlags& segments = std::get<4>(record);
+    bool write = std::get<2>(record) != "Read";
+    size_t locking = firstLockingSegment(segments);
 
-    if (!lockTable.empty())
+    std::optional<RecordRef> first;
+    for (size_t segment = 0; segment <= locking && segment < segments.size();
+         segment++)
     {
-        for (const auto& i : listSessionId)
+        Flag flag = getFlag(segments[segment].first);
+        uint32_t length = segments[segment].second;
+
+        // Every record filed under this segment matched the segments before
+        // it, and is either DontLock here or stops at this segment
+        Key key = makeKey(record, segment);
+        std::get<2>(key) = 0;
+        for (auto bucket = buckets.lower_bound(key);
+             bucket != buckets.end() &&
+             std::get<0>(bucket->first) == std::get<0>(key) &&
+             std::get<1>(bucket->first) == std::get<1>(key);
+             bucket++)
         {
-            auto it = lockTable.begin();
-            while (it != lockTable.end())
+            uint8_t otherSlot = std::get<2>(bucket->first);
+            bool otherWrite = (otherSlot % 2) != 0;
+            uint32_t otherLength = (otherSlot / 2) % 4 + 1;
+            auto otherFlag = static_cast<Flag>(otherSlot / 8);
+
+            // Two read locks never conflict
+            if (!write && !otherWrite)
             {
-                // Check if session id of this entry matches with session id
-                // given
-                if (std::get<0>(it->second[0]) == i)
-                {
-                    BMCWEB_LOG_DEBUG << "Session id is found in the locktable";
+                continue;
+            }
+            if (flag == Flag::dontLock && otherFlag == Flag::dontLock)
+            {
+                // Neither stops here, the segments after this one decide
+                continue;
+            }
+            if (flag != Flag::lockAll && otherFlag != Flag::lockAll &&
+                length != otherLength)
+            {
+                continue;
+            }
+            const RecordRef& candidate = *bucket->second.begin();
+            if (!first || candidate < *first)
+            {
+                first = candidate;
+            }
+        }
+    }
+    return first;
+}
 
-                    // Push the whole lock record into a vector for returning
-                    // the json
-                    lockList.emplace_back(it->first, it->second);
-                }
-                // Go to next entry in map
-                it++;
+inline void Lock::addTransaction(uint32_t id, const LockRequests& requests)
+{
+    lockTable.emplace(id, requests);
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        lockIndex.insert(requests[i], {id, i});
+    }
+    if (!requests.empty())
+    {
+        sessionTransactions[std::get<0>(requests[0])].insert(id);
+    }
+}
+
+inline void Lock::eraseTransaction(uint32_t id)
+{
+    auto it = lockTable.find(id);
+    if (it == lockTable.end())
+    {
+        return;
+    }
+    const LockRequests& requests = it->second;
+    for (uint32_t i = 0; i < requests.size(); i++)
+    {
+        lockIndex.erase(requests[i], {id, i});
+    }
+    if (!requests.empty())
+    {
+        auto session = sessionTransactions.find(std::get<0>(requests[0]));
+        if (session != sessionTransactions.end())
+        {
+            session->second.erase(id);
+            if (session->second.empty())
+            {
+                sessionTransactions.erase(session);
             }
         }
     }
+    lockTable.erase(it);
+}
+
+inline RcGetLockList Lock::getLockList(const ListOfSessionIds& listSessionId)
+{
+
+    std::vector<std::pair<uint32_t, LockRequests>> lockList;
+
+    for (const auto& i : listSessionId)
+    {
+        auto session = sessionTransactions.find(i);
+        if (session == sessionTransactions.end())
+        {
+            continue;
+        }
+        BMCWEB_LOG_DEBUG << "Session id is found in the locktable";
+        for (uint32_t id : session->second)
+        {
+            // Push the whole lock record into a vector for returning the
+            // json
+            lockList.emplace_back(id, lockTable[id]);
+        }
+    }
     // we may have found at least one entry with the given session id
     // return the json list of lock records pertaining to the given
     // session id, or send an empty list if lock table is empty
@@ -264,29 +533,20 @@ inline RcAcquireLock Lock::acquireLock(const LockRequests& lockRequestStructure)
 
 inline void Lock::releaseLock(const std::string& sessionId)
 {
-    if (!lockTable.empty())
+    auto session = sessionTransactions.find(sessionId);
+    if (session == sessionTransactions.end())
     {
-        auto it = lockTable.begin();
-        while (it != lockTable.end())
-        {
-            if (it->second.size() != 0)
-            {
-                // Check if session id of this entry matches with session id
-                // given
-                if (std::get<0>(it->second[0]) == sessionId)
-                {
-                    BMCWEB_LOG_DEBUG << "Remove the lock from the locktable "
-                                        "having sessionID="
-                                     << sessionId;
-                    BMCWEB_LOG_DEBUG << "TransactionID =" << it->first;
-                    it = lockTable.erase(it);
-                }
-                else
-                {
-                    it++;
-                }
-            }
-        }
+        return;
+    }
+    // eraseTransaction() drops the session once its last transaction is gone
+    std::set<uint32_t> ids = session->second;
+    for (uint32_t id : ids)
+    {
+        BMCWEB_LOG_DEBUG << "Remove the lock from the locktable "
+                            "having sessionID="
+                         << sessionId;
+        BMCWEB_LOG_DEBUG << "TransactionID =" << id;
+        eraseTransaction(id);
     }
 }
 inline RcRelaseLock Lock::isItMyLock(const ListOfTransactionIds& refRids,
@@ -307,10 +567,11 @@ inline RcRelaseLock Lock::isItMyLock(const ListOfTransactionIds& refRids,
             // It is owned by the currently request hmc
             BMCWEB_LOG_DEBUG << "Lock is owned  by the current hmc";
             // remove the lock
-            if (lockTable.erase(id))
+            if (lockTable.find(id) != lockTable.end())
             {
                 BMCWEB_LOG_DEBUG << "Removing the locks with transaction ID : "
                                  << id;
+                eraseTransaction(id);
             }
             else
             {
@@ -429,40 +690,34 @@ inline Rc Lock::isConflictWithTable(const LockRequests& refLockRequestStructure)
         // Lock table is empty, so we are safe to add the lockrecords
         // as there will be no conflict
         BMCWEB_LOG_DEBUG << "Lock table is empty, so adding the lockrecords";
-        lockTable.emplace(std::pair<uint32_t, LockRequests>(
-            transactionId, refLockRequestStructure));
+        addTransaction(transactionId, refLockRequestStructure);
 
         return std::make_pair(false, transactionId);
     }
     BMCWEB_LOG_DEBUG
         << "Lock table is not empty, check for conflict with lock table";
-    // Lock table is not empty, compare the lockrequest entries with
-    // the entries in the lock table
+    // Lock table is not empty, look the lockrequest entries up in the
+    // index of the entries in the lock table
 
     for (const auto& lockRecord1 : refLockRequestStructure)
     {
-        for (const auto& map : lockTable)
+        std::optional<LockIndex::RecordRef> conflict =
+            lockIndex.findConflict(lockRecord1);
+        if (conflict)
         {
-            for (const auto& lockRecord2 : map.second)
-            {
-                bool status = isConflictRecord(lockRecord1, lockRecord2);
-                if (status)
-                {
-                    return std::make_pair(
-                        true, std::make_pair(map.first, lockRecord2));
-                }
-            }
+            return std::make_pair(
+                true, std::make_pair(
+                          conflict->first,
+                          lockTable[conflict->first][conflict->second]));
         }
     }
 
     // Reached here, so no conflict with the locktable, so we are safe to
     // add the request records into the lock table
 
-    // Lock table is empty, so we are safe to add the lockrecords
-    // as there will be no conflict
     BMCWEB_LOG_DEBUG << " Adding elements into lock table";
     transactionId = generateTransactionId();
-    lockTable.emplace(std::make_pair(transactionId, refLockRequestStructure));
+    addTransaction(transactionId, refLockRequestStructure);
 
     return std::make_pair(false, transactionId);
 }
@@ -483,21 +738,18 @@ inline bool Lock::isConflictRequest(const LockRequests& refLockRequestStructure)
     BMCWEB_LOG_DEBUG
         << "There are multiple lock requests coming in a single request";
 
-    // There are multiple requests a part of one request
+    // There are multiple requests a part of one request, check each one
+    // against the ones before it
 
+    LockIndex requestIndex;
     for (uint32_t i = 0; i < refLockRequestStructure.size(); i++)
     {
-        for (uint32_t j = i + 1; j < refLockRequestStructure.size(); j++)
+        const LockRequest& p = refLockRequestStructure[i];
+        if (requestIndex.findConflict(p))
         {
-            const LockRequest& p = refLockRequestStructure[i];
-            const LockRequest& q = refLockRequestStructure[j];
-            bool status = isConflictRecord(p, q);
-
-            if (status)
-            {
-                return true;
-            }
+            return true;
         }
+        requestIndex.insert(p, {0, i});
     }
     return false;
 }
@@ -513,6 +765,13 @@ inline bool Lock::isConflictRequest(const LockRequests& refLockRequestStructure)
 inline bool Lock::checkByte(uint64_t resourceId1, uint64_t resourceId2,
                             uint32_t position)
 {
+    // Segments can describe more bytes than a resource id has, there is
+    // nothing to tell those apart
+    if (position >= sizeof(uint64_t))
+    {
+        return true;
+    }
+
     uint8_t* p = reinterpret_cast<uint8_t*>(&resourceId1);
     uint8_t* q = reinterpret_cast<uint8_t*>(&resourceId2);
 
@@ -542,6 +801,11 @@ inline bool Lock::isConflictRecord(const LockRequest& refLockRecord1,
     uint32_t segStartIndex = 0;
     for (const auto& p : std::get<4>(refLockRecord1))
     {
+        // The records describe resources at different levels
+        if (i >= std::get<4>(refLockRecord2).size())
+        {
+            return false;
+        }
 
         // return conflict when any of them is try to lock all resources
         // under the current resource level.
@@ -10,6 +10,7 @@
 #include <error_messages.hpp>
 #include <event_service_manager.hpp>
 #include <ibm/locks.hpp>
+#include <ibm/save_area.hpp>
 #include <nlohmann/json.hpp>
 #include <resource_messages.hpp>
 #include <sdbusplus/message/types.hpp>
@@ -55,6 +56,12 @@ static boost::container::flat_map<std::string,
                                   std::unique_ptr<sdbusplus::bus::match::match>>
     ackMatches;
 
+inline SaveArea& getSaveArea()
+{
+    static SaveArea saveArea(configFilePath, maxSaveareaDirSize);
+    return saveArea;
+}
+
 inline bool isValidConfigFileName(const std::string& fileName,
                                   crow::Response& res)
 {
@@ -111,104 +118,22 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
             "File size exceeds maximum allowed size[10MB]";
         return false;
     }
-    std::ofstream file;
-    std::filesystem::path loc(configFilePath);
-
-    // Get the current size of the savearea directory
-    std::filesystem::recursive_directory_iterator iter(loc, ec);
-    if (ec)
-    {
-        asyncResp->res.result(
-            boost::beast::http::status::internal_server_error);
-        asyncResp->res.jsonValue["Description"] = internalFileSystemError;
-        BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to prepare save-area "
-                            "directory iterator. ec : "
-                         << ec;
-        return false;
-    }
-    std::uintmax_t saveAreaDirSize = 0;
-    for (auto& it : iter)
-    {
-        if (!std::filesystem::is_directory(it, ec))
-        {
-            if (ec)
-            {
-                asyncResp->res.result(
-                    boost::beast::http::status::internal_server_error);
-                asyncResp->res.jsonValue["Description"] =
-                    internalFileSystemError;
-                BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find save-area "
-                                    "directory . ec : "
-                                 << ec;
-                return false;
-            }
-            std::uintmax_t fileSize = std::filesystem::file_size(it, ec);
-            if (ec)
-            {
-                asyncResp->res.result(
-                    boost::beast::http::status::internal_server_error);
-                asyncResp->res.jsonValue["Description"] =
-                    internalFileSystemError;
-                BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find save-area "
-                                    "file size inside the directory . ec : "
-                                 << ec;
-                return false;
-            }
-            saveAreaDirSize += fileSize;
-        }
-    }
-    BMCWEB_LOG_DEBUG << "saveAreaDirSize: " << saveAreaDirSize;
-
-    // Form the file path
-    loc /= fileID;
-    BMCWEB_LOG_DEBUG << "Writing to the file: " << loc;
+    SaveArea& saveArea = getSaveArea();
 
     // Check if the same file exists in the directory
-    bool fileExists = std::filesystem::exists(loc, ec);
+    bool fileExists = saveArea.find(fileID, ec) != nullptr;
     if (ec)
     {
         asyncResp->res.result(
             boost::beast::http::status::internal_server_error);
         asyncResp->res.jsonValue["Description"] = internalFileSystemError;
-        BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find if file exists. ec : "
+        BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to read the save-area "
+                            "directory. ec : "
                          << ec;
         return false;
     }
-    std::uintmax_t newSizeToWrite = 0;
-    if (fileExists)
-    {
-        // File exists. Get the current file size
-        std::uintmax_t currentFileSize = std::filesystem::file_size(loc, ec);
-        if (ec)
-        {
-            asyncResp->res.result(
-                boost::beast::http::status::internal_server_error);
-            asyncResp->res.jsonValue["Description"] = internalFileSystemError;
-            BMCWEB_LOG_DEBUG << "handleIbmPut: Failed to find file size. ec : "
-                             << ec;
-            return false;
-        }
-        // Calculate the difference in the file size.
-        // If the data.length is greater than the existing file size, then
-        // calculate the difference. Else consider the delta size as zero -
-        // because there is no increase in the total directory size.
-        // We need to add the diff only if the incoming data is larger than the
-        // existing filesize
-        if (data.length() > currentFileSize)
-        {
-            newSizeToWrite = data.length() - currentFileSize;
-        }
-        BMCWEB_LOG_DEBUG << "newSizeToWrite: " << newSizeToWrite;
-    }
-    else
-    {
-        // This is a new file upload
-        newSizeToWrite = data.length();
-    }
 
-    // Calculate the total dir size before writing the new file
-    BMCWEB_LOG_DEBUG << "total new size: " << saveAreaDirSize + newSizeToWrite;
-    if ((saveAreaDirSize + newSizeToWrite) > maxSaveareaDirSize)
+    if (!saveArea.fits(fileID, data.length(), ec))
     {
         asyncResp->res.result(boost::beast::http::status::bad_request);
         asyncResp->res.jsonValue["Description"] =
@@ -217,23 +142,16 @@ inline bool saveConfigFile(const std::string& data, const std::string& fileID,
         return false;
     }
 
-    file.open(loc, std::ofstream::out);
-
-    // set the permission of the file to 600
-    std::filesystem::perms permission = std::filesystem::perms::owner_write |
-                                        std::filesystem::perms::owner_read;
-    std::filesystem::permissions(loc, permission);
-
-    if (file.fail())
+    BMCWEB_LOG_DEBUG << "Writing to the file: " << fileID;
+    if (!saveArea.write(fileID, data, ec))
     {
-        BMCWEB_LOG_DEBUG << "Error while opening the file for writing";
+        BMCWEB_LOG_DEBUG << "Error while writing the file. ec : " << ec;
         asyncResp->res.result(
             boost::beast::http::status::internal_server_error);
         asyncResp->res.jsonValue["Description"] =
             "Error while creating the file";
         return false;
     }
-    file << data;
     std::string origin = "/ibm/v1/Host/ConfigFiles/" + fileID;
     // Push an event
     if (fileExists)
@@ -383,15 +301,10 @@ inline void
     handleConfigFileList(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
     std::vector<std::string> pathObjList;
-    std::filesystem::path loc(configFilePath);
-    if (std::filesystem::exists(loc) && std::filesystem::is_directory(loc))
+    std::error_code ec;
+    for (const auto& file : getSaveArea().list(ec))
     {
-        for (const auto& file : std::filesystem::directory_iterator(loc))
-        {
-            const std::filesystem::path& pathObj = file.path();
-            pathObjList.push_back("/ibm/v1/Host/ConfigFiles/" +
-                                  pathObj.filename().string());
-        }
+        pathObjList.push_back("/ibm/v1/Host/ConfigFiles/" + file.first);
     }
     asyncResp->res.jsonValue["@odata.type"] =
         "#IBMConfigFile.v1_0_0.IBMConfigFile";
@@ -414,7 +327,7 @@ inline void
     std::filesystem::path loc(configFilePath);
     if (std::filesystem::exists(loc) && std::filesystem::is_directory(loc))
     {
-        std::filesystem::remove_all(loc, ec);
+        getSaveArea().removeAll(ec);
         if (ec)
         {
             asyncResp->res.result(
@@ -452,20 +365,11 @@ inline void handleFileGet(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                           const std::string& fileID)
 {
     BMCWEB_LOG_DEBUG << "HandleGet on SaveArea files on path: " << fileID;
-    std::filesystem::path loc(
-        "/var/lib/bmcweb/ibm-management-console/configfiles/" + fileID);
-    if (!std::filesystem::exists(loc))
-    {
-        BMCWEB_LOG_ERROR << loc << "Not found";
-        asyncResp->res.result(boost::beast::http::status::not_found);
-        asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
-        return;
-    }
-
-    std::ifstream readfile(loc.string());
-    if (!readfile)
+    std::error_code ec;
+    std::string fileData;
+    if (!getSaveArea().read(fileID, fileData, ec))
     {
-        BMCWEB_LOG_ERROR << loc.string() << "Not found";
+        BMCWEB_LOG_ERROR << fileID << " Not found. ec : " << ec;
         asyncResp->res.result(boost::beast::http::status::not_found);
         asyncResp->res.jsonValue["Description"] = resourceNotFoundMsg;
         return;
@@ -474,10 +378,7 @@ inline void handleFileGet(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     std::string contentDispositionParam =
         "attachment; filename=\"" + fileID + "\"";
     asyncResp->res.addHeader("Content-Disposition", contentDispositionParam);
-    std::string fileData;
-    fileData = {std::istreambuf_iterator<char>(readfile),
-                std::istreambuf_iterator<char>()};
-    asyncResp->res.jsonValue["Data"] = fileData;
+    asyncResp->res.jsonValue["Data"] = std::move(fileData);
     return;
 }
 
@@ -485,27 +386,22 @@ inline void
     handleFileDelete(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                      const std::string& fileID)
 {
-    std::string filePath("/var/lib/bmcweb/ibm-management-console/configfiles/" +
-                         fileID);
-    BMCWEB_LOG_DEBUG << "Removing the file : " << filePath << "\n";
-    std::ifstream fileOpen(filePath.c_str());
-    if (static_cast<bool>(fileOpen))
+    BMCWEB_LOG_DEBUG << "Removing the file : " << fileID << "\n";
+    std::error_code ec;
+    if (getSaveArea().remove(fileID, ec))
     {
-        if (remove(filePath.c_str()) == 0)
-        {
-            BMCWEB_LOG_DEBUG << "File removed!\n";
-            asyncResp->res.jsonValue["Description"] = "File Deleted";
-            std::string origin = "/ibm/v1/Host/ConfigFiles/" + fileID;
-            redfish::EventServiceManager::getInstance().sendEvent(
-                redfish::messages::resourceRemoved(), origin, "IBMConfigFile");
-        }
-        else
-        {
-            BMCWEB_LOG_ERROR << "File not removed!\n";
-            asyncResp->res.result(
-                boost::beast::http::status::internal_server_error);
-            asyncResp->res.jsonValue["Description"] = internalServerError;
-        }
+        BMCWEB_LOG_DEBUG << "File removed!\n";
+        asyncResp->res.jsonValue["Description"] = "File Deleted";
+        std::string origin = "/ibm/v1/Host/ConfigFiles/" + fileID;
+        redfish::EventServiceManager::getInstance().sendEvent(
+            redfish::messages::resourceRemoved(), origin, "IBMConfigFile");
+    }
+    else if (ec)
+    {
+        BMCWEB_LOG_ERROR << "File not removed! ec : " << ec;
+        asyncResp->res.result(
+            boost::beast::http::status::internal_server_error);
+        asyncResp->res.jsonValue["Description"] = internalServerError;
     }
     else
     {
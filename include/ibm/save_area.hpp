@@ -0,0 +1,311 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/container/flat_map.hpp>
+#include <logging.hpp>
+
+#include <cerrno>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace crow
+{
+namespace ibm_mc
+{
+
+struct SaveAreaFile
+{
+    std::uintmax_t size = 0;
+    std::time_t mtime = 0;
+};
+
+/**
+ * @brief Index of the files in the management console save area, with a
+ * running total of their size.
+ *
+ * The directory is read once, on first use; after that every write and
+ * removal goes through this class and keeps the index and the total current,
+ * so checking the quota or listing the files doesn't touch the disk.  Files
+ * are written to a temporary file that is then renamed over the old one, so
+ * a failed upload never leaves a truncated file behind.  Temporary files
+ * start with a '.', which valid file names can't.
+ */
+class SaveArea
+{
+  public:
+    SaveArea(const std::filesystem::path& dirIn, std::uintmax_t maxSizeIn) :
+        dir(dirIn), maxSize(maxSizeIn)
+    {}
+
+    // Returns nullptr if there is no such file
+    const SaveAreaFile* find(const std::string& name, std::error_code& ec)
+    {
+        if (!load(ec))
+        {
+            return nullptr;
+        }
+        auto it = files.find(name);
+        if (it == files.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    const boost::container::flat_map<std::string, SaveAreaFile>&
+        list(std::error_code& ec)
+    {
+        load(ec);
+        return files;
+    }
+
+    std::uintmax_t totalSize(std::error_code& ec)
+    {
+        load(ec);
+        return total;
+    }
+
+    // Whether name can be written with size bytes without going over the
+    // quota.  Only growth counts against the quota, so a file can always be
+    // replaced with a smaller one.
+    bool fits(const std::string& name, std::uintmax_t size,
+              std::error_code& ec)
+    {
+        const SaveAreaFile* file = find(name, ec);
+        if (ec)
+        {
+            return false;
+        }
+        std::uintmax_t growth = size;
+        if (file != nullptr)
+        {
+            growth = size > file->size ? size - file->size : 0;
+        }
+        BMCWEB_LOG_DEBUG << "saveAreaDirSize: " << total
+                         << " growth: " << growth;
+        return total + growth <= maxSize;
+    }
+
+    bool write(const std::string& name, std::string_view data,
+               std::error_code& ec)
+    {
+        if (!load(ec))
+        {
+            return false;
+        }
+        std::filesystem::path tmpPath = dir / ("." + name + ".tmp");
+        int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                      S_IRUSR | S_IWUSR);
+        if (fd < 0)
+        {
+            ec = lastError();
+            return false;
+        }
+
+        size_t done = 0;
+        while (done < data.size())
+        {
+            ssize_t rc = ::write(fd, data.data() + done, data.size() - done);
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (rc < 0)
+            {
+                ec = lastError();
+                break;
+            }
+            done += static_cast<size_t>(rc);
+        }
+        struct stat st
+        {};
+        if (!ec && (fsync(fd) != 0 || fstat(fd, &st) != 0))
+        {
+            ec = lastError();
+        }
+        close(fd);
+        if (!ec)
+        {
+            std::filesystem::rename(tmpPath, dir / name, ec);
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to write " << tmpPath << ": "
+                             << ec.message();
+            std::error_code ignored;
+            std::filesystem::remove(tmpPath, ignored);
+            return false;
+        }
+
+        update(name, {static_cast<std::uintmax_t>(st.st_size), st.st_mtime});
+        return true;
+    }
+
+    // Returns false if there is no such file, or on error
+    bool remove(const std::string& name, std::error_code& ec)
+    {
+        if (find(name, ec) == nullptr)
+        {
+            return false;
+        }
+        std::filesystem::path path = dir / name;
+        if (unlink(path.c_str()) != 0 && errno != ENOENT)
+        {
+            ec = lastError();
+            return false;
+        }
+        auto it = files.find(name);
+        total -= it->second.size;
+        files.erase(it);
+        return true;
+    }
+
+    void removeAll(std::error_code& ec)
+    {
+        std::filesystem::remove_all(dir, ec);
+        files.clear();
+        total = 0;
+        // Start over from whatever is left if removing failed half way
+        loaded = !ec;
+    }
+
+    /**
+     * @brief Reads the content of name into data, with a single read into a
+     * buffer of the right size.
+     *
+     * @return false if there is no such file, or on error
+     */
+    bool read(const std::string& name, std::string& data, std::error_code& ec)
+    {
+        if (find(name, ec) == nullptr)
+        {
+            return false;
+        }
+        std::filesystem::path path = dir / name;
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0 && errno == ENOENT)
+        {
+            // Removed behind our back
+            update(name, {});
+            files.erase(name);
+            return false;
+        }
+        if (fd < 0)
+        {
+            ec = lastError();
+            return false;
+        }
+        struct stat st
+        {};
+        if (fstat(fd, &st) != 0)
+        {
+            ec = lastError();
+            close(fd);
+            return false;
+        }
+        // Someone else changed the file, keep the quota honest
+        update(name, {static_cast<std::uintmax_t>(st.st_size), st.st_mtime});
+
+        data.resize(static_cast<size_t>(st.st_size));
+        size_t done = 0;
+        while (done < data.size())
+        {
+            ssize_t rc = pread(fd, data.data() + done, data.size() - done,
+                               static_cast<off_t>(done));
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (rc <= 0)
+            {
+                ec = rc < 0 ? lastError()
+                            : std::make_error_code(std::errc::io_error);
+                break;
+            }
+            done += static_cast<size_t>(rc);
+        }
+        close(fd);
+        if (ec)
+        {
+            data.clear();
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    static std::error_code lastError()
+    {
+        return {errno, std::generic_category()};
+    }
+
+    void update(const std::string& name, const SaveAreaFile& file)
+    {
+        SaveAreaFile& entry = files[name];
+        total = total - entry.size + file.size;
+        entry = file;
+    }
+
+    bool load(std::error_code& ec)
+    {
+        if (loaded)
+        {
+            return true;
+        }
+        files.clear();
+        total = 0;
+
+        std::filesystem::directory_iterator iter(dir, ec);
+        if (ec == std::errc::no_such_file_or_directory)
+        {
+            // Nothing uploaded yet
+            ec.clear();
+            loaded = true;
+            return true;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to read the save area " << dir << ": "
+                             << ec.message();
+            return false;
+        }
+        for (const std::filesystem::directory_entry& entry : iter)
+        {
+            std::string name = entry.path().filename().string();
+            if (name.starts_with("."))
+            {
+                // Left behind by an interrupted write
+                std::error_code ignored;
+                std::filesystem::remove(entry.path(), ignored);
+                continue;
+            }
+            struct stat st
+            {};
+            if (stat(entry.path().c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+            {
+                continue;
+            }
+            update(name,
+                   {static_cast<std::uintmax_t>(st.st_size), st.st_mtime});
+        }
+        BMCWEB_LOG_DEBUG << "Save area holds " << files.size()
+                         << " files, size " << total;
+        loaded = true;
+        return true;
+    }
+
+    const std::filesystem::path dir;
+    const std::uintmax_t maxSize;
+    bool loaded = false;
+    boost::container::flat_map<std::string, SaveAreaFile> files;
+    std::uintmax_t total = 0;
+};
+
+} // namespace ibm_mc
+} // namespace crow
@@ -13,19 +13,21 @@
 // limitations under the License.
 
 #pragma once
-#include <tinyxml2.h>
-
 #include <app.hpp>
 #include <async_resp.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/container/flat_set.hpp>
+#include <dbus_introspection.hpp>
 #include <dbus_singleton.hpp>
 #include <dbus_utility.hpp>
+#include <http_stream.hpp>
 #include <sdbusplus/message/types.hpp>
 
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <regex>
+#include <unordered_set>
 #include <utility>
 
 namespace crow
@@ -79,11 +81,12 @@ inline void
                                       {"objects", nlohmann::json::array()}};
     }
 
-    crow::connections::systemBus->async_method_call(
+    dbus_introspection::Cache::getInstance().get(
+        processName, objectPath,
         [transaction, processName{std::string(processName)},
          objectPath{std::string(objectPath)}](
-            const boost::system::error_code ec,
-            const std::string& introspectXml) {
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus_introspection::Node>& node) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR
@@ -95,39 +98,24 @@ inline void
             transaction->res.jsonValue["objects"].push_back(
                 {{"path", objectPath}});
 
-            tinyxml2::XMLDocument doc;
-
-            doc.Parse(introspectXml.c_str());
-            tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-            if (pRoot == nullptr)
+            if (node == nullptr)
             {
                 BMCWEB_LOG_ERROR << "XML document failed to parse "
                                  << processName << " " << objectPath << "\n";
+                return;
             }
-            else
+            for (const std::string& childPath : node->children)
             {
-                tinyxml2::XMLElement* node = pRoot->FirstChildElement("node");
-                while (node != nullptr)
+                std::string newpath;
+                if (objectPath != "/")
                 {
-                    const char* childPath = node->Attribute("name");
-                    if (childPath != nullptr)
-                    {
-                        std::string newpath;
-                        if (objectPath != "/")
-                        {
-                            newpath += objectPath;
-                        }
-                        newpath += std::string("/") + childPath;
-                        // introspect the subobjects as well
-                        introspectObjects(processName, newpath, transaction);
-                    }
-
-                    node = node->NextSiblingElement("node");
+                    newpath += objectPath;
                 }
+                newpath += std::string("/") + childPath;
+                // introspect the subobjects as well
+                introspectObjects(processName, newpath, transaction);
             }
-        },
-        processName, objectPath, "org.freedesktop.DBus.Introspectable",
-        "Introspect");
+        });
 }
 
 inline void getPropertiesForEnumerate(
@@ -403,6 +391,493 @@ inline void getObjectAndEnumerate(
         transaction->objectPath, std::array<const char*, 0>());
 }
 
+/**
+ * @brief An enumerate that writes each object to the client as soon as it has
+ * been read, instead of building the whole tree in memory first.
+ *
+ * The body has the same shape as a regular enumerate and is sent with chunked
+ * transfer encoding.  At most maxOutstandingCalls D-Bus calls are in flight,
+ * and no new ones are made while more than maxPendingOutput bytes are waiting
+ * for the client, so memory use doesn't grow with the size of the tree.
+ * Objects implemented by more than one connection are read with GetAll, so
+ * that their properties can be merged before the object is written.
+ */
+class EnumerateStream : public std::enable_shared_from_this<EnumerateStream>
+{
+  public:
+    static constexpr size_t maxOutstandingCalls = 8;
+    static constexpr size_t maxPendingOutput = 256 * 1024;
+    static constexpr size_t maxChunkSize = 64 * 1024;
+
+    EnumerateStream(crow::streaming_response::Connection& connIn,
+                    const std::string& objectPathIn) :
+        connection(&connIn),
+        objectPath(objectPathIn)
+    {}
+
+    void start()
+    {
+        BMCWEB_LOG_DEBUG << "Doing streaming enumerate on " << objectPath;
+        crow::connections::systemBus->async_method_call(
+            [self{shared_from_this()}](const boost::system::error_code ec,
+                                       GetSubTreeType& objectNames) {
+                if (ec)
+                {
+                    BMCWEB_LOG_ERROR << "GetSubTree failed on "
+                                     << self->objectPath;
+                    if (self->connection != nullptr)
+                    {
+                        sendNotFound(*self->connection);
+                    }
+                    return;
+                }
+                self->subtree = std::move(objectNames);
+                self->getObject();
+            },
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetSubTree", objectPath, 0,
+            std::array<const char*, 0>());
+    }
+
+    // Called once the client connection is gone.  Calls already made are
+    // left to finish, but nothing more is sent.
+    void detach()
+    {
+        connection = nullptr;
+        queue.clear();
+    }
+
+    // Also used for requests that aren't an enumerate
+    static void sendNotFound(crow::streaming_response::Connection& conn)
+    {
+        nlohmann::json body = {{"data", {{"description", notFoundDesc}}},
+                               {"message", notFoundMsg},
+                               {"status", "error"}};
+        conn.sendCompleteResponse(
+            boost::beast::http::status::not_found, "application/json",
+            body.dump(2, ' ', true,
+                      nlohmann::json::error_handler_t::replace));
+    }
+
+  private:
+    // An object whose properties are read with GetAll, one call per interface
+    struct PendingObject
+    {
+        explicit PendingObject(const std::string& pathIn) : path(pathIn)
+        {}
+
+        std::string path;
+        nlohmann::json properties;
+        size_t callsLeft = 0;
+    };
+
+    // Adds the target path itself, which GetSubTree doesn't return, and
+    // starts enumerating.  See getObjectAndEnumerate().
+    void getObject()
+    {
+        using GetObjectType =
+            std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+        crow::connections::systemBus->async_method_call(
+            [self{shared_from_this()}](const boost::system::error_code ec,
+                                       const GetObjectType& objects) {
+                self->sendHeaders();
+                if (ec)
+                {
+                    BMCWEB_LOG_ERROR << "GetObject for path "
+                                     << self->objectPath
+                                     << " failed with code " << ec;
+                    self->finish();
+                    return;
+                }
+                if (!objects.empty())
+                {
+                    self->subtree.emplace_back(self->objectPath, objects);
+                }
+                self->queueObjectManagers();
+                self->pump();
+            },
+            "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/object_mapper",
+            "xyz.openbmc_project.ObjectMapper", "GetObject", objectPath,
+            std::array<const char*, 0>());
+    }
+
+    void sendHeaders()
+    {
+        if (connection == nullptr)
+        {
+            return;
+        }
+        pending = "{\"data\":{";
+        connection->sendChunkedHeaders(
+            "application/json", [self{shared_from_this()}]() {
+                self->headersSent = true;
+                self->flush();
+            });
+    }
+
+    void queueObjectManagers()
+    {
+        // Connection name, and the path of its object manager if the subtree
+        // contains it
+        boost::container::flat_map<std::string, std::string> connections;
+        for (const auto& [path, connectionMap] : subtree)
+        {
+            if (connectionMap.size() > 1)
+            {
+                sharedPaths.insert(path);
+            }
+            for (const auto& [connectionName, interfaces] : connectionMap)
+            {
+                std::string& managerPath = connections[connectionName];
+                for (const std::string& interface : interfaces)
+                {
+                    if (interface == "org.freedesktop.DBus.ObjectManager")
+                    {
+                        managerPath = path;
+                    }
+                }
+            }
+        }
+
+        BMCWEB_LOG_DEBUG << "Got " << connections.size() << " connections";
+        for (const auto& [connectionName, managerPath] : connections)
+        {
+            if (managerPath.empty())
+            {
+                queueFindObjectManager(connectionName);
+            }
+            else
+            {
+                queueManagedObjects(connectionName, managerPath);
+            }
+        }
+    }
+
+    void queueFindObjectManager(const std::string& connectionName)
+    {
+        queue.emplace_back([this, connectionName]() {
+            crow::connections::systemBus->async_method_call(
+                [self{shared_from_this()},
+                 connectionName](const boost::system::error_code ec,
+                                 const boost::container::flat_map<
+                                     std::string,
+                                     boost::container::flat_map<
+                                         std::string, std::vector<std::string>>>&
+                                     objects) {
+                    self->outstanding--;
+                    if (ec)
+                    {
+                        BMCWEB_LOG_ERROR << "GetAncestors on path "
+                                         << self->objectPath
+                                         << " failed with code " << ec;
+                    }
+                    else
+                    {
+                        self->findObjectManager(connectionName, objects);
+                    }
+                    self->pump();
+                },
+                "xyz.openbmc_project.ObjectMapper",
+                "/xyz/openbmc_project/object_mapper",
+                "xyz.openbmc_project.ObjectMapper", "GetAncestors", objectPath,
+                std::array<const char*, 1>{
+                    "org.freedesktop.DBus.ObjectManager"});
+        });
+    }
+
+    void findObjectManager(
+        const std::string& connectionName,
+        const boost::container::flat_map<
+            std::string,
+            boost::container::flat_map<std::string, std::vector<std::string>>>&
+            objects)
+    {
+        for (const auto& [path, connectionMap] : objects)
+        {
+            if (connectionMap.find(connectionName) != connectionMap.end())
+            {
+                queueManagedObjects(connectionName, path);
+                return;
+            }
+        }
+    }
+
+    void queueManagedObjects(const std::string& connectionName,
+                             const std::string& managerPath)
+    {
+        queue.emplace_back([this, connectionName, managerPath]() {
+            crow::connections::systemBus->async_method_call(
+                [self{shared_from_this()}, connectionName, managerPath](
+                    const boost::system::error_code ec,
+                    const dbus::utility::ManagedObjectType& objects) {
+                    self->outstanding--;
+                    if (ec)
+                    {
+                        BMCWEB_LOG_ERROR << "GetManagedObjects on path "
+                                         << managerPath << " on connection "
+                                         << connectionName
+                                         << " failed with code " << ec;
+                    }
+                    else
+                    {
+                        self->addManagedObjects(connectionName, managerPath,
+                                                objects);
+                    }
+                    self->pump();
+                },
+                connectionName, managerPath,
+                "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        });
+    }
+
+    void addManagedObjects(const std::string& connectionName,
+                           const std::string& managerPath,
+                           const dbus::utility::ManagedObjectType& objects)
+    {
+        for (const auto& [path, interfaces] : objects)
+        {
+            if (boost::starts_with(path.str, objectPath) &&
+                sharedPaths.find(path.str) == sharedPaths.end() &&
+                written.insert(path.str).second)
+            {
+                nlohmann::json objectJson = nlohmann::json::object();
+                for (const auto& interface : interfaces)
+                {
+                    for (const auto& [name, value] : interface.second)
+                    {
+                        nlohmann::json& propertyJson = objectJson[name];
+                        std::visit(
+                            [&propertyJson](auto&& val) { propertyJson = val; },
+                            value);
+                    }
+                }
+                writeObject(path.str, objectJson);
+            }
+
+            // Nested object managers only matter if they can hold objects
+            // below the target path
+            if (path.str == managerPath ||
+                (!boost::starts_with(path.str, objectPath) &&
+                 !boost::starts_with(objectPath, path.str)))
+            {
+                continue;
+            }
+            for (const auto& interface : interfaces)
+            {
+                if (interface.first == "org.freedesktop.DBus.ObjectManager")
+                {
+                    queueManagedObjects(connectionName, path.str);
+                }
+            }
+        }
+    }
+
+    // Queues the GetAll calls for the next object in the subtree that no
+    // object manager returned.  That can only be known once every
+    // GetManagedObjects call has finished.
+    bool queueNextRemainingObject()
+    {
+        if (!managedObjectsDone)
+        {
+            if (outstanding != 0)
+            {
+                return false;
+            }
+            managedObjectsDone = true;
+        }
+        while (nextObject < subtree.size())
+        {
+            const auto& [path, connectionMap] = subtree[nextObject++];
+            // An enumerate does not return the target path's properties
+            if (path == objectPath || written.find(path) != written.end())
+            {
+                continue;
+            }
+            auto object = std::make_shared<PendingObject>(path);
+            for (const auto& [service, interfaces] : connectionMap)
+            {
+                for (const std::string& interface : interfaces)
+                {
+                    if (!boost::starts_with(interface, "org.freedesktop.DBus"))
+                    {
+                        queueProperties(object, service, interface);
+                    }
+                }
+            }
+            if (!queue.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void queueProperties(const std::shared_ptr<PendingObject>& object,
+                         const std::string& service,
+                         const std::string& interface)
+    {
+        object->callsLeft++;
+        queue.emplace_back([this, object, service, interface]() {
+            crow::connections::systemBus->async_method_call(
+                [self{shared_from_this()}, object, service, interface](
+                    const boost::system::error_code ec,
+                    const dbus::utility::DBusPropertiesMap& propertiesList) {
+                    self->outstanding--;
+                    if (ec)
+                    {
+                        BMCWEB_LOG_ERROR << "GetAll on path " << object->path
+                                         << " iface " << interface
+                                         << " service " << service
+                                         << " failed with code " << ec;
+                    }
+                    else
+                    {
+                        if (object->properties.is_null())
+                        {
+                            object->properties = nlohmann::json::object();
+                        }
+                        for (const auto& [name, value] : propertiesList)
+                        {
+                            nlohmann::json& propertyJson =
+                                object->properties[name];
+                            std::visit([&propertyJson](
+                                           auto&& val) { propertyJson = val; },
+                                       value);
+                        }
+                    }
+                    // Objects whose calls all failed are left out, the same
+                    // as in a regular enumerate
+                    if (--object->callsLeft == 0 &&
+                        !object->properties.is_null())
+                    {
+                        self->writeObject(object->path, object->properties);
+                        object->properties = nullptr;
+                    }
+                    self->pump();
+                },
+                service, object->path, "org.freedesktop.DBus.Properties",
+                "GetAll", interface);
+        });
+    }
+
+    // Makes queued calls until one of the limits is reached, and finishes
+    // the response once there is nothing left to call
+    void pump()
+    {
+        while (connection != nullptr && outstanding < maxOutstandingCalls &&
+               pending.size() < maxPendingOutput)
+        {
+            if (queue.empty() && !queueNextRemainingObject())
+            {
+                break;
+            }
+            std::function<void()> call = std::move(queue.front());
+            queue.pop_front();
+            outstanding++;
+            call();
+        }
+        if (managedObjectsDone && outstanding == 0 && queue.empty() &&
+            nextObject >= subtree.size())
+        {
+            finish();
+        }
+    }
+
+    void writeObject(const std::string& path, const nlohmann::json& object)
+    {
+        if (!firstObject)
+        {
+            pending += ',';
+        }
+        firstObject = false;
+        pending += nlohmann::json(path).dump(
+            -1, ' ', true, nlohmann::json::error_handler_t::replace);
+        pending += ':';
+        pending += object.dump(-1, ' ', true,
+                               nlohmann::json::error_handler_t::replace);
+        flush();
+    }
+
+    void finish()
+    {
+        if (finished)
+        {
+            return;
+        }
+        finished = true;
+        pending += "},\"message\":\"200 OK\",\"status\":\"ok\"}";
+        flush();
+    }
+
+    // Sends the next chunk of pending output, unless a write is already in
+    // progress.  The connection is closed after the last chunk.
+    void flush()
+    {
+        if (connection == nullptr || !headersSent || writing)
+        {
+            return;
+        }
+        if (pending.empty())
+        {
+            if (!finished || lastChunkSent)
+            {
+                return;
+            }
+            lastChunkSent = true;
+            chunk = crow::streaming_response::makeChunk({});
+            writing = true;
+            connection->sendMessage(boost::asio::buffer(chunk),
+                                    [self{shared_from_this()}]() {
+                                        if (self->connection != nullptr)
+                                        {
+                                            self->connection->close();
+                                        }
+                                    });
+            return;
+        }
+
+        size_t size = std::min(pending.size(), maxChunkSize);
+        chunk = crow::streaming_response::makeChunk(
+            std::string_view(pending).substr(0, size));
+        pending.erase(0, size);
+        writing = true;
+        connection->sendMessage(boost::asio::buffer(chunk),
+                                [self{shared_from_this()}]() {
+                                    self->writing = false;
+                                    self->flush();
+                                    self->pump();
+                                });
+    }
+
+    crow::streaming_response::Connection* connection;
+    const std::string objectPath;
+    GetSubTreeType subtree;
+    // Objects implemented by more than one connection
+    std::unordered_set<std::string> sharedPaths;
+    // Objects already written from a GetManagedObjects reply
+    std::unordered_set<std::string> written;
+    // Calls not yet made.  They only capture this, as the queue is dropped
+    // along with the enumerate.
+    std::deque<std::function<void()>> queue;
+    size_t outstanding = 0;
+    bool managedObjectsDone = false;
+    // Index in subtree of the next object to check once the object managers
+    // are done
+    size_t nextObject = 0;
+
+    // Output not yet handed to the connection
+    std::string pending;
+    std::string chunk;
+    bool firstObject = true;
+    bool headersSent = false;
+    bool writing = false;
+    bool finished = false;
+    bool lastChunkSent = false;
+};
+
 // Structure for storing data on an in progress action
 struct InProgressActionData
 {
@@ -1314,11 +1789,11 @@ inline void findActionOnInterface(
 {
     BMCWEB_LOG_DEBUG << "findActionOnInterface for connection "
                      << connectionName;
-    crow::connections::systemBus->async_method_call(
+    dbus_introspection::Cache::getInstance().get(
+        connectionName, transaction->path,
         [transaction, connectionName{std::string(connectionName)}](
-            const boost::system::error_code ec,
-            const std::string& introspectXml) {
-            BMCWEB_LOG_DEBUG << "got xml:\n " << introspectXml;
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const dbus_introspection::Node>& node) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR
@@ -1326,153 +1801,111 @@ inline void findActionOnInterface(
                     << " on process: " << connectionName << "\n";
                 return;
             }
-            tinyxml2::XMLDocument doc;
-
-            doc.Parse(introspectXml.data(), introspectXml.size());
-            tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-            if (pRoot == nullptr)
+            if (node == nullptr)
             {
                 BMCWEB_LOG_ERROR << "XML document failed to parse "
                                  << connectionName << "\n";
                 return;
             }
-            tinyxml2::XMLElement* interfaceNode =
-                pRoot->FirstChildElement("interface");
-            while (interfaceNode != nullptr)
+            for (const dbus_introspection::Interface& interface :
+                 node->interfaces)
             {
-                const char* thisInterfaceName =
-                    interfaceNode->Attribute("name");
-                if (thisInterfaceName != nullptr)
+                if (interface.name.empty())
+                {
+                    continue;
+                }
+                if (!transaction->interfaceName.empty() &&
+                    (transaction->interfaceName != interface.name))
+                {
+                    continue;
+                }
+
+                for (const dbus_introspection::Method& method :
+                     interface.methods)
                 {
-                    if (!transaction->interfaceName.empty() &&
-                        (transaction->interfaceName != thisInterfaceName))
+                    BMCWEB_LOG_DEBUG << "Found method: " << method.name;
+                    if (method.name != transaction->methodName)
                     {
-                        interfaceNode =
-                            interfaceNode->NextSiblingElement("interface");
                         continue;
                     }
+                    BMCWEB_LOG_DEBUG << "Found method named " << method.name
+                                     << " on interface " << interface.name;
+                    sdbusplus::message::message m =
+                        crow::connections::systemBus->new_method_call(
+                            connectionName.c_str(), transaction->path.c_str(),
+                            interface.name.c_str(),
+                            transaction->methodName.c_str());
 
-                    tinyxml2::XMLElement* methodNode =
-                        interfaceNode->FirstChildElement("method");
-                    while (methodNode != nullptr)
+                    std::string returnType;
+
+                    // Find the output type
+                    for (const dbus_introspection::Arg& arg : method.args)
                     {
-                        const char* thisMethodName =
-                            methodNode->Attribute("name");
-                        BMCWEB_LOG_DEBUG << "Found method: " << thisMethodName;
-                        if (thisMethodName != nullptr &&
-                            thisMethodName == transaction->methodName)
+                        if (!arg.type.empty() && arg.direction == "out")
                         {
-                            BMCWEB_LOG_DEBUG
-                                << "Found method named " << thisMethodName
-                                << " on interface " << thisInterfaceName;
-                            sdbusplus::message::message m =
-                                crow::connections::systemBus->new_method_call(
-                                    connectionName.c_str(),
-                                    transaction->path.c_str(),
-                                    thisInterfaceName,
-                                    transaction->methodName.c_str());
-
-                            tinyxml2::XMLElement* argumentNode =
-                                methodNode->FirstChildElement("arg");
-
-                            std::string returnType;
-
-                            // Find the output type
-                            while (argumentNode != nullptr)
-                            {
-                                const char* argDirection =
-                                    argumentNode->Attribute("direction");
-                                const char* argType =
-                                    argumentNode->Attribute("type");
-                                if (argDirection != nullptr &&
-                                    argType != nullptr &&
-                                    std::string(argDirection) == "out")
-                                {
-                                    returnType = argType;
-                                    break;
-                                }
-                                argumentNode =
-                                    argumentNode->NextSiblingElement("arg");
-                            }
+                            returnType = arg.type;
+                            break;
+                        }
+                    }
 
-                            auto argIt = transaction->arguments.begin();
+                    auto argIt = transaction->arguments.begin();
 
-                            argumentNode = methodNode->FirstChildElement("arg");
+                    for (const dbus_introspection::Arg& arg : method.args)
+                    {
+                        if (arg.type.empty() || arg.direction != "in")
+                        {
+                            continue;
+                        }
+                        if (argIt == transaction->arguments.end())
+                        {
+                            transaction->setErrorStatus("Invalid method args");
+                            return;
+                        }
+                        if (convertJsonToDbus(m.get(), arg.type, *argIt) < 0)
+                        {
+                            transaction->setErrorStatus(
+                                "Invalid method arg type");
+                            return;
+                        }
+
+                        argIt++;
+                    }
 
-                            while (argumentNode != nullptr)
+                    crow::connections::systemBus->async_send(
+                        m, [transaction,
+                            returnType](boost::system::error_code ec2,
+                                        sdbusplus::message::message& m2) {
+                            if (ec2)
                             {
-                                const char* argDirection =
-                                    argumentNode->Attribute("direction");
-                                const char* argType =
-                                    argumentNode->Attribute("type");
-                                if (argDirection != nullptr &&
-                                    argType != nullptr &&
-                                    std::string(argDirection) == "in")
-                                {
-                                    if (argIt == transaction->arguments.end())
-                                    {
-                                        transaction->setErrorStatus(
-                                            "Invalid method args");
-                                        return;
-                                    }
-                                    if (convertJsonToDbus(m.get(),
-                                                          std::string(argType),
-                                                          *argIt) < 0)
-                                    {
-                                        transaction->setErrorStatus(
-                                            "Invalid method arg type");
-                                        return;
-                                    }
+                                transaction->methodFailed = true;
+                                const sd_bus_error* e = m2.get_error();
 
-                                    argIt++;
+                                if (e)
+                                {
+                                    setErrorResponse(
+                                        transaction->res,
+                                        boost::beast::http::status::
+                                            bad_request,
+                                        e->name, e->message);
+                                }
+                                else
+                                {
+                                    setErrorResponse(
+                                        transaction->res,
+                                        boost::beast::http::status::
+                                            bad_request,
+                                        "Method call failed", methodFailedMsg);
                                 }
-                                argumentNode =
-                                    argumentNode->NextSiblingElement("arg");
+                                return;
                             }
+                            transaction->methodPassed = true;
 
-                            crow::connections::systemBus->async_send(
-                                m, [transaction, returnType](
-                                       boost::system::error_code ec2,
-                                       sdbusplus::message::message& m2) {
-                                    if (ec2)
-                                    {
-                                        transaction->methodFailed = true;
-                                        const sd_bus_error* e = m2.get_error();
-
-                                        if (e)
-                                        {
-                                            setErrorResponse(
-                                                transaction->res,
-                                                boost::beast::http::status::
-                                                    bad_request,
-                                                e->name, e->message);
-                                        }
-                                        else
-                                        {
-                                            setErrorResponse(
-                                                transaction->res,
-                                                boost::beast::http::status::
-                                                    bad_request,
-                                                "Method call failed",
-                                                methodFailedMsg);
-                                        }
-                                        return;
-                                    }
-                                    transaction->methodPassed = true;
-
-                                    handleMethodResponse(transaction, m2,
-                                                         returnType);
-                                });
-                            break;
-                        }
-                        methodNode = methodNode->NextSiblingElement("method");
-                    }
+                            handleMethodResponse(transaction, m2, returnType);
+                        });
+                    break;
                 }
-                interfaceNode = interfaceNode->NextSiblingElement("interface");
             }
-        },
-        connectionName, transaction->path,
-        "org.freedesktop.DBus.Introspectable", "Introspect");
+        });
 }
 
 inline void handleAction(const crow::Request& req,
@@ -1839,10 +2272,12 @@ inline void handlePut(const crow::Request& req,
             {
                 const std::string& connectionName = connection.first;
 
-                crow::connections::systemBus->async_method_call(
+                dbus_introspection::Cache::getInstance().get(
+                    connectionName, transaction->objectPath,
                     [connectionName{std::string(connectionName)},
-                     transaction](const boost::system::error_code ec3,
-                                  const std::string& introspectXml) {
+                     transaction](const boost::system::error_code& ec3,
+                                  const std::shared_ptr<
+                                      const dbus_introspection::Node>& node) {
                         if (ec3)
                         {
                             BMCWEB_LOG_ERROR
@@ -1852,134 +2287,106 @@ inline void handlePut(const crow::Request& req,
                             transaction->setErrorStatus("Unexpected Error");
                             return;
                         }
-                        tinyxml2::XMLDocument doc;
-
-                        doc.Parse(introspectXml.c_str());
-                        tinyxml2::XMLNode* pRoot =
-                            doc.FirstChildElement("node");
-                        if (pRoot == nullptr)
+                        if (node == nullptr)
                         {
-                            BMCWEB_LOG_ERROR << "XML document failed to parse: "
-                                             << introspectXml;
+                            BMCWEB_LOG_ERROR << "XML document failed to parse "
+                                             << connectionName;
                             transaction->setErrorStatus("Unexpected Error");
                             return;
                         }
-                        tinyxml2::XMLElement* ifaceNode =
-                            pRoot->FirstChildElement("interface");
-                        while (ifaceNode != nullptr)
+                        for (const dbus_introspection::Interface& interface :
+                             node->interfaces)
                         {
-                            const char* interfaceName =
-                                ifaceNode->Attribute("name");
                             BMCWEB_LOG_DEBUG << "found interface "
-                                             << interfaceName;
-                            tinyxml2::XMLElement* propNode =
-                                ifaceNode->FirstChildElement("property");
-                            while (propNode != nullptr)
+                                             << interface.name;
+                            for (const dbus_introspection::Property& property :
+                                 interface.properties)
                             {
-                                const char* propertyName =
-                                    propNode->Attribute("name");
                                 BMCWEB_LOG_DEBUG << "Found property "
-                                                 << propertyName;
-                                if (propertyName == transaction->propertyName)
+                                                 << property.name;
+                                if (property.name !=
+                                        transaction->propertyName ||
+                                    property.type.empty())
                                 {
-                                    const char* argType =
-                                        propNode->Attribute("type");
-                                    if (argType != nullptr)
+                                    continue;
+                                }
+                                const std::string& argType = property.type;
+                                sdbusplus::message::message m =
+                                    crow::connections::systemBus
+                                        ->new_method_call(
+                                            connectionName.c_str(),
+                                            transaction->objectPath.c_str(),
+                                            "org.freedesktop.DBus."
+                                            "Properties",
+                                            "Set");
+                                m.append(interface.name,
+                                         transaction->propertyName);
+                                int r = sd_bus_message_open_container(
+                                    m.get(), SD_BUS_TYPE_VARIANT,
+                                    argType.c_str());
+                                if (r < 0)
+                                {
+                                    transaction->setErrorStatus(
+                                        "Unexpected Error");
+                                    return;
+                                }
+                                r = convertJsonToDbus(
+                                    m.get(), argType,
+                                    transaction->propertyValue);
+                                if (r < 0)
+                                {
+                                    if (r == -ERANGE)
                                     {
-                                        sdbusplus::message::message m =
-                                            crow::connections::systemBus
-                                                ->new_method_call(
-                                                    connectionName.c_str(),
-                                                    transaction->objectPath
-                                                        .c_str(),
-                                                    "org.freedesktop.DBus."
-                                                    "Properties",
-                                                    "Set");
-                                        m.append(interfaceName,
-                                                 transaction->propertyName);
-                                        int r = sd_bus_message_open_container(
-                                            m.get(), SD_BUS_TYPE_VARIANT,
-                                            argType);
-                                        if (r < 0)
-                                        {
-                                            transaction->setErrorStatus(
-                                                "Unexpected Error");
-                                            return;
-                                        }
-                                        r = convertJsonToDbus(
-                                            m.get(), argType,
-                                            transaction->propertyValue);
-                                        if (r < 0)
+                                        transaction->setErrorStatus(
+                                            "Provided property value "
+                                            "is out of range for the "
+                                            "property type");
+                                    }
+                                    else
+                                    {
+                                        transaction->setErrorStatus(
+                                            "Invalid arg type");
+                                    }
+                                    return;
+                                }
+                                r = sd_bus_message_close_container(m.get());
+                                if (r < 0)
+                                {
+                                    transaction->setErrorStatus(
+                                        "Unexpected Error");
+                                    return;
+                                }
+                                crow::connections::systemBus->async_send(
+                                    m,
+                                    [transaction](
+                                        boost::system::error_code ec,
+                                        sdbusplus::message::message& m2) {
+                                        BMCWEB_LOG_DEBUG << "sent";
+                                        if (ec)
                                         {
-                                            if (r == -ERANGE)
-                                            {
-                                                transaction->setErrorStatus(
-                                                    "Provided property value "
-                                                    "is out of range for the "
-                                                    "property type");
-                                            }
-                                            else
-                                            {
-                                                transaction->setErrorStatus(
-                                                    "Invalid arg type");
-                                            }
-                                            return;
+                                            const sd_bus_error* e =
+                                                m2.get_error();
+                                            setErrorResponse(
+                                                transaction->asyncResp->res,
+                                                boost::beast::http::status::
+                                                    forbidden,
+                                                (e) ? e->name
+                                                    : ec.category().name(),
+                                                (e) ? e->message
+                                                    : ec.message());
                                         }
-                                        r = sd_bus_message_close_container(
-                                            m.get());
-                                        if (r < 0)
+                                        else
                                         {
-                                            transaction->setErrorStatus(
-                                                "Unexpected Error");
-                                            return;
+                                            transaction->asyncResp->res
+                                                .jsonValue = {
+                                                {"status", "ok"},
+                                                {"message", "200 OK"},
+                                                {"data", nullptr}};
                                         }
-                                        crow::connections::systemBus
-                                            ->async_send(
-                                                m,
-                                                [transaction](
-                                                    boost::system::error_code
-                                                        ec,
-                                                    sdbusplus::message::message&
-                                                        m2) {
-                                                    BMCWEB_LOG_DEBUG << "sent";
-                                                    if (ec)
-                                                    {
-                                                        const sd_bus_error* e =
-                                                            m2.get_error();
-                                                        setErrorResponse(
-                                                            transaction
-                                                                ->asyncResp
-                                                                ->res,
-                                                            boost::beast::http::
-                                                                status::
-                                                                    forbidden,
-                                                            (e) ? e->name
-                                                                : ec.category()
-                                                                      .name(),
-                                                            (e) ? e->message
-                                                                : ec.message());
-                                                    }
-                                                    else
-                                                    {
-                                                        transaction->asyncResp
-                                                            ->res.jsonValue = {
-                                                            {"status", "ok"},
-                                                            {"message",
-                                                             "200 OK"},
-                                                            {"data", nullptr}};
-                                                    }
-                                                });
-                                    }
-                                }
-                                propNode =
-                                    propNode->NextSiblingElement("property");
+                                    });
                             }
-                            ifaceNode =
-                                ifaceNode->NextSiblingElement("interface");
                         }
-                    },
-                    connectionName, transaction->objectPath,
-                    "org.freedesktop.DBus.Introspectable", "Introspect");
+                    });
             }
         },
         "xyz.openbmc_project.ObjectMapper",
@@ -2064,6 +2471,10 @@ inline void handleDBusUrl(const crow::Request& req,
                      methodNotAllowedDesc, methodNotAllowedMsg);
 }
 
+static boost::container::flat_map<crow::streaming_response::Connection*,
+                                  std::shared_ptr<EnumerateStream>>
+    enumerateStreams;
+
 inline void requestRoutes(App& app)
 {
     BMCWEB_ROUTE(app, "/bus/")
@@ -2155,6 +2566,36 @@ inline void requestRoutes(App& app)
                 handleDBusUrl(req, asyncResp, objectPath);
             });
 
+    // Streaming form of <path>/enumerate, see EnumerateStream
+    BMCWEB_ROUTE(app, "/stream/<path>")
+        .privileges({{"Login"}})
+        .streamingResponse()
+        .onopen([](crow::streaming_response::Connection& conn) {
+            std::string_view target(conn.req.target());
+            target = target.substr(0, target.find('?'));
+            target.remove_prefix(std::string_view("/stream").size());
+            if (!boost::ends_with(target, "/enumerate"))
+            {
+                EnumerateStream::sendNotFound(conn);
+                return;
+            }
+            target.remove_suffix(sizeof("enumerate"));
+
+            auto stream =
+                std::make_shared<EnumerateStream>(conn, std::string(target));
+            enumerateStreams[&conn] = stream;
+            stream->start();
+        })
+        .onclose([](crow::streaming_response::Connection& conn) {
+            auto stream = enumerateStreams.find(&conn);
+            if (stream == enumerateStreams.end())
+            {
+                return;
+            }
+            stream->second->detach();
+            enumerateStreams.erase(stream);
+        });
+
     BMCWEB_ROUTE(app, "/download/dump/<str>/")
         .privileges({{"ConfigureManager"}})
         .methods(boost::beast::http::verb::get)(
@@ -2294,10 +2735,12 @@ inline void requestRoutes(App& app)
                 }
                 if (interfaceName.empty())
                 {
-                    crow::connections::systemBus->async_method_call(
-                        [asyncResp, processName,
-                         objectPath](const boost::system::error_code ec,
-                                     const std::string& introspectXml) {
+                    dbus_introspection::Cache::getInstance().get(
+                        processName, objectPath,
+                        [asyncResp, processName, objectPath](
+                            const boost::system::error_code& ec,
+                            const std::shared_ptr<
+                                const dbus_introspection::Node>& node) {
                             if (ec)
                             {
                                 BMCWEB_LOG_ERROR
@@ -2307,12 +2750,7 @@ inline void requestRoutes(App& app)
                                     << " path: " << objectPath << "\n";
                                 return;
                             }
-                            tinyxml2::XMLDocument doc;
-
-                            doc.Parse(introspectXml.c_str());
-                            tinyxml2::XMLNode* pRoot =
-                                doc.FirstChildElement("node");
-                            if (pRoot == nullptr)
+                            if (node == nullptr)
                             {
                                 BMCWEB_LOG_ERROR
                                     << "XML document failed to parse "
@@ -2325,7 +2763,6 @@ inline void requestRoutes(App& app)
                                 return;
                             }
 
-                            BMCWEB_LOG_DEBUG << introspectXml;
                             asyncResp->res.jsonValue = {
                                 {"status", "ok"},
                                 {"bus_name", processName},
@@ -2333,32 +2770,25 @@ inline void requestRoutes(App& app)
                             nlohmann::json& interfacesArray =
                                 asyncResp->res.jsonValue["interfaces"];
                             interfacesArray = nlohmann::json::array();
-                            tinyxml2::XMLElement* interface =
-                                pRoot->FirstChildElement("interface");
-
-                            while (interface != nullptr)
+                            for (const dbus_introspection::Interface&
+                                     interface : node->interfaces)
                             {
-                                const char* ifaceName =
-                                    interface->Attribute("name");
-                                if (ifaceName != nullptr)
+                                if (!interface.name.empty())
                                 {
                                     interfacesArray.push_back(
-                                        {{"name", ifaceName}});
+                                        {{"name", interface.name}});
                                 }
-
-                                interface =
-                                    interface->NextSiblingElement("interface");
                             }
-                        },
-                        processName, objectPath,
-                        "org.freedesktop.DBus.Introspectable", "Introspect");
+                        });
                 }
                 else if (methodName.empty())
                 {
-                    crow::connections::systemBus->async_method_call(
-                        [asyncResp, processName, objectPath,
-                         interfaceName](const boost::system::error_code ec,
-                                        const std::string& introspectXml) {
+                    dbus_introspection::Cache::getInstance().get(
+                        processName, objectPath,
+                        [asyncResp, processName, objectPath, interfaceName](
+                            const boost::system::error_code& ec,
+                            const std::shared_ptr<
+                                const dbus_introspection::Node>& node) {
                             if (ec)
                             {
                                 BMCWEB_LOG_ERROR
@@ -2368,13 +2798,7 @@ inline void requestRoutes(App& app)
                                     << " path: " << objectPath << "\n";
                                 return;
                             }
-                            tinyxml2::XMLDocument doc;
-
-                            doc.Parse(introspectXml.data(),
-                                      introspectXml.size());
-                            tinyxml2::XMLNode* pRoot =
-                                doc.FirstChildElement("node");
-                            if (pRoot == nullptr)
+                            if (node == nullptr)
                             {
                                 BMCWEB_LOG_ERROR
                                     << "XML document failed to parse "
@@ -2402,24 +2826,8 @@ inline void requestRoutes(App& app)
                                 asyncResp->res.jsonValue["properties"];
                             propertiesObj = nlohmann::json::object();
 
-                            // if we know we're the only call, build the
-                            // json directly
-                            tinyxml2::XMLElement* interface =
-                                pRoot->FirstChildElement("interface");
-                            while (interface != nullptr)
-                            {
-                                const char* ifaceName =
-                                    interface->Attribute("name");
-
-                                if (ifaceName != nullptr &&
-                                    ifaceName == interfaceName)
-                                {
-                                    break;
-                                }
-
-                                interface =
-                                    interface->NextSiblingElement("interface");
-                            }
+                            const dbus_introspection::Interface* interface =
+                                node->findInterface(interfaceName);
                             if (interface == nullptr)
                             {
                                 // if we got to the end of the list and
@@ -2429,126 +2837,108 @@ inline void requestRoutes(App& app)
                                 return;
                             }
 
-                            tinyxml2::XMLElement* methods =
-                                interface->FirstChildElement("method");
-                            while (methods != nullptr)
+                            for (const dbus_introspection::Method& method :
+                                 interface->methods)
                             {
                                 nlohmann::json argsArray =
                                     nlohmann::json::array();
-                                tinyxml2::XMLElement* arg =
-                                    methods->FirstChildElement("arg");
-                                while (arg != nullptr)
+                                for (const dbus_introspection::Arg& arg :
+                                     method.args)
                                 {
                                     nlohmann::json thisArg;
-                                    for (const char* fieldName :
-                                         std::array<const char*, 3>{
-                                             "name", "direction", "type"})
+                                    if (!arg.name.empty())
                                     {
-                                        const char* fieldValue =
-                                            arg->Attribute(fieldName);
-                                        if (fieldValue != nullptr)
-                                        {
-                                            thisArg[fieldName] = fieldValue;
-                                        }
+                                        thisArg["name"] = arg.name;
+                                    }
+                                    if (!arg.direction.empty())
+                                    {
+                                        thisArg["direction"] = arg.direction;
+                                    }
+                                    if (!arg.type.empty())
+                                    {
+                                        thisArg["type"] = arg.type;
                                     }
                                     argsArray.push_back(std::move(thisArg));
-                                    arg = arg->NextSiblingElement("arg");
                                 }
 
-                                const char* name = methods->Attribute("name");
-                                if (name != nullptr)
+                                if (!method.name.empty())
                                 {
                                     std::string uri;
                                     uri.reserve(14 + processName.size() +
                                                 objectPath.size() +
                                                 interfaceName.size() +
-                                                strlen(name));
+                                                method.name.size());
                                     uri += "/bus/system/";
                                     uri += processName;
                                     uri += objectPath;
                                     uri += "/";
                                     uri += interfaceName;
                                     uri += "/";
-                                    uri += name;
+                                    uri += method.name;
                                     methodsArray.push_back(
-                                        {{"name", name},
+                                        {{"name", method.name},
                                          {"uri", std::move(uri)},
                                          {"args", argsArray}});
                                 }
-                                methods = methods->NextSiblingElement("method");
                             }
-                            tinyxml2::XMLElement* signals =
-                                interface->FirstChildElement("signal");
-                            while (signals != nullptr)
+                            for (const dbus_introspection::Signal& signal :
+                                 interface->signals)
                             {
                                 nlohmann::json argsArray =
                                     nlohmann::json::array();
 
-                                tinyxml2::XMLElement* arg =
-                                    signals->FirstChildElement("arg");
-                                while (arg != nullptr)
+                                for (const dbus_introspection::Arg& arg :
+                                     signal.args)
                                 {
-                                    const char* name = arg->Attribute("name");
-                                    const char* type = arg->Attribute("type");
-                                    if (name != nullptr && type != nullptr)
+                                    if (!arg.name.empty() && !arg.type.empty())
                                     {
                                         argsArray.push_back({
-                                            {"name", name},
-                                            {"type", type},
+                                            {"name", arg.name},
+                                            {"type", arg.type},
                                         });
                                     }
-                                    arg = arg->NextSiblingElement("arg");
                                 }
-                                const char* name = signals->Attribute("name");
-                                if (name != nullptr)
+                                if (!signal.name.empty())
                                 {
                                     signalsArray.push_back(
-                                        {{"name", name}, {"args", argsArray}});
+                                        {{"name", signal.name},
+                                         {"args", argsArray}});
                                 }
-
-                                signals = signals->NextSiblingElement("signal");
                             }
 
-                            tinyxml2::XMLElement* property =
-                                interface->FirstChildElement("property");
-                            while (property != nullptr)
+                            for (const dbus_introspection::Property& property :
+                                 interface->properties)
                             {
-                                const char* name = property->Attribute("name");
-                                const char* type = property->Attribute("type");
-                                if (type != nullptr && name != nullptr)
+                                if (property.type.empty() ||
+                                    property.name.empty())
                                 {
-                                    sdbusplus::message::message m =
-                                        crow::connections::systemBus
-                                            ->new_method_call(
-                                                processName.c_str(),
-                                                objectPath.c_str(),
-                                                "org.freedesktop."
-                                                "DBus."
-                                                "Properties",
-                                                "Get");
-                                    m.append(interfaceName, name);
-                                    nlohmann::json& propertyItem =
-                                        propertiesObj[name];
-                                    crow::connections::systemBus->async_send(
-                                        m,
-                                        [&propertyItem, asyncResp](
-                                            boost::system::error_code& e,
-                                            sdbusplus::message::message& msg) {
-                                            if (e)
-                                            {
-                                                return;
-                                            }
-
-                                            convertDBusToJSON("v", msg,
-                                                              propertyItem);
-                                        });
+                                    continue;
                                 }
-                                property =
-                                    property->NextSiblingElement("property");
+                                sdbusplus::message::message m =
+                                    crow::connections::systemBus
+                                        ->new_method_call(processName.c_str(),
+                                                          objectPath.c_str(),
+                                                          "org.freedesktop."
+                                                          "DBus."
+                                                          "Properties",
+                                                          "Get");
+                                m.append(interfaceName, property.name);
+                                nlohmann::json& propertyItem =
+                                    propertiesObj[property.name];
+                                crow::connections::systemBus->async_send(
+                                    m, [&propertyItem, asyncResp](
+                                           boost::system::error_code& e,
+                                           sdbusplus::message::message& msg) {
+                                        if (e)
+                                        {
+                                            return;
+                                        }
+
+                                        convertDBusToJSON("v", msg,
+                                                          propertyItem);
+                                    });
                             }
-                        },
-                        processName, objectPath,
-                        "org.freedesktop.DBus.Introspectable", "Introspect");
+                        });
                 }
                 else
                 {
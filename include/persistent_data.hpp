@@ -1,6 +1,11 @@
 #pragma once
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <app.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/http/fields.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/uuid/uuid.hpp>
@@ -12,9 +17,12 @@
 #include <nlohmann/json.hpp>
 #include <pam_authenticate.hpp>
 #include <sessions.hpp>
+#include <worker_pool.hpp>
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <random>
 
 namespace persistent_data
@@ -34,11 +42,46 @@ class ConfigFile
     }
 
     ~ConfigFile()
+    {
+        flush(true);
+    }
+
+    // Writes are coalesced: changes only mark the stores dirty, and a single
+    // snapshot is written at most once per flushInterval.  Until the flush
+    // timer has been started, scheduled writes happen immediately.
+    void startFlushTimer(boost::asio::io_context& io)
+    {
+        flushTimer.emplace(io);
+        armFlushTimer();
+    }
+
+    // Must be called before the io_context the timer was started on goes away
+    void stopFlushTimer()
+    {
+        flushTimer.reset();
+        flush(true);
+    }
+
+    void scheduleWrite()
+    {
+        writeRequested = true;
+        if (!flushTimer)
+        {
+            flush();
+        }
+    }
+
+    // Writes the file if persisted state has changed since the last write.
+    // Sessions that only timed out are dropped from the file at shutdown, or
+    // with the next change.
+    void flush(bool shuttingDown = false)
     {
         // Make sure we aren't writing stale sessions
-        persistent_data::SessionStore::getInstance().applySessionTimeouts();
-        if ((persistent_data::SessionStore::getInstance().needsWrite()) ||
-            (persistent_data::EventServiceStore::getInstance().needsWrite()))
+        SessionStore& sessions = SessionStore::getInstance();
+        sessions.applySessionTimeouts();
+        if (writeRequested || sessions.needsWrite() ||
+            (shuttingDown && sessions.hasExpiredSessions()) ||
+            EventServiceStore::getInstance().needsWrite())
         {
             writeData();
         }
@@ -112,8 +155,8 @@ class ConfigFile
                                 << "Restored session: " << newSession->csrfToken
                                 << " " << newSession->uniqueId << " "
                                 << newSession->sessionToken;
-                            SessionStore::getInstance().authTokens.emplace(
-                                newSession->sessionToken, newSession);
+                            SessionStore::getInstance().addSession(
+                                newSession);
                         }
                     }
                     else if (item.key() == "timeout")
@@ -193,33 +236,39 @@ class ConfigFile
 
     void writeData()
     {
-        std::ofstream persistentFile(filename);
+        // With several bmcweb processes, the coordinator owns the file
+        if (crow::workers::isWorker())
+        {
+            return;
+        }
+        // Write the snapshot to a temporary file and rename it into place, so
+        // a crash or power loss mid-write never leaves a truncated file
+        std::string tempFilename = std::string(filename) + ".tmp";
+        std::ofstream persistentFile(tempFilename, std::ios::trunc);
+        if (!persistentFile.is_open())
+        {
+            BMCWEB_LOG_ERROR << "Failed to open " << tempFilename;
+            return;
+        }
 
         // set the permission of the file to 640
         std::filesystem::perms permission =
             std::filesystem::perms::owner_read |
             std::filesystem::perms::owner_write |
             std::filesystem::perms::group_read;
-        std::filesystem::permissions(filename, permission);
+        std::error_code ec;
+        std::filesystem::permissions(tempFilename, permission, ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to set permissions on " << tempFilename
+                             << ": " << ec.message();
+        }
         const auto& c = SessionStore::getInstance().getAuthMethodsConfig();
         const auto& eventServiceConfig =
             EventServiceStore::getInstance().getEventServiceConfig();
         nlohmann::json data{
-            {"auth_config",
-             {{"XToken", c.xtoken},
-              {"Cookie", c.cookie},
-              {"SessionToken", c.sessionToken},
-              {"BasicAuth", c.basic},
-              {"TLS", c.tls}}
-
-            },
-            {"eventservice_config",
-             {{"ServiceEnabled", eventServiceConfig.enabled},
-              {"DeliveryRetryAttempts", eventServiceConfig.retryAttempts},
-              {"DeliveryRetryIntervalSeconds",
-               eventServiceConfig.retryTimeoutInterval}}
-
-            },
+            {"auth_config", c.toJson()},
+            {"eventservice_config", eventServiceConfig.toJson()},
             {"system_uuid", systemUuid},
             {"revision", jsonRevision},
             {"timeout", SessionStore::getInstance().getTimeoutInSeconds()}};
@@ -231,16 +280,7 @@ class ConfigFile
             if (p.second->persistence !=
                 persistent_data::PersistenceType::SINGLE_REQUEST)
             {
-                sessions.push_back({
-                    {"unique_id", p.second->uniqueId},
-                    {"session_token", p.second->sessionToken},
-                    {"username", p.second->username},
-                    {"csrf_token", p.second->csrfToken},
-                    {"client_ip", p.second->clientIp},
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                    {"client_id", p.second->clientId},
-#endif
-                });
+                sessions.push_back(p.second->toJson());
             }
         }
         nlohmann::json& subscriptions = data["subscriptions"];
@@ -255,37 +295,78 @@ class ConfigFile
                     << "The subscription type is SSE, so skipping.";
                 continue;
             }
-            nlohmann::json::object_t headers;
-            for (const boost::beast::http::fields::value_type& header :
-                 subValue->httpHeaders)
-            {
-                // Note, these are technically copies because nlohmann doesn't
-                // support key lookup by std::string_view.  At least the
-                // following code can use move
-                // https://github.com/nlohmann/json/issues/1529
-                std::string name(header.name_string());
-                headers[std::move(name)] = header.value();
-            }
-
-            subscriptions.push_back({
-                {"Id", subValue->id},
-                {"Context", subValue->customText},
-                {"DeliveryRetryPolicy", subValue->retryPolicy},
-                {"Destination", subValue->destinationUrl},
-                {"EventFormatType", subValue->eventFormatType},
-                {"HttpHeaders", std::move(headers)},
-                {"MessageIds", subValue->registryMsgIds},
-                {"Protocol", subValue->protocol},
-                {"RegistryPrefixes", subValue->registryPrefixes},
-                {"ResourceTypes", subValue->resourceTypes},
-                {"SubscriptionType", subValue->subscriptionType},
-                {"MetricReportDefinitions", subValue->metricReportDefinitions},
-            });
+            subscriptions.push_back(subValue->toJson());
         }
         persistentFile << data;
+        persistentFile.close();
+        if (persistentFile.fail())
+        {
+            BMCWEB_LOG_ERROR << "Failed to write " << tempFilename;
+            std::filesystem::remove(tempFilename, ec);
+            return;
+        }
+        // The data has to be on disk before the rename, otherwise a power
+        // loss can leave the new name pointing at an empty file
+        if (!syncToDisk(tempFilename))
+        {
+            BMCWEB_LOG_ERROR << "Failed to sync " << tempFilename;
+            std::filesystem::remove(tempFilename, ec);
+            return;
+        }
+        std::filesystem::rename(tempFilename, filename, ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR << "Failed to replace " << filename << ": "
+                             << ec.message();
+            std::filesystem::remove(tempFilename, ec);
+            return;
+        }
+        // And the rename itself lives in the directory
+        std::filesystem::path dir =
+            std::filesystem::path(filename).parent_path();
+        if (!syncToDisk(dir.empty() ? "." : dir.string()))
+        {
+            BMCWEB_LOG_ERROR << "Failed to sync the directory of " << filename;
+        }
+
+        writeRequested = false;
+        SessionStore::getInstance().needWrite = false;
+        SessionStore::getInstance().expiredSinceWrite = false;
+        EventServiceStore::getInstance().needWrite = false;
     }
 
     std::string systemUuid{""};
+
+  private:
+    static bool syncToDisk(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+        int ret = ::fsync(fd);
+        ::close(fd);
+        return ret == 0;
+    }
+
+    static constexpr std::chrono::seconds flushInterval{5};
+
+    void armFlushTimer()
+    {
+        flushTimer->expires_after(flushInterval);
+        flushTimer->async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            flush();
+            armFlushTimer();
+        });
+    }
+
+    bool writeRequested = false;
+    std::optional<boost::asio::steady_timer> flushTimer;
 };
 
 inline ConfigFile& getConfig()
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "http_response.hpp"
+#include "http_utility.hpp"
+#include "logging.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/fields.hpp>
+#include <boost/beast/http/status.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <optional>
+#include <string>
+
+namespace crow
+{
+namespace ranged_download
+{
+
+// The headers that decide which part of a download is sent.  They are
+// copied out of the request because downloads are usually answered from a
+// D-Bus callback, after the request itself is gone.
+struct RangeHeaders
+{
+    RangeHeaders() = default;
+
+    explicit RangeHeaders(const boost::beast::http::fields& fields) :
+        range(fields[boost::beast::http::field::range]),
+        ifRange(fields[boost::beast::http::field::if_range])
+    {}
+
+    std::string range;
+    std::string ifRange;
+};
+
+// Strong validator for a file that is never modified in place
+inline std::string makeFileEtag(const struct stat& st)
+{
+    std::array<char, 48> buf{};
+    std::snprintf(buf.data(), buf.size(), "\"%llx-%llx\"",
+                  static_cast<unsigned long long>(st.st_size),
+                  static_cast<unsigned long long>(st.st_mtime));
+    return {buf.data()};
+}
+
+/**
+ * @brief Picks the part of a representation of size bytes to send, and sets
+ * the status and range headers on res accordingly.  res is either a
+ * crow::Response or the DynamicResponse of a streaming connection.
+ *
+ * A Range is only honoured when If-Range is absent or matches etag, so a
+ * client resuming a download never gets pieces of two different files.
+ *
+ * @return The range to send, or std::nullopt when the range can't be
+ * satisfied and res already holds a 416.
+ */
+template <typename ResponseType>
+inline std::optional<http_helpers::ByteRange>
+    selectRange(const RangeHeaders& headers, ResponseType& res,
+                uint64_t size, const std::string& etag)
+{
+    res.addHeader(boost::beast::http::field::accept_ranges, "bytes");
+    if (!etag.empty())
+    {
+        res.addHeader(boost::beast::http::field::etag, etag);
+    }
+
+    http_helpers::ByteRange range{0, size};
+    if (headers.range.empty() ||
+        (!headers.ifRange.empty() && headers.ifRange != etag))
+    {
+        return range;
+    }
+
+    switch (http_helpers::parseRange(headers.range, size, range))
+    {
+        case http_helpers::RangeStatus::None:
+            return http_helpers::ByteRange{0, size};
+        case http_helpers::RangeStatus::Unsatisfiable:
+            BMCWEB_LOG_DEBUG << "Range " << headers.range
+                             << " not satisfiable for " << size << " bytes";
+            res.result(boost::beast::http::status::range_not_satisfiable);
+            res.addHeader(boost::beast::http::field::content_range,
+                          "bytes */" + std::to_string(size));
+            return std::nullopt;
+        case http_helpers::RangeStatus::Satisfiable:
+            break;
+    }
+    res.result(boost::beast::http::status::partial_content);
+    res.addHeader(boost::beast::http::field::content_range,
+                  "bytes " + std::to_string(range.offset) + "-" +
+                      std::to_string(range.offset + range.length - 1) + "/" +
+                      std::to_string(size));
+    return range;
+}
+
+/**
+ * @brief Fills res with the requested part of the file open on fd, reading
+ * only that part.  The file offset of fd is left alone.
+ *
+ * @return false on a read error; res is left for the caller to fail.
+ */
+inline bool sendFile(const RangeHeaders& headers, crow::Response& res, int fd)
+{
+    struct stat st
+    {};
+    if (fstat(fd, &st) != 0 || st.st_size < 0)
+    {
+        BMCWEB_LOG_ERROR << "fstat failed: " << errno;
+        return false;
+    }
+
+    std::optional<http_helpers::ByteRange> range =
+        selectRange(headers, res, static_cast<uint64_t>(st.st_size),
+                    makeFileEtag(st));
+    if (!range)
+    {
+        return true;
+    }
+
+    std::string& body = res.body();
+    body.resize(static_cast<size_t>(range->length));
+    size_t done = 0;
+    while (done < body.size())
+    {
+        ssize_t rc = pread(fd, body.data() + done, body.size() - done,
+                           static_cast<off_t>(range->offset + done));
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc <= 0)
+        {
+            BMCWEB_LOG_ERROR << "pread failed at " << range->offset + done
+                             << ": " << errno;
+            body.clear();
+            return false;
+        }
+        done += static_cast<size_t>(rc);
+    }
+    return true;
+}
+
+// Fills res with the requested part of a representation already in memory
+inline void sendBody(const RangeHeaders& headers, crow::Response& res,
+                     std::string&& body, const std::string& etag)
+{
+    std::optional<http_helpers::ByteRange> range =
+        selectRange(headers, res, body.size(), etag);
+    if (!range)
+    {
+        return;
+    }
+    if (range->offset != 0 || range->length != body.size())
+    {
+        body = body.substr(static_cast<size_t>(range->offset),
+                           static_cast<size_t>(range->length));
+    }
+    res.body() = std::move(body);
+}
+
+} // namespace ranged_download
+} // namespace crow
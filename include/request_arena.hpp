@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace crow
+{
+
+/**
+ * @brief Bump allocator for the short lived allocations of one request.
+ *
+ * Memory comes from chunks of chunkSize bytes that are kept until the arena
+ * goes away.  Freeing the block allocated last gives its space back right
+ * away, and once nothing is allocated the arena starts over from its first
+ * chunk, so the nested and one after the other coroutine frames of a handler
+ * keep reusing the same few kilobytes.  Blocks larger than a chunk come from
+ * the heap.
+ */
+class RequestArena
+{
+  public:
+    static constexpr size_t chunkSize = 4096;
+    static constexpr size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    RequestArena() = default;
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+    RequestArena(RequestArena&&) = delete;
+    RequestArena& operator=(RequestArena&&) = delete;
+
+    ~RequestArena() = default;
+
+    void* allocate(size_t size)
+    {
+        size = roundUp(size);
+        if (size > chunkSize)
+        {
+            return ::operator new(size);
+        }
+        outstanding++;
+        if (chunks.empty() || used + size > chunkSize)
+        {
+            if (!chunks.empty())
+            {
+                current++;
+            }
+            if (current == chunks.size())
+            {
+                chunks.emplace_back(new std::byte[chunkSize]);
+            }
+            used = 0;
+        }
+        void* block = chunks[current].get() + used;
+        used += size;
+        return block;
+    }
+
+    void deallocate(void* block, size_t size)
+    {
+        size = roundUp(size);
+        if (size > chunkSize)
+        {
+            ::operator delete(block);
+            return;
+        }
+        outstanding--;
+        if (outstanding == 0)
+        {
+            current = 0;
+            used = 0;
+            return;
+        }
+        if (static_cast<std::byte*>(block) + size ==
+            chunks[current].get() + used)
+        {
+            used -= size;
+        }
+    }
+
+    size_t chunkCount() const
+    {
+        return chunks.size();
+    }
+
+  private:
+    static size_t roundUp(size_t size)
+    {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    // Chunk allocations currently come from, and how much of it is used
+    size_t current = 0;
+    size_t used = 0;
+    size_t outstanding = 0;
+};
+
+} // namespace crow
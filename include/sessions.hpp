@@ -3,6 +3,7 @@
 #include "logging.hpp"
 #include "random.hpp"
 #include "utility.hpp"
+#include "worker_pool.hpp"
 
 #include <openssl/rand.h>
 
@@ -17,6 +18,7 @@
 #include <sdbusplus/bus/match.hpp>
 
 #include <csignal>
+#include <list>
 #include <random>
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
 #include <ibm/locks.hpp>
@@ -30,6 +32,9 @@ namespace persistent_data
 // https://cheatsheetseries.owasp.org/cheatsheets/Session_Management_Cheat_Sheet.html#session-id-entropy
 constexpr std::size_t sessionTokenSize = 20;
 
+// Upper bound on the number of persistent sessions a single user may hold
+constexpr std::size_t maxSessionsPerUser = 64;
+
 enum class PersistenceType
 {
     TIMEOUT, // User session times out after a predetermined amount of time
@@ -48,6 +53,8 @@ struct UserSession
     PersistenceType persistence;
     bool cookieAuth = false;
     bool isConfigureSelfOnly = false;
+    // When the other bmcweb processes were last told the session was used
+    std::chrono::time_point<std::chrono::steady_clock> lastPublished;
 
     // There are two sources of truth for isConfigureSelfOnly:
     //  1. When pamAuthenticateUser() returns PAM_NEW_AUTHTOK_REQD.
@@ -135,10 +142,25 @@ struct UserSession
         // the tradeoffs of all the corner cases involved are non-trivial, so
         // this is done temporarily
         userSession->lastUpdated = std::chrono::steady_clock::now();
+        userSession->lastPublished = userSession->lastUpdated;
         userSession->persistence = PersistenceType::TIMEOUT;
 
         return userSession;
     }
+
+    nlohmann::json toJson() const
+    {
+        return {
+            {"unique_id", uniqueId},
+            {"session_token", sessionToken},
+            {"username", username},
+            {"csrf_token", csrfToken},
+            {"client_ip", clientIp},
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+            {"client_id", clientId},
+#endif
+        };
+    }
 };
 
 struct AuthConfigMethods
@@ -205,6 +227,15 @@ struct AuthConfigMethods
             }
         }
     }
+
+    nlohmann::json toJson() const
+    {
+        return {{"XToken", xtoken},
+                {"Cookie", cookie},
+                {"SessionToken", sessionToken},
+                {"BasicAuth", basic},
+                {"TLS", tls}};
+    }
 };
 
 class SessionStore
@@ -261,15 +292,47 @@ class SessionStore
                 return nullptr;
             }
         }
-        auto session = std::make_shared<UserSession>(
-            UserSession{uniqueId, sessionToken, std::string(username),
-                        csrfToken, std::string(clientId), std::string(clientIp),
-                        std::chrono::steady_clock::now(), persistence, false,
-                        isConfigureSelfOnly});
-        auto it = authTokens.emplace(std::make_pair(sessionToken, session));
+        auto now = std::chrono::steady_clock::now();
+        auto session = std::make_shared<UserSession>(UserSession{
+            uniqueId, sessionToken, std::string(username), csrfToken,
+            std::string(clientId), std::string(clientIp), now, persistence,
+            false, isConfigureSelfOnly, now});
+        if (!addSession(session))
+        {
+            return nullptr;
+        }
         // Only need to write to disk if session isn't about to be destroyed.
         needWrite = persistence == PersistenceType::TIMEOUT;
-        return it.first->second;
+
+        if (persistence == PersistenceType::TIMEOUT)
+        {
+            publish("add", {{"session", session->toJson()}});
+            enforceUserSessionLimit(session->username);
+        }
+        return session;
+    }
+
+    // Inserts a session into the token, unique id and user indexes.  Returns
+    // false if either the token or the unique id is already in use.
+    bool addSession(const std::shared_ptr<UserSession>& session)
+    {
+        if (sessionsByUid.find(session->uniqueId) != sessionsByUid.end())
+        {
+            return false;
+        }
+        auto it = authTokens.emplace(session->sessionToken, session);
+        if (!it.second)
+        {
+            return false;
+        }
+        SessionIndexEntry& entry = sessionsByUid[session->uniqueId];
+        entry.session = session;
+        entry.idleIt = idleOrder.insert(idleOrder.end(), session.get());
+        std::list<UserSession*>& userSessions =
+            sessionsByUser[session->username];
+        entry.userIdleIt =
+            userSessions.insert(userSessions.end(), session.get());
+        return true;
     }
 
     std::shared_ptr<UserSession>
@@ -287,32 +350,50 @@ class SessionStore
         }
         std::shared_ptr<UserSession> userSession = sessionIt->second;
         userSession->lastUpdated = std::chrono::steady_clock::now();
+        markRecentlyUsed(*userSession);
+        if (userSession->lastUpdated - userSession->lastPublished >=
+            timeoutInSeconds / 8)
+        {
+            userSession->lastPublished = userSession->lastUpdated;
+            publish("touch", {{"id", userSession->uniqueId}});
+        }
         return userSession;
     }
 
     std::shared_ptr<UserSession> getSessionByUid(const std::string_view uid)
     {
         applySessionTimeouts();
-        // TODO(Ed) this is inefficient
-        auto sessionIt = authTokens.begin();
-        while (sessionIt != authTokens.end())
+        auto sessionIt = sessionsByUid.find(std::string(uid));
+        if (sessionIt == sessionsByUid.end())
         {
-            if (sessionIt->second->uniqueId == uid)
-            {
-                return sessionIt->second;
-            }
-            sessionIt++;
+            return nullptr;
         }
-        return nullptr;
+        return sessionIt->second.session;
     }
 
     void removeSession(const std::shared_ptr<UserSession>& session)
     {
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-        crow::ibm_mc_lock::Lock::getInstance().releaseLock(session->uniqueId);
-#endif
-        authTokens.erase(session->sessionToken);
-        needWrite = true;
+        auto sessionIt = sessionsByUid.find(session->uniqueId);
+        if (sessionIt == sessionsByUid.end() ||
+            sessionIt->second.session != session)
+        {
+            return;
+        }
+        if (session->persistence == PersistenceType::TIMEOUT)
+        {
+            publish("remove", {{"id", session->uniqueId}});
+        }
+        eraseSession(sessionIt);
+    }
+
+    size_t getUserSessionCount(const std::string& username) const
+    {
+        auto userIt = sessionsByUser.find(username);
+        if (userIt == sessionsByUser.end())
+        {
+            return 0;
+        }
+        return userIt->second.size();
     }
 
     std::vector<const std::string*> getUniqueIds(
@@ -322,12 +403,12 @@ class SessionStore
         applySessionTimeouts();
 
         std::vector<const std::string*> ret;
-        ret.reserve(authTokens.size());
-        for (auto& session : authTokens)
+        ret.reserve(sessionsByUid.size());
+        for (auto& session : sessionsByUid)
         {
-            if (getAll || type == session.second->persistence)
+            if (getAll || type == session.second.session->persistence)
             {
-                ret.push_back(&session.second->uniqueId);
+                ret.push_back(&session.first);
             }
         }
         return ret;
@@ -335,14 +416,8 @@ class SessionStore
 
     void updateAuthMethodsConfig(const AuthConfigMethods& config)
     {
-        bool isTLSchanged = (authMethodsConfig.tls != config.tls);
-        authMethodsConfig = config;
-        needWrite = true;
-        if (isTLSchanged)
-        {
-            // recreate socket connections with new settings
-            std::raise(SIGHUP);
-        }
+        publish("auth_config", {{"config", config.toJson()}});
+        setAuthMethodsConfig(config);
     }
 
     AuthConfigMethods& getAuthMethodsConfig()
@@ -363,6 +438,80 @@ class SessionStore
     {
         timeoutInSeconds = newTimeoutInSeconds;
         needWrite = true;
+        publish("timeout", {{"seconds", newTimeoutInSeconds.count()}});
+    }
+
+    // Makes a change published by another bmcweb process, see
+    // worker_pool.hpp
+    void applyChange(const nlohmann::json& change)
+    {
+        std::string op = change.value("op", "");
+        if (op == "add")
+        {
+            auto sessionJson = change.find("session");
+            if (sessionJson == change.end())
+            {
+                return;
+            }
+            std::shared_ptr<UserSession> session =
+                UserSession::fromJson(*sessionJson);
+            if (session != nullptr && addSession(session))
+            {
+                needWrite = true;
+                enforceUserSessionLimit(session->username);
+            }
+        }
+        else if (op == "remove" || op == "touch")
+        {
+            auto sessionIt = sessionsByUid.find(change.value("id", ""));
+            if (sessionIt == sessionsByUid.end())
+            {
+                return;
+            }
+            if (op == "remove")
+            {
+                eraseSession(sessionIt);
+                return;
+            }
+            UserSession& session = *sessionIt->second.session;
+            session.lastUpdated = std::chrono::steady_clock::now();
+            session.lastPublished = session.lastUpdated;
+            markRecentlyUsed(session);
+        }
+        else if (op == "auth_config")
+        {
+            AuthConfigMethods config = authMethodsConfig;
+            config.fromJson(change.value("config", nlohmann::json::object()));
+            setAuthMethodsConfig(config);
+        }
+        else if (op == "timeout")
+        {
+            updateSessionTimeout(std::chrono::seconds(
+                change.value("seconds", timeoutInSeconds.count())));
+        }
+        else if (op == "sync")
+        {
+            applySync(change);
+        }
+    }
+
+    // The whole store, to bring a new worker process up to date
+    nlohmann::json snapshot()
+    {
+        applySessionTimeouts();
+        nlohmann::json::array_t sessions;
+        for (const auto& entry : sessionsByUid)
+        {
+            if (entry.second.session->persistence == PersistenceType::TIMEOUT)
+            {
+                sessions.emplace_back(entry.second.session->toJson());
+            }
+        }
+        return {{"type", "session"},
+                {"op", "sync"},
+                {"sessions", std::move(sessions)},
+                {"timeout", timeoutInSeconds.count()},
+                {"auth_config", authMethodsConfig.toJson()}};
     }
 
     static SessionStore& getInstance()
@@ -371,34 +520,30 @@ class SessionStore
         return sessionStore;
     }
 
+    // Sessions are kept in least recently used order, so expiring them only
+    // ever looks at the sessions that are actually due.
     void applySessionTimeouts()
     {
         auto timeNow = std::chrono::steady_clock::now();
-        if (timeNow - lastTimeoutUpdate > std::chrono::seconds(1))
+        while (!idleOrder.empty() &&
+               timeNow - idleOrder.front()->lastUpdated >= timeoutInSeconds)
         {
-            lastTimeoutUpdate = timeNow;
-            auto authTokensIt = authTokens.begin();
-            while (authTokensIt != authTokens.end())
+            auto sessionIt = sessionsByUid.find(idleOrder.front()->uniqueId);
+            if (sessionIt == sessionsByUid.end())
             {
-                if (timeNow - authTokensIt->second->lastUpdated >=
-                    timeoutInSeconds)
-                {
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                    crow::ibm_mc_lock::Lock::getInstance().releaseLock(
-                        authTokensIt->second->uniqueId);
-#endif
-                    authTokensIt = authTokens.erase(authTokensIt);
-
-                    needWrite = true;
-                }
-                else
-                {
-                    authTokensIt++;
-                }
+                BMCWEB_LOG_CRITICAL << "Session index out of sync";
+                idleOrder.pop_front();
+                continue;
             }
+            eraseSession(sessionIt, true);
         }
     }
 
+    bool hasExpiredSessions() const
+    {
+        return expiredSinceWrite;
+    }
+
     SessionStore(const SessionStore&) = delete;
     SessionStore& operator=(const SessionStore&) = delete;
 
@@ -407,14 +552,190 @@ class SessionStore
                        crow::utility::ConstantTimeCompare>
         authTokens;
 
-    std::chrono::time_point<std::chrono::steady_clock> lastTimeoutUpdate;
     bool needWrite{false};
+    // Timed out sessions don't need a write of their own.  The file doesn't
+    // keep idle times, so they are only left out of the next write.
+    bool expiredSinceWrite{false};
     std::chrono::seconds timeoutInSeconds;
     AuthConfigMethods authMethodsConfig;
 
   private:
+    struct SessionIndexEntry
+    {
+        std::shared_ptr<UserSession> session;
+        std::list<UserSession*>::iterator idleIt;
+        std::list<UserSession*>::iterator userIdleIt;
+    };
+
+    using SessionIndex = std::unordered_map<std::string, SessionIndexEntry>;
+
     SessionStore() : timeoutInSeconds(1800)
     {}
+
+    static void publish(std::string_view op, nlohmann::json&& change)
+    {
+        change["type"] = "session";
+        change["op"] = op;
+        crow::workers::publish(std::move(change));
+    }
+
+    // Replaces the sessions kept for a timeout, which a new worker read from
+    // the persistent file, with those of the coordinator
+    void applySync(const nlohmann::json& sync)
+    {
+        std::unordered_map<std::string, std::shared_ptr<UserSession>> synced;
+        auto sessions = sync.find("sessions");
+        if (sessions != sync.end() && sessions->is_array())
+        {
+            for (const nlohmann::json& sessionJson : *sessions)
+            {
+                std::shared_ptr<UserSession> session =
+                    UserSession::fromJson(sessionJson);
+                if (session != nullptr)
+                {
+                    synced.emplace(session->uniqueId, session);
+                }
+            }
+        }
+        for (auto it = sessionsByUid.begin(); it != sessionsByUid.end();)
+        {
+            auto current = it++;
+            if (current->second.session->persistence ==
+                    PersistenceType::TIMEOUT &&
+                synced.find(current->first) == synced.end())
+            {
+                eraseSession(current);
+            }
+        }
+        for (auto& entry : synced)
+        {
+            if (sessionsByUid.find(entry.first) == sessionsByUid.end())
+            {
+                addSession(entry.second);
+            }
+        }
+        timeoutInSeconds = std::chrono::seconds(
+            sync.value("timeout", timeoutInSeconds.count()));
+        authMethodsConfig.fromJson(
+            sync.value("auth_config", nlohmann::json::object()));
+    }
+
+    void setAuthMethodsConfig(const AuthConfigMethods& config)
+    {
+        bool isTLSchanged = (authMethodsConfig.tls != config.tls);
+        authMethodsConfig = config;
+        needWrite = true;
+        // Workers don't reload on their own, the coordinator passes its
+        // SIGHUP on to all of them once the change reaches it
+        if (isTLSchanged && !crow::workers::isWorker())
+        {
+            // recreate socket connections with new settings
+            std::raise(SIGHUP);
+        }
+    }
+
+    void markRecentlyUsed(UserSession& session)
+    {
+        auto sessionIt = sessionsByUid.find(session.uniqueId);
+        if (sessionIt == sessionsByUid.end())
+        {
+            return;
+        }
+        SessionIndexEntry& entry = sessionIt->second;
+        idleOrder.splice(idleOrder.end(), idleOrder, entry.idleIt);
+        std::list<UserSession*>& userSessions =
+            sessionsByUser[session.username];
+        userSessions.splice(userSessions.end(), userSessions,
+                            entry.userIdleIt);
+    }
+
+    // Automation that logs in without ever logging out would otherwise grow
+    // the store without bound; drop the user's least recently used sessions
+    // once they hold more than maxSessionsPerUser.  With several processes
+    // their orders differ, so only the coordinator decides, and tells the
+    // workers which sessions went.
+    void enforceUserSessionLimit(const std::string& username)
+    {
+        if (crow::workers::isWorker())
+        {
+            return;
+        }
+        auto userIt = sessionsByUser.find(username);
+        if (userIt == sessionsByUser.end())
+        {
+            return;
+        }
+        std::list<UserSession*>& userSessions = userIt->second;
+        auto candidate = userSessions.begin();
+        size_t timeoutSessions = 0;
+        for (const UserSession* session : userSessions)
+        {
+            if (session->persistence == PersistenceType::TIMEOUT)
+            {
+                timeoutSessions++;
+            }
+        }
+        while (timeoutSessions > maxSessionsPerUser &&
+               candidate != userSessions.end())
+        {
+            UserSession* session = *candidate;
+            candidate++;
+            if (session->persistence != PersistenceType::TIMEOUT)
+            {
+                continue;
+            }
+            BMCWEB_LOG_INFO << "Session limit reached for " << username
+                            << ", removing session " << session->uniqueId;
+            auto sessionIt = sessionsByUid.find(session->uniqueId);
+            if (sessionIt != sessionsByUid.end())
+            {
+                crow::workers::publishAlways({{"type", "session"},
+                                              {"op", "remove"},
+                                              {"id", session->uniqueId}});
+                eraseSession(sessionIt);
+            }
+            timeoutSessions--;
+        }
+    }
+
+    void eraseSession(SessionIndex::iterator sessionIt, bool timedOut = false)
+    {
+        std::shared_ptr<UserSession> session = sessionIt->second.session;
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+        crow::ibm_mc_lock::Lock::getInstance().releaseLock(session->uniqueId);
+#endif
+        idleOrder.erase(sessionIt->second.idleIt);
+        auto userIt = sessionsByUser.find(session->username);
+        if (userIt != sessionsByUser.end())
+        {
+            userIt->second.erase(sessionIt->second.userIdleIt);
+            if (userIt->second.empty())
+            {
+                sessionsByUser.erase(userIt);
+            }
+        }
+        sessionsByUid.erase(sessionIt);
+        authTokens.erase(session->sessionToken);
+        // Single request sessions were never written out
+        if (session->persistence != PersistenceType::TIMEOUT)
+        {
+            return;
+        }
+        if (timedOut)
+        {
+            expiredSinceWrite = true;
+        }
+        else
+        {
+            needWrite = true;
+        }
+    }
+
+    // Secondary indexes over authTokens.  idleOrder and the per user lists
+    // are kept in least recently used order.
+    SessionIndex sessionsByUid;
+    std::unordered_map<std::string, std::list<UserSession*>> sessionsByUser;
+    std::list<UserSession*> idleOrder;
 };
 
 } // namespace persistent_data
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <logging.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace crow
+{
+
+/**
+ * @brief Runs a long loop on the io_context a slice at a time.
+ *
+ * step() does one iteration and returns false once there is nothing left to
+ * do.  When a slice has run for maxSlice, the loop posts the rest of itself
+ * back to the io_context, so the KVM frames, console bytes and requests
+ * waiting behind it get to run before it carries on.  done() runs once,
+ * after the last step.  Both are kept, with everything they capture, until
+ * then.
+ *
+ * A slice can only overrun maxSlice by the length of one step, so keep steps
+ * small.  The longest slice seen is logged, to keep an eye on that.
+ */
+class SlicedLoop : public std::enable_shared_from_this<SlicedLoop>
+{
+  public:
+    using Step = std::function<bool()>;
+    using Done = std::function<void()>;
+
+    static constexpr std::chrono::microseconds maxSlice{2000};
+
+    SlicedLoop(boost::asio::io_context& iocIn, Step&& stepIn,
+               Done&& doneIn) :
+        ioc(iocIn),
+        step(std::move(stepIn)), done(std::move(doneIn))
+    {}
+
+    // Runs the first slice right away, so short loops finish before this
+    // returns
+    static void run(boost::asio::io_context& ioc, Step&& step, Done&& done)
+    {
+        std::make_shared<SlicedLoop>(ioc, std::move(step), std::move(done))
+            ->runSlice();
+    }
+
+    // Longest slice run so far, by any loop
+    static std::chrono::microseconds& longestSlice()
+    {
+        static std::chrono::microseconds longest{0};
+        return longest;
+    }
+
+  private:
+    void runSlice()
+    {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        bool more = true;
+        std::chrono::steady_clock::duration elapsed{};
+        while (more && elapsed < maxSlice)
+        {
+            more = step();
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+
+        std::chrono::microseconds sliceTime =
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        if (sliceTime > longestSlice())
+        {
+            longestSlice() = sliceTime;
+            BMCWEB_LOG_DEBUG << "Longest loop slice so far: "
+                             << sliceTime.count() << "us";
+        }
+
+        if (!more)
+        {
+            done();
+            return;
+        }
+        boost::asio::post(ioc, [self{shared_from_this()}] { self->runSlice(); });
+    }
+
+    boost::asio::io_context& ioc;
+    Step step;
+    Done done;
+};
+
+} // namespace crow
@@ -5,6 +5,11 @@
 #include <openssl/dsa.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
 #include <openssl/pem.h>
 #include <openssl/rand.h>
 #include <openssl/rsa.h>
@@ -13,12 +18,28 @@
 #include <boost/asio/ssl/context.hpp>
 #include <random.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
 #include <random>
 
 namespace ensuressl
 {
 constexpr char const* trustStorePath = "/etc/ssl/certs/authority";
 constexpr char const* x509Comment = "Generated from OpenBMC service";
+
+// Clients that reconnect every polling cycle can resume their TLS session
+// instead of paying for a full ECDHE handshake each time.
+constexpr char const* sslSessionIdContext = "bmcweb";
+constexpr long sslSessionCacheSize = 1024;
+constexpr long sslSessionTimeoutSeconds = 3600;
+// Session ticket keys live only in memory and are replaced on this interval.
+// Tickets issued under the previous key are still accepted (and reissued)
+// for one more interval.
+constexpr std::chrono::seconds ticketKeyRotationInterval(3600);
 static void initOpenssl();
 static EVP_PKEY* createEcKey();
 
@@ -419,6 +440,250 @@ inline void ensureOpensslKeyPresentAndValid(const std::string& filepath)
     }
 }
 
+// The certificate the server uses.  Removes the one older releases used, and
+// creates the directory for it, so a self signed one can be made there.
+inline std::string serverCertFile()
+{
+    namespace fs = std::filesystem;
+    // Cleanup older certificate file existing in the system
+    fs::path oldCert = "/home/root/server.pem";
+    if (fs::exists(oldCert))
+    {
+        fs::remove("/home/root/server.pem");
+    }
+    fs::path certPath = "/etc/ssl/certs/https/";
+    // if path does not exist create the path so that
+    // self signed certificate can be created in the
+    // path
+    if (!fs::exists(certPath))
+    {
+        fs::create_directories(certPath);
+    }
+    fs::path certFile = certPath / "server.pem";
+    return certFile;
+}
+
+struct SslSessionStats
+{
+    uint64_t fullHandshakes = 0;
+    uint64_t resumedHandshakes = 0;
+};
+
+inline SslSessionStats& getSslSessionStats()
+{
+    static SslSessionStats stats;
+    return stats;
+}
+
+// Records whether a completed server handshake resumed a previous session
+inline void recordHandshake(const SSL* ssl)
+{
+    SslSessionStats& stats = getSslSessionStats();
+    if (SSL_session_reused(ssl) == 1)
+    {
+        stats.resumedHandshakes++;
+    }
+    else
+    {
+        stats.fullHandshakes++;
+    }
+    BMCWEB_LOG_DEBUG << "TLS handshakes: " << stats.resumedHandshakes
+                     << " resumed, " << stats.fullHandshakes << " full";
+}
+
+class TicketKeys
+{
+  public:
+    struct Key
+    {
+        std::array<unsigned char, 16> name{};
+        std::array<unsigned char, 32> aesKey{};
+        std::array<unsigned char, 32> hmacKey{};
+    };
+
+    static TicketKeys& getInstance()
+    {
+        static TicketKeys keys;
+        return keys;
+    }
+
+    void rotate()
+    {
+        Key next;
+        if (RAND_bytes(next.name.data(), static_cast<int>(next.name.size())) !=
+                1 ||
+            RAND_bytes(next.aesKey.data(),
+                       static_cast<int>(next.aesKey.size())) != 1 ||
+            RAND_bytes(next.hmacKey.data(),
+                       static_cast<int>(next.hmacKey.size())) != 1)
+        {
+            BMCWEB_LOG_ERROR << "Failed to generate session ticket key";
+            return;
+        }
+        previous = current;
+        current = next;
+        BMCWEB_LOG_DEBUG << "Rotated TLS session ticket keys";
+    }
+
+    Key& getCurrent()
+    {
+        return *current;
+    }
+
+    // Returns the key that issued a ticket, or nullptr if it is unknown or
+    // has been rotated out
+    Key* find(const unsigned char* name)
+    {
+        if (current && std::memcmp(current->name.data(), name,
+                                   current->name.size()) == 0)
+        {
+            return &*current;
+        }
+        if (previous && std::memcmp(previous->name.data(), name,
+                                    previous->name.size()) == 0)
+        {
+            return &*previous;
+        }
+        return nullptr;
+    }
+
+    bool isCurrent(const Key& key) const
+    {
+        return current && &*current == &key;
+    }
+
+    bool empty() const
+    {
+        return !current;
+    }
+
+  private:
+    TicketKeys() = default;
+
+    std::optional<Key> current;
+    std::optional<Key> previous;
+};
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+inline bool setTicketHmacKey(EVP_MAC_CTX* hctx, TicketKeys::Key& key)
+{
+    std::string digest = "SHA256";
+    std::array<OSSL_PARAM, 3> params = {
+        OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+                                          key.hmacKey.data(),
+                                          key.hmacKey.size()),
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest.data(),
+                                         0),
+        OSSL_PARAM_construct_end()};
+    return EVP_MAC_CTX_set_params(hctx, params.data()) == 1;
+}
+using TicketHmacCtx = EVP_MAC_CTX;
+#else
+inline bool setTicketHmacKey(HMAC_CTX* hctx, TicketKeys::Key& key)
+{
+    return HMAC_Init_ex(hctx, key.hmacKey.data(),
+                        static_cast<int>(key.hmacKey.size()), EVP_sha256(),
+                        nullptr) == 1;
+}
+using TicketHmacCtx = HMAC_CTX;
+#endif
+
+// OpenSSL session ticket callback.  Returns 1 to use the ticket, 2 to use it
+// and issue a fresh one under the current key, 0 to fall back to a full
+// handshake and -1 on error.
+inline int ticketKeyCallback(SSL* /*ssl*/, unsigned char* keyName,
+                             unsigned char* iv, EVP_CIPHER_CTX* cipherCtx,
+                             TicketHmacCtx* hmacCtx, int encrypt)
+{
+    TicketKeys& keys = TicketKeys::getInstance();
+    if (keys.empty())
+    {
+        return encrypt == 1 ? -1 : 0;
+    }
+    if (encrypt == 1)
+    {
+        TicketKeys::Key& key = keys.getCurrent();
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)
+        {
+            return -1;
+        }
+        std::memcpy(keyName, key.name.data(), key.name.size());
+        if (EVP_EncryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                               key.aesKey.data(), iv) != 1 ||
+            !setTicketHmacKey(hmacCtx, key))
+        {
+            return -1;
+        }
+        return 1;
+    }
+
+    TicketKeys::Key* key = keys.find(keyName);
+    if (key == nullptr)
+    {
+        return 0;
+    }
+    if (!setTicketHmacKey(hmacCtx, *key) ||
+        EVP_DecryptInit_ex(cipherCtx, EVP_aes_256_cbc(), nullptr,
+                           key->aesKey.data(), iv) != 1)
+    {
+        return -1;
+    }
+    return keys.isCurrent(*key) ? 1 : 2;
+}
+
+inline void setupSessionResumption(boost::asio::ssl::context& ctx)
+{
+    SSL_CTX* nativeCtx = ctx.native_handle();
+    SSL_CTX_set_session_cache_mode(nativeCtx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(nativeCtx, sslSessionCacheSize);
+    SSL_CTX_set_timeout(nativeCtx, sslSessionTimeoutSeconds);
+    if (SSL_CTX_set_session_id_context(
+            nativeCtx,
+            reinterpret_cast<const unsigned char*>(sslSessionIdContext),
+            static_cast<unsigned int>(std::strlen(sslSessionIdContext))) != 1)
+    {
+        BMCWEB_LOG_ERROR << "Error setting SSL session id context";
+    }
+
+    TicketKeys& keys = TicketKeys::getInstance();
+    if (keys.empty())
+    {
+        keys.rotate();
+    }
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+    if (SSL_CTX_set_tlsext_ticket_key_evp_cb(nativeCtx, ticketKeyCallback) !=
+        1)
+#else
+    if (SSL_CTX_set_tlsext_ticket_key_cb(nativeCtx, ticketKeyCallback) != 1)
+#endif
+    {
+        BMCWEB_LOG_ERROR << "Error setting session ticket callback";
+    }
+}
+
+#ifdef BMCWEB_ENABLE_HTTP2
+// Prefer HTTP/2 when the client offers it, and fall back to HTTP/1.1 for
+// clients that don't use ALPN or don't offer h2
+inline int alpnSelectProtoCallback(SSL* /* ssl */, const unsigned char** out,
+                                   unsigned char* outlen,
+                                   const unsigned char* in,
+                                   unsigned int inlen, void* /* arg */)
+{
+    // Wire format: length prefixed protocol names, in order of preference
+    static constexpr std::array<unsigned char, 12> serverProtos = {
+        2, 'h', '2', 8, 'h', 't', 't', 'p', '/', '1', '.', '1'};
+    unsigned char* selected = nullptr;
+    int rv = SSL_select_next_proto(&selected, outlen, serverProtos.data(),
+                                   serverProtos.size(), in, inlen);
+    if (rv != OPENSSL_NPN_NEGOTIATED)
+    {
+        return SSL_TLSEXT_ERR_NOACK;
+    }
+    *out = selected;
+    return SSL_TLSEXT_ERR_OK;
+}
+#endif // BMCWEB_ENABLE_HTTP2
+
 inline std::shared_ptr<boost::asio::ssl::context>
     getSslContext(const std::string& sslPemFile)
 {
@@ -471,6 +736,12 @@ inline std::shared_ptr<boost::asio::ssl::context>
     {
         BMCWEB_LOG_ERROR << "Error setting cipher list\n";
     }
+
+    setupSessionResumption(*mSslContext);
+#ifdef BMCWEB_ENABLE_HTTP2
+    SSL_CTX_set_alpn_select_cb(mSslContext->native_handle(),
+                               alpnSelectProtoCallback, nullptr);
+#endif
     return mSslContext;
 }
 } // namespace ensuressl
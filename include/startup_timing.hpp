@@ -0,0 +1,157 @@
+#pragma once
+
+#include <systemd/sd-daemon.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <logging.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace startup
+{
+
+/**
+ * @brief Time since the kernel started this process, from the start time in
+ * /proc/self/stat.  Only as precise as the clock tick, usually 10ms.
+ *
+ * @return 0 if it can't be read
+ */
+inline std::chrono::milliseconds sinceExec()
+{
+    std::ifstream statFile("/proc/self/stat");
+    std::string stat((std::istreambuf_iterator<char>(statFile)),
+                     std::istreambuf_iterator<char>());
+    // The command name can hold spaces and parentheses, the fields after it
+    // can't
+    size_t commEnd = stat.rfind(')');
+    if (commEnd == std::string::npos)
+    {
+        return {};
+    }
+    std::istringstream fields(stat.substr(commEnd + 1));
+    std::string field;
+    // starttime is field 22 of the file, the 20th after the command name
+    for (int i = 0; i < 20; i++)
+    {
+        fields >> field;
+    }
+    uint64_t startTicks = 0;
+    auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(),
+                                     startTicks);
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    timespec now{};
+    if (!fields || ec != std::errc() || ticksPerSecond <= 0 ||
+        clock_gettime(CLOCK_BOOTTIME, &now) != 0)
+    {
+        return {};
+    }
+    std::chrono::milliseconds started(startTicks * 1000 /
+                                      static_cast<uint64_t>(ticksPerSecond));
+    std::chrono::milliseconds uptime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::seconds(now.tv_sec) +
+            std::chrono::nanoseconds(now.tv_nsec));
+    return uptime - started;
+}
+
+/**
+ * @brief How long each phase of startup took, until connections are
+ * accepted.
+ *
+ * main() calls mark() at the end of each phase, the first one starts when
+ * the process does.  Once the server accepts connections, the phases are
+ * logged and handed to systemd as the status of the unit, so systemctl status
+ * shows where the time went.
+ */
+class Timings
+{
+  public:
+    struct Phase
+    {
+        std::string name;
+        std::chrono::microseconds duration;
+    };
+
+    static Timings& getInstance()
+    {
+        static Timings timings;
+        return timings;
+    }
+
+    // Ends the phase started by the previous mark()
+    void mark(std::string_view name)
+    {
+        std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        phases.push_back(
+            {std::string(name),
+             std::chrono::duration_cast<std::chrono::microseconds>(
+                 now - phaseStart)});
+        phaseStart = now;
+    }
+
+    const std::vector<Phase>& getPhases() const
+    {
+        return phases;
+    }
+
+    std::string summary() const
+    {
+        std::string out;
+        for (const Phase& phase : phases)
+        {
+            if (!out.empty())
+            {
+                out += ", ";
+            }
+            out += phase.name;
+            out += ' ';
+            out += std::to_string(phase.duration.count() / 1000);
+            out += "ms";
+        }
+        return out;
+    }
+
+    // Called once the server accepts connections
+    void accepting()
+    {
+        if (isAccepting)
+        {
+            return;
+        }
+        isAccepting = true;
+        mark("listener");
+        std::string status = "Accepting connections " +
+                             std::to_string(sinceExec().count()) +
+                             "ms after start: " + summary();
+        BMCWEB_LOG_INFO << status;
+        sd_notifyf(0, "READY=1\nSTATUS=%s", status.c_str());
+    }
+
+  private:
+    Timings() = default;
+
+    std::chrono::steady_clock::time_point phaseStart =
+        std::chrono::steady_clock::now() - sinceExec();
+    std::vector<Phase> phases;
+    bool isAccepting = false;
+};
+
+inline void mark(std::string_view name)
+{
+    Timings::getInstance().mark(name);
+}
+
+} // namespace startup
+} // namespace crow
@@ -0,0 +1,162 @@
+#include <coroutine.hpp>
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+
+#include "gmock/gmock.h"
+
+using crow::coro::Task;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+Task<int> delayedValue(boost::asio::io_context& ioc, int value,
+                       std::chrono::milliseconds delay)
+{
+    co_await crow::coro::sleepFor(ioc, delay);
+    co_return value;
+}
+
+Task<> sumInto(boost::asio::io_context& ioc, int& sum)
+{
+    auto [a, b, c] =
+        co_await crow::coro::whenAll(delayedValue(ioc, 1, 10ms),
+                                     delayedValue(ioc, 2, 5ms),
+                                     delayedValue(ioc, 3, 0ms));
+    sum = a + b + c;
+}
+
+} // namespace
+
+TEST(Coroutine, WhenAllRunsTasksTogether)
+{
+    boost::asio::io_context ioc;
+    int sum = 0;
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    crow::coro::spawn(sumInto(ioc, sum));
+    EXPECT_EQ(sum, 0);
+    ioc.run();
+    EXPECT_EQ(sum, 6);
+    // One after the other they would have taken 15ms
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(Coroutine, WhenAllOfFinishedTasksDoesNotSuspend)
+{
+    int sum = 0;
+    auto immediate = [](int value) -> Task<int> { co_return value; };
+    auto sum2 = [&sum, immediate]() -> Task<> {
+        auto [a, b] = co_await crow::coro::whenAll(immediate(4), immediate(5));
+        sum = a + b;
+    };
+    crow::coro::spawn(sum2());
+    EXPECT_EQ(sum, 9);
+}
+
+TEST(Coroutine, ExceptionsReachTheAwaitingTask)
+{
+    bool caught = false;
+    auto thrower = []() -> Task<int> {
+        throw std::runtime_error("failed");
+        co_return 0;
+    };
+    auto catcher = [&caught, thrower]() -> Task<> {
+        try
+        {
+            co_await thrower();
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+    };
+    crow::coro::spawn(catcher());
+    EXPECT_TRUE(caught);
+}
+
+namespace
+{
+
+Task<> fillFromArena(std::shared_ptr<bmcweb::AsyncResp> asyncResp,
+                     boost::asio::io_context& ioc)
+{
+    co_await crow::coro::sleepFor(ioc, 0ms);
+    asyncResp->res.jsonValue["Done"] = true;
+}
+
+} // namespace
+
+TEST(Coroutine, FramesComeFromTheRequestArena)
+{
+    boost::asio::io_context ioc;
+    crow::Response res;
+    {
+        auto asyncResp = std::make_shared<bmcweb::AsyncResp>(res);
+        crow::coro::spawn(fillFromArena(asyncResp, ioc));
+        crow::coro::spawn(fillFromArena(asyncResp, ioc));
+        EXPECT_EQ(asyncResp->arena()->chunkCount(), 1U);
+    }
+    // The frames keep the request open
+    EXPECT_FALSE(res.jsonValue.contains("Done"));
+    ioc.run();
+    EXPECT_EQ(res.jsonValue["Done"], true);
+}
+
+TEST(RequestArena, ReusesFreedBlocks)
+{
+    crow::RequestArena arena;
+    void* first = arena.allocate(100);
+    void* second = arena.allocate(100);
+    arena.deallocate(second, 100);
+    EXPECT_EQ(arena.allocate(100), second);
+    arena.deallocate(second, 100);
+    arena.deallocate(first, 100);
+    EXPECT_EQ(arena.allocate(crow::RequestArena::chunkSize), first);
+    void* big = arena.allocate(crow::RequestArena::chunkSize);
+    EXPECT_EQ(arena.chunkCount(), 2U);
+    arena.deallocate(big, crow::RequestArena::chunkSize);
+    arena.deallocate(first, crow::RequestArena::chunkSize);
+}
+
+TEST(Coroutine, CallbackOpGivesBackWhatTheCallbackWasCalledWith)
+{
+    std::function<void(int)> pending;
+    std::optional<std::tuple<int>> got;
+    auto waiter = [&pending, &got]() -> Task<> {
+        got = co_await crow::coro::callbackOp<int>(
+            [&pending](auto&& done) { pending = std::move(done); });
+    };
+    crow::coro::spawn(waiter());
+    EXPECT_FALSE(got);
+    pending(7);
+    ASSERT_TRUE(got);
+    EXPECT_EQ(std::get<0>(*got), 7);
+    // Calling it again does nothing
+    pending(8);
+    EXPECT_EQ(std::get<0>(*got), 7);
+}
+
+TEST(Coroutine, CallbackOpResumesWhenTheCallbackIsDropped)
+{
+    std::function<void()> pending;
+    bool resumed = false;
+    bool called = true;
+    auto waiter = [&pending, &resumed, &called]() -> Task<> {
+        auto result = co_await crow::coro::callbackOp<>(
+            [&pending](auto&& done) { pending = std::move(done); });
+        resumed = true;
+        called = result.has_value();
+    };
+    crow::coro::spawn(waiter());
+    std::function<void()> copy = pending;
+    pending = nullptr;
+    EXPECT_FALSE(resumed);
+    copy = nullptr;
+    EXPECT_TRUE(resumed);
+    EXPECT_FALSE(called);
+}
@@ -0,0 +1,70 @@
+#include <dbus_introspection.hpp>
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+
+using crow::dbus_introspection::Node;
+using crow::dbus_introspection::parse;
+
+TEST(DbusIntrospection, ParsesInterfacesAndChildren)
+{
+    std::shared_ptr<const Node> node = parse(R"(<!DOCTYPE node>
+<node>
+  <interface name="xyz.openbmc_project.Test">
+    <method name="Set">
+      <arg name="value" type="s" direction="in"/>
+      <arg type="b" direction="out"/>
+    </method>
+    <signal name="Changed">
+      <arg name="value" type="s"/>
+    </signal>
+    <property name="Value" type="s" access="readwrite"/>
+  </interface>
+  <node name="child0"/>
+  <node name="child1"/>
+</node>)");
+    ASSERT_NE(node, nullptr);
+    EXPECT_THAT(node->children, testing::ElementsAre("child0", "child1"));
+
+    ASSERT_EQ(node->interfaces.size(), 1);
+    const crow::dbus_introspection::Interface& interface =
+        node->interfaces[0];
+    EXPECT_EQ(interface.name, "xyz.openbmc_project.Test");
+
+    ASSERT_EQ(interface.methods.size(), 1);
+    EXPECT_EQ(interface.methods[0].name, "Set");
+    ASSERT_EQ(interface.methods[0].args.size(), 2);
+    EXPECT_EQ(interface.methods[0].args[0].name, "value");
+    EXPECT_EQ(interface.methods[0].args[0].type, "s");
+    EXPECT_EQ(interface.methods[0].args[0].direction, "in");
+    // Missing attributes are left empty
+    EXPECT_EQ(interface.methods[0].args[1].name, "");
+    EXPECT_EQ(interface.methods[0].args[1].direction, "out");
+
+    ASSERT_EQ(interface.signals.size(), 1);
+    EXPECT_EQ(interface.signals[0].name, "Changed");
+    ASSERT_EQ(interface.signals[0].args.size(), 1);
+    EXPECT_EQ(interface.signals[0].args[0].direction, "");
+
+    ASSERT_EQ(interface.properties.size(), 1);
+    EXPECT_EQ(interface.properties[0].name, "Value");
+    EXPECT_EQ(interface.properties[0].type, "s");
+    EXPECT_EQ(interface.properties[0].access, "readwrite");
+}
+
+TEST(DbusIntrospection, NodeWithoutInterfacesIsEmpty)
+{
+    std::shared_ptr<const Node> node = parse("<node></node>");
+    ASSERT_NE(node, nullptr);
+    EXPECT_TRUE(node->children.empty());
+    EXPECT_TRUE(node->interfaces.empty());
+}
+
+TEST(DbusIntrospection, XmlWithoutRootNodeIsNull)
+{
+    EXPECT_EQ(parse(""), nullptr);
+    EXPECT_EQ(parse("<interface name=\"a.b\"/>"), nullptr);
+    EXPECT_EQ(parse("<node><interface name=\"a.b\">"), nullptr);
+}
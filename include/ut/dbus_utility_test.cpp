@@ -3,6 +3,10 @@
 #include <dbus_singleton.hpp>
 #include <dbus_utility.hpp>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "gmock/gmock.h"
 
 TEST(DbusUtility, getNthStringFromPathGoodTest)
@@ -34,3 +38,128 @@ TEST(DbusUtility, getNthStringFromPathBadTest)
     EXPECT_EQ(result, "3rd?");
     EXPECT_FALSE(dbus::utility::getNthStringFromPath(path, -1, result));
 }
+
+TEST(DbusUtility, appendCallKeyKeepsArgumentsDistinct)
+{
+    std::string joined;
+    dbus::utility::details::appendCallKey(joined, "ab");
+    dbus::utility::details::appendCallKey(joined, std::string("c"));
+
+    std::string split;
+    dbus::utility::details::appendCallKey(split, "a");
+    dbus::utility::details::appendCallKey(split, std::string("bc"));
+    EXPECT_NE(joined, split);
+
+    std::string depth0;
+    dbus::utility::details::appendCallKey(depth0, 0);
+    std::string depth2;
+    dbus::utility::details::appendCallKey(depth2, int32_t(2));
+    EXPECT_NE(depth0, depth2);
+
+    std::string interfaces;
+    dbus::utility::details::appendCallKey(
+        interfaces, std::array<const char*, 2>{"xyz.A", "xyz.B"});
+    std::string sameInterfaces;
+    dbus::utility::details::appendCallKey(
+        sameInterfaces, std::vector<std::string>{"xyz.A", "xyz.B"});
+    EXPECT_EQ(interfaces, sameInterfaces);
+
+    std::string otherInterfaces;
+    dbus::utility::details::appendCallKey(
+        otherInterfaces, std::vector<std::string>{"xyz.A"});
+    EXPECT_NE(interfaces, otherInterfaces);
+}
+
+TEST(DbusUtility, identicalCallsShareOneInFlightEntry)
+{
+    using dbus::utility::details::completeCall;
+    using dbus::utility::details::inFlightTable;
+    using dbus::utility::details::joinCall;
+    using dbus::utility::details::makeCallKey;
+
+    const dbus::utility::CoalescedCallStats before =
+        dbus::utility::getCoalescedCallStats();
+    std::string key = makeCallKey("xyz.Service", "/xyz/path", "xyz.Iface",
+                                  "Get", std::string("Value"));
+    EXPECT_EQ(key, makeCallKey("xyz.Service", "/xyz/path", "xyz.Iface", "Get",
+                               "Value"));
+
+    std::vector<std::string> replies;
+    auto callback = [&replies](const boost::system::error_code& ec,
+                               const std::string& resp) {
+        EXPECT_FALSE(ec);
+        replies.push_back(resp);
+    };
+    EXPECT_TRUE(joinCall<std::string>(key, callback));
+    EXPECT_FALSE(joinCall<std::string>(key, callback));
+    ASSERT_EQ(inFlightTable<std::string>().size(), 1);
+    EXPECT_EQ(inFlightTable<std::string>()[key].size(), 2);
+
+    const dbus::utility::CoalescedCallStats& after =
+        dbus::utility::getCoalescedCallStats();
+    EXPECT_EQ(after.issued, before.issued + 1);
+    EXPECT_EQ(after.coalesced, before.coalesced + 1);
+
+    completeCall(key, boost::system::error_code(), std::string("reply"));
+    EXPECT_THAT(replies, testing::ElementsAre("reply", "reply"));
+    EXPECT_TRUE(inFlightTable<std::string>().empty());
+
+    // Once the reply is delivered, the same call starts over
+    EXPECT_TRUE(joinCall<std::string>(key, callback));
+    completeCall(key, boost::system::error_code(), std::string("again"));
+    EXPECT_THAT(replies, testing::ElementsAre("reply", "reply", "again"));
+}
+
+TEST(DbusUtility, callbacksOfDifferentTypesShareTheTable)
+{
+    using dbus::utility::details::completeCall;
+    using dbus::utility::details::inFlightTable;
+    using dbus::utility::details::joinCall;
+
+    int lambdaCalls = 0;
+    auto lambda = [&lambdaCalls](const boost::system::error_code&,
+                                 const std::vector<std::string>& resp) {
+        EXPECT_EQ(resp.size(), 2);
+        lambdaCalls++;
+    };
+    // Move-only, unlike the lambda
+    struct Counter
+    {
+        std::unique_ptr<int> moveOnly;
+        int* calls;
+        void operator()(const boost::system::error_code&,
+                        const std::vector<std::string>& resp) const
+        {
+            EXPECT_EQ(resp.size(), 2);
+            (*calls)++;
+        }
+    };
+    int counterCalls = 0;
+
+    std::string key = dbus::utility::details::makeCallKey(
+        "xyz.Service", "/", "xyz.Iface", "List");
+    EXPECT_TRUE(joinCall<std::vector<std::string>>(key, lambda));
+    EXPECT_FALSE(joinCall<std::vector<std::string>>(
+        key, Counter{std::make_unique<int>(0), &counterCalls}));
+    EXPECT_EQ(inFlightTable<std::vector<std::string>>()[key].size(), 2);
+
+    // A reply type of its own gets a table of its own
+    EXPECT_TRUE(inFlightTable<std::string>().empty());
+
+    completeCall(key, boost::system::error_code(),
+                 std::vector<std::string>{"a", "b"});
+    EXPECT_EQ(lambdaCalls, 1);
+    EXPECT_EQ(counterCalls, 1);
+}
+
+TEST(DbusUtility, completeCallForAnUnknownKeyIsIgnored)
+{
+    const dbus::utility::CoalescedCallStats before =
+        dbus::utility::getCoalescedCallStats();
+    dbus::utility::details::completeCall(
+        "unknown", boost::system::error_code(), std::string("reply"));
+    const dbus::utility::CoalescedCallStats& after =
+        dbus::utility::getCoalescedCallStats();
+    EXPECT_EQ(after.issued, before.issued);
+    EXPECT_EQ(after.coalesced, before.coalesced);
+}
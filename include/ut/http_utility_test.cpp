@@ -19,3 +19,73 @@ TEST(HttpUtility, requestPrefersHtml)
     EXPECT_FALSE(http_helpers::requestPrefersHtml("application/json"));
     EXPECT_FALSE(http_helpers::isOctetAccepted("application/json"));
 }
+
+TEST(HttpUtility, parseRange)
+{
+    using http_helpers::RangeStatus;
+    http_helpers::ByteRange range;
+
+    EXPECT_EQ(http_helpers::parseRange("bytes=0-99", 1000, range),
+              RangeStatus::Satisfiable);
+    EXPECT_EQ(range.offset, 0U);
+    EXPECT_EQ(range.length, 100U);
+
+    EXPECT_EQ(http_helpers::parseRange("bytes=900-", 1000, range),
+              RangeStatus::Satisfiable);
+    EXPECT_EQ(range.offset, 900U);
+    EXPECT_EQ(range.length, 100U);
+
+    EXPECT_EQ(http_helpers::parseRange("bytes=-10", 1000, range),
+              RangeStatus::Satisfiable);
+    EXPECT_EQ(range.offset, 990U);
+    EXPECT_EQ(range.length, 10U);
+
+    // The end is clamped to the size
+    EXPECT_EQ(http_helpers::parseRange("bytes=500-5000", 1000, range),
+              RangeStatus::Satisfiable);
+    EXPECT_EQ(range.offset, 500U);
+    EXPECT_EQ(range.length, 500U);
+
+    EXPECT_EQ(http_helpers::parseRange("bytes=1000-", 1000, range),
+              RangeStatus::Unsatisfiable);
+    EXPECT_EQ(http_helpers::parseRange("bytes=-0", 1000, range),
+              RangeStatus::Unsatisfiable);
+
+    // Malformed and multi-range requests are ignored
+    EXPECT_EQ(http_helpers::parseRange("", 1000, range), RangeStatus::None);
+    EXPECT_EQ(http_helpers::parseRange("items=0-1", 1000, range),
+              RangeStatus::None);
+    EXPECT_EQ(http_helpers::parseRange("bytes=5-1", 1000, range),
+              RangeStatus::None);
+    EXPECT_EQ(http_helpers::parseRange("bytes=a-b", 1000, range),
+              RangeStatus::None);
+    EXPECT_EQ(http_helpers::parseRange("bytes=0-1,5-6", 1000, range),
+              RangeStatus::None);
+}
+
+TEST(HttpUtility, ifNoneMatchMatches)
+{
+    using http_helpers::ifNoneMatchMatches;
+
+    EXPECT_TRUE(ifNoneMatchMatches("\"abc\"", "\"abc\""));
+    EXPECT_FALSE(ifNoneMatchMatches("\"abd\"", "\"abc\""));
+    EXPECT_FALSE(ifNoneMatchMatches("", "\"abc\""));
+    EXPECT_TRUE(ifNoneMatchMatches("*", "\"abc\""));
+
+    // Weak comparison ignores W/ on either side
+    EXPECT_TRUE(ifNoneMatchMatches("W/\"abc\"", "\"abc\""));
+    EXPECT_TRUE(ifNoneMatchMatches("\"abc\"", "W/\"abc\""));
+
+    // Any tag of a list will do
+    EXPECT_TRUE(ifNoneMatchMatches("\"x\", W/\"abc\"", "\"abc\""));
+    EXPECT_TRUE(ifNoneMatchMatches("\"x\",\"y\" ,\"abc\"", "\"abc\""));
+    EXPECT_FALSE(ifNoneMatchMatches("\"x\", \"y\"", "\"abc\""));
+
+    // A comma inside a tag doesn't split it
+    EXPECT_TRUE(ifNoneMatchMatches("\"a,b\"", "\"a,b\""));
+    EXPECT_FALSE(ifNoneMatchMatches("\"a,b\"", "\"b\""));
+
+    // Tags have to be quoted
+    EXPECT_FALSE(ifNoneMatchMatches("abc", "\"abc\""));
+    EXPECT_FALSE(ifNoneMatchMatches("\"abc", "\"abc\""));
+}
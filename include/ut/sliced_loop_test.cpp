@@ -0,0 +1,43 @@
+#include <sliced_loop.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "gmock/gmock.h"
+
+TEST(SlicedLoop, ShortLoopFinishesInline)
+{
+    boost::asio::io_context ioc;
+    int steps = 0;
+    bool done = false;
+    crow::SlicedLoop::run(
+        ioc, [&steps]() { return ++steps < 10; }, [&done]() { done = true; });
+    EXPECT_EQ(steps, 10);
+    EXPECT_TRUE(done);
+}
+
+TEST(SlicedLoop, LongLoopYieldsToOtherWork)
+{
+    boost::asio::io_context ioc;
+    int steps = 0;
+    bool done = false;
+    // Each step takes longer than a slice, so every step gets its own
+    crow::SlicedLoop::run(
+        ioc,
+        [&steps]() {
+            std::this_thread::sleep_for(crow::SlicedLoop::maxSlice);
+            return ++steps < 3;
+        },
+        [&done]() { done = true; });
+    EXPECT_EQ(steps, 1);
+    EXPECT_FALSE(done);
+
+    // Work queued while the loop runs gets its turn before the loop ends
+    int stepsWhenPosted = 0;
+    boost::asio::post(ioc, [&]() { stepsWhenPosted = steps; });
+    ioc.run();
+    EXPECT_LT(stepsWhenPosted, 3);
+    EXPECT_EQ(steps, 3);
+    EXPECT_TRUE(done);
+    EXPECT_GE(crow::SlicedLoop::longestSlice(), crow::SlicedLoop::maxSlice);
+}
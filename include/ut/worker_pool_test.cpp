@@ -0,0 +1,319 @@
+#include <sys/socket.h>
+
+#include <event_service_manager.hpp>
+#include <sessions.hpp>
+#include <worker_pool.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace
+{
+
+struct ChannelPair
+{
+    explicit ChannelPair(boost::asio::io_context& ioc)
+    {
+        std::array<int, 2> fds{};
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds.data()), 0);
+        left = std::make_shared<crow::workers::Channel>(ioc, fds[0]);
+        right = std::make_shared<crow::workers::Channel>(ioc, fds[1]);
+    }
+
+    std::shared_ptr<crow::workers::Channel> left;
+    std::shared_ptr<crow::workers::Channel> right;
+};
+
+// The pool is a singleton, so every test that attaches a worker shares one
+// io_context, and the handlers bmcweb registers at startup
+boost::asio::io_context& poolIo()
+{
+    static boost::asio::io_context ioc;
+    static bool registered = false;
+    if (!registered)
+    {
+        registered = true;
+        crow::workers::Pool& pool = crow::workers::Pool::getInstance();
+        pool.onMessage("session", [](const nlohmann::json& change) {
+            persistent_data::SessionStore::getInstance().applyChange(change);
+        });
+        pool.onMessage("event_service", [](const nlohmann::json& change) {
+            redfish::EventServiceManager::getInstance().applyChange(change);
+        });
+    }
+    return ioc;
+}
+
+void runPool()
+{
+    // poll() leaves the io_context stopped once it runs out of work
+    poolIo().restart();
+    poolIo().poll();
+}
+
+// Stands in for a worker process, which makes this one the coordinator
+struct FakeWorker
+{
+    FakeWorker()
+    {
+        std::array<int, 2> fds{};
+        EXPECT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0,
+                             fds.data()),
+                  0);
+        crow::workers::Pool::getInstance().attachWorker(poolIo(), fds[0]);
+        channel = std::make_shared<crow::workers::Channel>(poolIo(), fds[1]);
+        channel->start(
+            [this](std::string_view data) {
+                received.emplace_back(nlohmann::json::parse(data));
+            },
+            []() {});
+    }
+
+    FakeWorker(const FakeWorker&) = delete;
+    FakeWorker& operator=(const FakeWorker&) = delete;
+    FakeWorker(FakeWorker&&) = delete;
+    FakeWorker& operator=(FakeWorker&&) = delete;
+
+    ~FakeWorker()
+    {
+        channel->close();
+        runPool();
+    }
+
+    void send(const nlohmann::json& msg)
+    {
+        channel->send(msg.dump());
+        runPool();
+    }
+
+    std::vector<nlohmann::json> ofOp(std::string_view type,
+                                     std::string_view op) const
+    {
+        std::vector<nlohmann::json> matching;
+        for (const nlohmann::json& msg : received)
+        {
+            if (msg.value("type", "") == type && msg.value("op", "") == op)
+            {
+                matching.emplace_back(msg);
+            }
+        }
+        return matching;
+    }
+
+    std::shared_ptr<crow::workers::Channel> channel;
+    std::vector<nlohmann::json> received;
+};
+
+nlohmann::json sessionJson(const std::string& id, const std::string& user)
+{
+    return {{"unique_id", id},
+            {"session_token", "token" + id},
+            {"username", user},
+            {"csrf_token", "csrf" + id},
+            {"client_ip", "127.0.0.1"}};
+}
+
+} // namespace
+
+TEST(WorkerChannel, DeliversMessagesInOrder)
+{
+    boost::asio::io_context ioc;
+    ChannelPair pair(ioc);
+    std::vector<std::string> received;
+    bool closed = false;
+    pair.right->start(
+        [&received](std::string_view data) { received.emplace_back(data); },
+        [&closed]() { closed = true; });
+    pair.left->start([](std::string_view) {}, []() {});
+    for (int i = 0; i < 100; i++)
+    {
+        pair.left->send(std::to_string(i));
+    }
+    ioc.poll();
+    ASSERT_EQ(received.size(), 100U);
+    EXPECT_EQ(received.front(), "0");
+    EXPECT_EQ(received.back(), "99");
+    EXPECT_FALSE(closed);
+
+    pair.left->close();
+    ioc.poll();
+    EXPECT_TRUE(closed);
+}
+
+TEST(WorkerChannel, DropsOversizedMessages)
+{
+    boost::asio::io_context ioc;
+    ChannelPair pair(ioc);
+    std::vector<std::string> received;
+    pair.right->start(
+        [&received](std::string_view data) { received.emplace_back(data); },
+        []() {});
+    pair.left->start([](std::string_view) {}, []() {});
+    pair.left->send(
+        std::string(crow::workers::Channel::maxMessageSize + 1, 'x'));
+    pair.left->send("small");
+    ioc.poll();
+    ASSERT_EQ(received.size(), 1U);
+    EXPECT_EQ(received[0], "small");
+}
+
+TEST(WorkerChannel, JoinsMessagesBiggerThanAFrame)
+{
+    boost::asio::io_context ioc;
+    ChannelPair pair(ioc);
+    std::vector<std::string> received;
+    pair.right->start(
+        [&received](std::string_view data) { received.emplace_back(data); },
+        []() {});
+    pair.left->start([](std::string_view) {}, []() {});
+    std::string big;
+    for (size_t i = 0; i < crow::workers::Channel::maxFrameSize * 3 + 5; i++)
+    {
+        big += static_cast<char>('a' + i % 26);
+    }
+    pair.left->send(std::string(big));
+    pair.left->send("after");
+    for (int i = 0; i < 10 && received.size() < 2; i++)
+    {
+        ioc.poll();
+    }
+    ASSERT_EQ(received.size(), 2U);
+    EXPECT_EQ(received[0], big);
+    EXPECT_EQ(received[1], "after");
+}
+
+TEST(WorkerPool, ChangesFromAWorkerGoToTheOthersOnly)
+{
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    FakeWorker from;
+    FakeWorker other;
+    from.send({{"type", "session"},
+               {"op", "add"},
+               {"session", sessionJson("relay1", "relay")}});
+
+    EXPECT_NE(store.getSessionByUid("relay1"), nullptr);
+    ASSERT_EQ(other.ofOp("session", "add").size(), 1U);
+    EXPECT_EQ(other.ofOp("session", "add")[0]["session"]["unique_id"],
+              "relay1");
+    // Making the change in the coordinator doesn't send it back
+    EXPECT_TRUE(from.received.empty());
+
+    from.send({{"type", "session"}, {"op", "remove"}, {"id", "relay1"}});
+    EXPECT_EQ(store.getSessionByUid("relay1"), nullptr);
+    EXPECT_EQ(other.ofOp("session", "remove").size(), 1U);
+    EXPECT_TRUE(from.received.empty());
+}
+
+TEST(WorkerPool, CoordinatorEnforcesTheSessionLimitForEveryone)
+{
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    FakeWorker from;
+    FakeWorker other;
+    for (size_t i = 0; i <= persistent_data::maxSessionsPerUser; i++)
+    {
+        from.send({{"type", "session"},
+                   {"op", "add"},
+                   {"session", sessionJson("limit" + std::to_string(i),
+                                           "limited")}});
+    }
+    EXPECT_EQ(store.getUserSessionCount("limited"),
+              persistent_data::maxSessionsPerUser);
+    EXPECT_EQ(store.getSessionByUid("limit0"), nullptr);
+    // The worker that added the session learns of the eviction as well
+    for (const FakeWorker* worker : {&from, &other})
+    {
+        std::vector<nlohmann::json> removed =
+            worker->ofOp("session", "remove");
+        ASSERT_EQ(removed.size(), 1U);
+        EXPECT_EQ(removed[0]["id"], "limit0");
+    }
+}
+
+TEST(WorkerPool, SessionSnapshotReplacesTheStore)
+{
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    store.applyChange({{"type", "session"},
+                       {"op", "add"},
+                       {"session", sessionJson("stale", "snap")}});
+    std::shared_ptr<persistent_data::UserSession> kept =
+        store.generateUserSession("snap", "127.0.0.1", "");
+    ASSERT_NE(kept, nullptr);
+    std::shared_ptr<persistent_data::UserSession> single =
+        store.generateUserSession(
+            "snap", "127.0.0.1", "",
+            persistent_data::PersistenceType::SINGLE_REQUEST);
+    ASSERT_NE(single, nullptr);
+
+    nlohmann::json snapshot = store.snapshot();
+    size_t inSnapshot = 0;
+    for (const nlohmann::json& session : snapshot["sessions"])
+    {
+        EXPECT_NE(session["unique_id"], single->uniqueId);
+        if (session["username"] == "snap")
+        {
+            inSnapshot++;
+        }
+    }
+    EXPECT_EQ(inSnapshot, 2U);
+
+    // What the coordinator doesn't have any more goes
+    store.applyChange(
+        {{"type", "session"},
+         {"op", "sync"},
+         {"sessions", nlohmann::json::array({kept->toJson(),
+                                             sessionJson("new", "snap")})},
+         {"timeout", snapshot["timeout"]},
+         {"auth_config", snapshot["auth_config"]}});
+    EXPECT_EQ(store.getSessionByUid("stale"), nullptr);
+    EXPECT_EQ(store.getSessionByUid(kept->uniqueId), kept);
+    EXPECT_NE(store.getSessionByUid("new"), nullptr);
+    // Single request sessions belong to the process serving the request
+    EXPECT_EQ(store.getSessionByUid(single->uniqueId), single);
+    store.removeSession(single);
+}
+
+TEST(WorkerPool, ForwardedEventsReachTheWorkerRingsInOrder)
+{
+    redfish::EventServiceManager& manager =
+        redfish::EventServiceManager::getInstance();
+    crow::SseEventRing& ring = manager.getSseEvents();
+    ring.keepEvents();
+    FakeWorker worker;
+
+    // The ring of the worker, in step with the coordinator's after the sync
+    crow::SseEventRing mirror;
+    mirror.keepEvents();
+    uint64_t first = manager.snapshot()["sse_next_id"];
+    mirror.renumber(first);
+
+    worker.send({{"type", "event_service"},
+                 {"op", "test_event"},
+                 {"forward", true}});
+    worker.send({{"type", "event_service"},
+                 {"op", "event"},
+                 {"message", {{"MessageId", "TaskEvent.1.0.TaskStarted"}}},
+                 {"origin", "/redfish/v1/TaskService/Tasks/0"},
+                 {"resource_type", "Task"},
+                 {"forward", true}});
+    // The worker that raised them gets them back like every other
+    std::vector<nlohmann::json> events = worker.ofOp("event_service", "sse");
+    ASSERT_EQ(events.size(), 2U);
+    for (const nlohmann::json& event : events)
+    {
+        mirror.renumber(event["id"].get<uint64_t>());
+        mirror.push({}, event["data"].get<std::string>());
+    }
+    EXPECT_EQ(events[0]["id"], first);
+    EXPECT_EQ(events[1]["id"], first + 1);
+    EXPECT_EQ(mirror.firstId(), first);
+    EXPECT_EQ(mirror.nextId(), ring.nextId());
+}
+
@@ -0,0 +1,866 @@
+#pragma once
+
+#include "logging.hpp"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+extern char** environ;
+
+namespace crow
+{
+namespace workers
+{
+
+/*
+ * Multi-process mode, enabled with the worker-processes option.
+ *
+ * The process systemd starts becomes the coordinator.  It opens the listen
+ * socket and starts the workers, which inherit it and serve HTTP.  They all
+ * accept from the one socket, so connections go to whichever worker is free;
+ * a slow or wedged worker only holds up the connections it already has, and
+ * the coordinator restarts a worker that exits or stops answering pings.
+ *
+ * The coordinator owns the persistent file and sends the events.  The state
+ * every worker needs, sessions and event subscriptions, is replicated as JSON
+ * messages over a SOCK_SEQPACKET socket pair per worker:
+ *  - publish() sends a change to the processes that haven't made it yet.  A
+ *    worker sends it to the coordinator, which makes it too and passes it on
+ *    to the other workers.
+ *  - forward() sends a message from a worker to the coordinator alone, for
+ *    work only it does, like sending events to the subscribers.  What that
+ *    work publishes goes to every worker, the one that forwarded it too.
+ * Messages are {"type": ..., ...}, and are handed to the handler registered
+ * for their type with onMessage().
+ */
+
+constexpr const char* workerEnv = "BMCWEB_WORKER";
+constexpr const char* workerFdEnv = "BMCWEB_WORKER_FD";
+constexpr const char* listenFdEnv = "BMCWEB_LISTEN_FD";
+
+using Handler = std::function<void(const nlohmann::json&)>;
+
+// One end of the socket pair between the coordinator and a worker.
+// Messages go out as one or more frames of at most maxFrameSize bytes, each
+// starting with frameMore or frameEnd, so that a snapshot of a large session
+// store isn't held back by the size of a single datagram.
+class Channel : public std::enable_shared_from_this<Channel>
+{
+  public:
+    static constexpr size_t maxFrameSize = 192 * 1024;
+    // Bigger messages are dropped
+    static constexpr size_t maxMessageSize = 16 * 1024 * 1024;
+    // A peer that leaves this many frames unread is taken as wedged
+    static constexpr size_t maxQueued = 4096;
+
+    static constexpr char frameMore = 'M';
+    static constexpr char frameEnd = 'E';
+
+    Channel(boost::asio::io_context& ioc, int fd) :
+        stream(ioc, fd), buffer(maxFrameSize)
+    {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+    Channel(Channel&&) = delete;
+    Channel& operator=(Channel&&) = delete;
+
+    ~Channel() = default;
+
+    // onClosed is called once, when the peer goes away or the channel fails
+    void start(std::function<void(std::string_view)>&& onMessageIn,
+               std::function<void()>&& onClosedIn)
+    {
+        onMessage = std::move(onMessageIn);
+        onClosed = std::move(onClosedIn);
+        waitReadable();
+    }
+
+    void send(std::string&& message)
+    {
+        if (!stream.is_open())
+        {
+            return;
+        }
+        if (message.size() > maxMessageSize)
+        {
+            BMCWEB_LOG_ERROR << "Dropping a message of " << message.size()
+                             << " bytes to another bmcweb process";
+            return;
+        }
+        bool wasIdle = outQueue.empty();
+        std::string_view rest(message);
+        do
+        {
+            if (outQueue.size() >= maxQueued)
+            {
+                BMCWEB_LOG_ERROR
+                    << "bmcweb process isn't reading its messages";
+                fail();
+                return;
+            }
+            size_t size = std::min(rest.size(), maxFrameSize - 1);
+            std::string& frame = outQueue.emplace_back();
+            frame.reserve(size + 1);
+            frame += size == rest.size() ? frameEnd : frameMore;
+            frame += rest.substr(0, size);
+            rest.remove_prefix(size);
+        } while (!rest.empty());
+        if (wasIdle)
+        {
+            flush();
+        }
+    }
+
+    void close()
+    {
+        boost::system::error_code ec;
+        stream.close(ec);
+        outQueue.clear();
+        partial.clear();
+        onMessage = nullptr;
+        onClosed = nullptr;
+    }
+
+  private:
+    void fail()
+    {
+        std::function<void()> closed = std::move(onClosed);
+        close();
+        if (closed)
+        {
+            closed();
+        }
+    }
+
+    void waitReadable()
+    {
+        stream.async_wait(
+            boost::asio::posix::stream_descriptor::wait_read,
+            [weak{weak_from_this()}](const boost::system::error_code& ec) {
+                std::shared_ptr<Channel> self = weak.lock();
+                if (self == nullptr ||
+                    ec == boost::asio::error::operation_aborted)
+                {
+                    return;
+                }
+                if (ec)
+                {
+                    self->fail();
+                    return;
+                }
+                self->readAll();
+            });
+    }
+
+    void readAll()
+    {
+        // onMessage may drop the last reference to this
+        std::shared_ptr<Channel> self = shared_from_this();
+        while (stream.is_open())
+        {
+            ssize_t got = recv(stream.native_handle(), buffer.data(),
+                               buffer.size(), MSG_DONTWAIT | MSG_TRUNC);
+            if (got == 0)
+            {
+                // Messages are never empty, this is the peer closing
+                fail();
+                return;
+            }
+            if (got < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN)
+                {
+                    break;
+                }
+                BMCWEB_LOG_ERROR << "recv from bmcweb process failed: "
+                                 << std::strerror(errno);
+                fail();
+                return;
+            }
+            if (static_cast<size_t>(got) > buffer.size())
+            {
+                BMCWEB_LOG_ERROR << "Frame of " << got
+                                 << " bytes from another bmcweb process";
+                fail();
+                return;
+            }
+            std::string_view frame(buffer.data() + 1,
+                                   static_cast<size_t>(got) - 1);
+            if (buffer[0] == frameMore)
+            {
+                if (partial.size() + frame.size() > maxMessageSize)
+                {
+                    BMCWEB_LOG_ERROR << "Message from another bmcweb process "
+                                        "is too big";
+                    fail();
+                    return;
+                }
+                partial += frame;
+                continue;
+            }
+            // onMessage may close the channel, which clears partial
+            std::string joined;
+            if (!partial.empty())
+            {
+                joined = std::move(partial);
+                partial.clear();
+                joined += frame;
+                frame = joined;
+            }
+            if (onMessage)
+            {
+                onMessage(frame);
+            }
+        }
+        if (stream.is_open())
+        {
+            waitReadable();
+        }
+    }
+
+    void flush()
+    {
+        while (!outQueue.empty())
+        {
+            const std::string& message = outQueue.front();
+            ssize_t sent = ::send(stream.native_handle(), message.data(),
+                                  message.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (sent < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN)
+                {
+                    stream.async_wait(
+                        boost::asio::posix::stream_descriptor::wait_write,
+                        [weak{weak_from_this()}](
+                            const boost::system::error_code& ec) {
+                            std::shared_ptr<Channel> self = weak.lock();
+                            if (self == nullptr || ec)
+                            {
+                                return;
+                            }
+                            self->flush();
+                        });
+                    return;
+                }
+                BMCWEB_LOG_ERROR << "send to bmcweb process failed: "
+                                 << std::strerror(errno);
+                fail();
+                return;
+            }
+            outQueue.pop_front();
+        }
+    }
+
+    boost::asio::posix::stream_descriptor stream;
+    std::vector<char> buffer;
+    std::deque<std::string> outQueue;
+    // The frames of a message that haven't all arrived yet
+    std::string partial;
+    std::function<void(std::string_view)> onMessage;
+    std::function<void()> onClosed;
+};
+
+inline int fdFromEnv(const char* name)
+{
+    const char* value = std::getenv(name);
+    if (value == nullptr)
+    {
+        return -1;
+    }
+    std::string_view text(value);
+    int fd = -1;
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), fd);
+    if (ec != std::errc() || ptr != text.data() + text.size())
+    {
+        return -1;
+    }
+    return fd;
+}
+
+class Pool
+{
+  public:
+    // A worker that hasn't answered this many pings in a row is killed
+    static constexpr std::chrono::seconds pingInterval{10};
+    static constexpr size_t maxMissedPings = 3;
+    // Restarts back off exponentially up to this, and start over once a
+    // worker has stayed up for stableTime
+    static constexpr std::chrono::seconds maxRestartDelay{30};
+    static constexpr std::chrono::seconds stableTime{60};
+
+    static Pool& getInstance()
+    {
+        static Pool pool;
+        return pool;
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    Pool(Pool&&) = delete;
+    Pool& operator=(Pool&&) = delete;
+
+    // Number of this worker, from 1.  0 for the coordinator, and when
+    // running as a single process.
+    size_t index() const
+    {
+        return workerIndex;
+    }
+
+    bool isWorker() const
+    {
+        return workerIndex != 0;
+    }
+
+    bool isCoordinator() const
+    {
+        return !workers.empty();
+    }
+
+    // The listen socket passed down by the coordinator, -1 if there is none
+    int listenFd() const
+    {
+        return inheritedListenFd;
+    }
+
+    void onMessage(const std::string& type, Handler&& handler)
+    {
+        handlers[type] = std::move(handler);
+    }
+
+    // snapshot makes a message that brings a new worker up to date.  It is
+    // sent before any other.
+    void addSnapshot(std::function<nlohmann::json()>&& snapshot)
+    {
+        snapshots.emplace_back(std::move(snapshot));
+    }
+
+    void publish(nlohmann::json&& msg)
+    {
+        // A change made on behalf of another process is already on its way
+        // to the rest
+        if (applying)
+        {
+            return;
+        }
+        publishAlways(std::move(msg));
+    }
+
+    // Like publish(), but also while making a change from another process.
+    // For what the coordinator decides on in response to one, like the
+    // sessions it drops when a new one goes over a limit.
+    void publishAlways(nlohmann::json&& msg)
+    {
+        if (coordinator != nullptr)
+        {
+            coordinator->send(msg.dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace));
+            return;
+        }
+        relay(msg, 0);
+    }
+
+    // Only has an effect in a worker
+    void forward(nlohmann::json&& msg)
+    {
+        if (coordinator == nullptr)
+        {
+            return;
+        }
+        msg["forward"] = true;
+        coordinator->send(
+            msg.dump(-1, ' ', true, nlohmann::json::error_handler_t::replace));
+    }
+
+    // Connects a worker to its coordinator.  The worker stops when the
+    // coordinator goes away.
+    void startWorker(boost::asio::io_context& ioc)
+    {
+        int fd = fdFromEnv(workerFdEnv);
+        if (fd < 0)
+        {
+            BMCWEB_LOG_CRITICAL << "Worker " << workerIndex
+                                << " has no channel to the coordinator";
+            ioc.stop();
+            return;
+        }
+        coordinator = std::make_shared<Channel>(ioc, fd);
+        coordinator->start(
+            [this](std::string_view data) {
+                nlohmann::json msg =
+                    nlohmann::json::parse(data, nullptr, false);
+                if (msg.is_discarded())
+                {
+                    BMCWEB_LOG_ERROR << "Bad message from the coordinator";
+                    return;
+                }
+                if (msg.value("type", "") == "ping")
+                {
+                    coordinator->send(R"({"type":"pong"})");
+                    return;
+                }
+                dispatch(msg);
+            },
+            [&ioc]() {
+                BMCWEB_LOG_CRITICAL << "Coordinator went away, stopping";
+                ioc.stop();
+            });
+    }
+
+    // Starts count workers sharing socket, and keeps them running.  SIGHUP
+    // is passed on to them, SIGINT and SIGTERM stop them and ioc.
+    void startCoordinator(boost::asio::io_context& ioc, size_t count,
+                          int socket)
+    {
+        io = &ioc;
+        sharedListenFd = socket;
+        workers.resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            workers[i].index = i + 1;
+            workers[i].restartTimer.emplace(ioc);
+            spawn(workers[i]);
+        }
+        signals.emplace(ioc, SIGCHLD, SIGHUP, SIGINT);
+        signals->add(SIGTERM);
+        waitForSignal();
+        pingTimer.emplace(ioc);
+        schedulePing();
+    }
+
+    // Serves a worker over fd without starting a process for it.  It
+    // isn't pinged or restarted.  The unit tests use it to stand in for a
+    // worker without forking.
+    void attachWorker(boost::asio::io_context& ioc, int fd)
+    {
+        io = &ioc;
+        Worker& worker = workers.emplace_back();
+        worker.index = workers.size();
+        connect(worker, fd);
+    }
+
+    void stopWorkers()
+    {
+        for (Worker& worker : workers)
+        {
+            if (worker.pid > 0)
+            {
+                kill(worker.pid, SIGTERM);
+            }
+        }
+    }
+
+  private:
+    struct Worker
+    {
+        size_t index = 0;
+        pid_t pid = -1;
+        std::shared_ptr<Channel> channel;
+        std::chrono::steady_clock::time_point started;
+        size_t missedPings = 0;
+        size_t restarts = 0;
+        std::optional<boost::asio::steady_timer> restartTimer;
+    };
+
+    Pool()
+    {
+        const char* index = std::getenv(workerEnv);
+        if (index != nullptr)
+        {
+            workerIndex = static_cast<size_t>(std::strtoul(index, nullptr, 10));
+            inheritedListenFd = fdFromEnv(listenFdEnv);
+        }
+    }
+
+    void dispatch(const nlohmann::json& msg)
+    {
+        const std::string* type = nullptr;
+        auto typeIt = msg.find("type");
+        if (typeIt != msg.end())
+        {
+            type = typeIt->get_ptr<const std::string*>();
+        }
+        if (type == nullptr)
+        {
+            BMCWEB_LOG_ERROR << "Message from bmcweb process has no type";
+            return;
+        }
+        auto handler = handlers.find(*type);
+        if (handler == handlers.end())
+        {
+            BMCWEB_LOG_ERROR << "No handler for " << *type << " messages";
+            return;
+        }
+        // Forwarded work is done here for the first time, so what it
+        // publishes, like the SSE events it raises, has to go out
+        applying = !msg.contains("forward");
+        try
+        {
+            handler->second(msg);
+        }
+        catch (const std::exception& e)
+        {
+            BMCWEB_LOG_ERROR << "Handling " << *type
+                             << " message failed: " << e.what();
+        }
+        applying = false;
+    }
+
+    // Sends msg to the workers other than the one numbered from
+    void relay(const nlohmann::json& msg, size_t from)
+    {
+        std::string data;
+        for (Worker& worker : workers)
+        {
+            if (worker.index == from || worker.channel == nullptr)
+            {
+                continue;
+            }
+            if (data.empty())
+            {
+                data = msg.dump(-1, ' ', true,
+                                nlohmann::json::error_handler_t::replace);
+            }
+            worker.channel->send(std::string(data));
+        }
+    }
+
+    void onWorkerMessage(Worker& worker, std::string_view data)
+    {
+        nlohmann::json msg = nlohmann::json::parse(data, nullptr, false);
+        if (msg.is_discarded())
+        {
+            BMCWEB_LOG_ERROR << "Bad message from worker " << worker.index;
+            return;
+        }
+        if (msg.value("type", "") == "pong")
+        {
+            worker.missedPings = 0;
+            return;
+        }
+        bool forwarded = msg.contains("forward");
+        dispatch(msg);
+        if (!forwarded)
+        {
+            relay(msg, worker.index);
+        }
+    }
+
+    std::vector<std::string> workerEnvironment(const Worker& worker,
+                                               int channelFd) const
+    {
+        std::vector<std::string> env;
+        for (char** var = environ; *var != nullptr; var++)
+        {
+            std::string_view entry(*var);
+            std::string_view name = entry.substr(0, entry.find('='));
+            // Only the coordinator talks to systemd
+            if (name == "NOTIFY_SOCKET" || name == "LISTEN_FDS" ||
+                name == "LISTEN_PID" || name == "LISTEN_FDNAMES" ||
+                name == workerEnv || name == workerFdEnv ||
+                name == listenFdEnv)
+            {
+                continue;
+            }
+            env.emplace_back(entry);
+        }
+        env.emplace_back(std::string(workerEnv) + "=" +
+                         std::to_string(worker.index));
+        env.emplace_back(std::string(workerFdEnv) + "=" +
+                         std::to_string(channelFd));
+        env.emplace_back(std::string(listenFdEnv) + "=" +
+                         std::to_string(sharedListenFd));
+        return env;
+    }
+
+    void spawn(Worker& worker)
+    {
+        std::array<int, 2> fds{};
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0,
+                       fds.data()) != 0)
+        {
+            BMCWEB_LOG_CRITICAL << "socketpair failed: "
+                                << std::strerror(errno);
+            scheduleRestart(worker);
+            return;
+        }
+        int sendBuffer = static_cast<int>(Channel::maxFrameSize) * 2;
+        setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendBuffer,
+                   sizeof(sendBuffer));
+        setsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &sendBuffer,
+                   sizeof(sendBuffer));
+
+        // Everything the child needs is made before fork(), after it only
+        // async signal safe calls are allowed
+        std::vector<std::string> env = workerEnvironment(worker, fds[1]);
+        std::vector<char*> envp;
+        envp.reserve(env.size() + 1);
+        for (std::string& var : env)
+        {
+            envp.push_back(var.data());
+        }
+        envp.push_back(nullptr);
+        std::string name = "bmcweb";
+        std::array<char*, 2> argv{name.data(), nullptr};
+        pid_t parent = getpid();
+        int listen = sharedListenFd;
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            BMCWEB_LOG_CRITICAL << "fork failed: " << std::strerror(errno);
+            ::close(fds[0]);
+            ::close(fds[1]);
+            scheduleRestart(worker);
+            return;
+        }
+        if (pid == 0)
+        {
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            if (getppid() != parent)
+            {
+                _exit(1);
+            }
+            // Only these are meant to outlive exec
+            fcntl(fds[1], F_SETFD, 0);
+            fcntl(listen, F_SETFD, 0);
+            execve("/proc/self/exe", argv.data(), envp.data());
+            _exit(127);
+        }
+        ::close(fds[1]);
+
+        BMCWEB_LOG_INFO << "Started worker " << worker.index << " as pid "
+                        << pid;
+        worker.pid = pid;
+        connect(worker, fds[0]);
+    }
+
+    // Brings a worker that has just started up to date, and listens to it
+    void connect(Worker& worker, int fd)
+    {
+        worker.started = std::chrono::steady_clock::now();
+        worker.missedPings = 0;
+        worker.channel = std::make_shared<Channel>(*io, fd);
+        worker.channel->start(
+            [this, &worker](std::string_view data) {
+                onWorkerMessage(worker, data);
+            },
+            [&worker]() {
+                // The process is reaped and restarted on SIGCHLD
+                BMCWEB_LOG_ERROR << "Lost the channel to worker "
+                                 << worker.index;
+                if (worker.pid > 0)
+                {
+                    kill(worker.pid, SIGKILL);
+                }
+            });
+        for (const std::function<nlohmann::json()>& snapshot : snapshots)
+        {
+            worker.channel->send(snapshot().dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace));
+        }
+    }
+
+    void scheduleRestart(Worker& worker)
+    {
+        if (std::chrono::steady_clock::now() - worker.started >= stableTime)
+        {
+            worker.restarts = 0;
+        }
+        std::chrono::seconds delay = std::min<std::chrono::seconds>(
+            std::chrono::seconds(int64_t{1}
+                                 << std::min<size_t>(worker.restarts, 5)),
+            maxRestartDelay);
+        worker.restarts++;
+        BMCWEB_LOG_ERROR << "Restarting worker " << worker.index << " in "
+                         << delay.count() << "s";
+        worker.restartTimer->expires_after(delay);
+        worker.restartTimer->async_wait(
+            [this, &worker](const boost::system::error_code& ec) {
+                if (ec || stopping)
+                {
+                    return;
+                }
+                spawn(worker);
+            });
+    }
+
+    void reapWorkers()
+    {
+        for (Worker& worker : workers)
+        {
+            if (worker.pid <= 0)
+            {
+                continue;
+            }
+            int status = 0;
+            pid_t pid = waitpid(worker.pid, &status, WNOHANG);
+            if (pid != worker.pid)
+            {
+                continue;
+            }
+            if (WIFSIGNALED(status))
+            {
+                BMCWEB_LOG_ERROR << "Worker " << worker.index
+                                 << " killed by signal " << WTERMSIG(status);
+            }
+            else
+            {
+                BMCWEB_LOG_ERROR << "Worker " << worker.index
+                                 << " exited with " << WEXITSTATUS(status);
+            }
+            worker.pid = -1;
+            if (worker.channel != nullptr)
+            {
+                worker.channel->close();
+                worker.channel = nullptr;
+            }
+            if (!stopping)
+            {
+                scheduleRestart(worker);
+            }
+        }
+    }
+
+    void waitForSignal()
+    {
+        signals->async_wait(
+            [this](const boost::system::error_code& ec, int signal) {
+                if (ec)
+                {
+                    return;
+                }
+                if (signal == SIGCHLD)
+                {
+                    reapWorkers();
+                }
+                else if (signal == SIGHUP)
+                {
+                    BMCWEB_LOG_INFO << "Passing SIGHUP on to the workers";
+                    for (Worker& worker : workers)
+                    {
+                        if (worker.pid > 0)
+                        {
+                            kill(worker.pid, SIGHUP);
+                        }
+                    }
+                }
+                else
+                {
+                    BMCWEB_LOG_INFO << "Stopping on signal " << signal;
+                    stopping = true;
+                    stopWorkers();
+                    io->stop();
+                    return;
+                }
+                waitForSignal();
+            });
+    }
+
+    void schedulePing()
+    {
+        pingTimer->expires_after(pingInterval);
+        pingTimer->async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                return;
+            }
+            for (Worker& worker : workers)
+            {
+                if (worker.channel == nullptr)
+                {
+                    continue;
+                }
+                if (worker.missedPings >= maxMissedPings)
+                {
+                    BMCWEB_LOG_CRITICAL << "Worker " << worker.index
+                                        << " stopped answering, killing it";
+                    kill(worker.pid, SIGKILL);
+                    continue;
+                }
+                worker.missedPings++;
+                worker.channel->send(R"({"type":"ping"})");
+            }
+            schedulePing();
+        });
+    }
+
+    size_t workerIndex = 0;
+    int inheritedListenFd = -1;
+    std::shared_ptr<Channel> coordinator;
+    std::unordered_map<std::string, Handler> handlers;
+    std::vector<std::function<nlohmann::json()>> snapshots;
+    bool applying = false;
+
+    // Coordinator only
+    boost::asio::io_context* io = nullptr;
+    int sharedListenFd = -1;
+    // A deque, the callbacks of each worker hold a reference to it
+    std::deque<Worker> workers;
+    std::optional<boost::asio::signal_set> signals;
+    std::optional<boost::asio::steady_timer> pingTimer;
+    bool stopping = false;
+};
+
+inline bool isWorker()
+{
+    return Pool::getInstance().isWorker();
+}
+
+inline bool isCoordinator()
+{
+    return Pool::getInstance().isCoordinator();
+}
+
+inline void publish(nlohmann::json&& msg)
+{
+    Pool::getInstance().publish(std::move(msg));
+}
+
+inline void publishAlways(nlohmann::json&& msg)
+{
+    Pool::getInstance().publishAlways(std::move(msg));
+}
+
+inline void forward(nlohmann::json&& msg)
+{
+    Pool::getInstance().forward(std::move(msg));
+}
+
+} // namespace workers
+} // namespace crow
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <logging.hpp>
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace redfish
+{
+
+/**
+ * @brief Follows a log file that is only ever appended to, like tail -F.
+ *
+ * Remembers the inode of the file and the offset of the first byte not yet
+ * consumed, so each read only touches what was appended since the last one.
+ * A different inode, or a file shorter than the offset, means the log was
+ * rotated or truncated, and the new file is read from its start.  A record
+ * whose newline hasn't been written yet is held back until it has.
+ */
+class EventLogTail
+{
+  public:
+    explicit EventLogTail(std::string pathIn) : path(std::move(pathIn))
+    {}
+
+    // Whether readAppended() would skip what was in the file before
+    // seekToEnd().  A tail that was never positioned reads the whole file.
+    bool positioned() const
+    {
+        return isPositioned;
+    }
+
+    // Skips the records already in the file.  If there is no file, the one
+    // that gets created later is read from its start.
+    void seekToEnd()
+    {
+        isPositioned = true;
+        buffer.clear();
+        consumed = 0;
+        struct stat st
+        {};
+        if (stat(path.c_str(), &st) != 0)
+        {
+            device = 0;
+            inode = 0;
+            offset = 0;
+            return;
+        }
+        device = st.st_dev;
+        inode = st.st_ino;
+        offset = st.st_size;
+    }
+
+    /**
+     * @brief Reads the complete records appended since the last call.
+     *
+     * @return The records, newline terminated.  The view stays valid until
+     * the next call.  Empty if nothing was appended, if there is no file, or
+     * on error.
+     */
+    std::string_view readAppended(std::error_code& ec)
+    {
+        buffer.erase(0, consumed);
+        consumed = 0;
+
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno != ENOENT)
+            {
+                ec = {errno, std::generic_category()};
+            }
+            return {};
+        }
+        struct stat st
+        {};
+        if (fstat(fd, &st) != 0)
+        {
+            ec = {errno, std::generic_category()};
+            close(fd);
+            return {};
+        }
+
+        if (st.st_ino != inode || st.st_dev != device || st.st_size < offset)
+        {
+            BMCWEB_LOG_DEBUG << path << " was rotated, reading from the start";
+            device = st.st_dev;
+            inode = st.st_ino;
+            offset = 0;
+            buffer.clear();
+        }
+        isPositioned = true;
+
+        size_t start = buffer.size();
+        buffer.resize(start + static_cast<size_t>(st.st_size - offset));
+        while (start < buffer.size())
+        {
+            ssize_t rc =
+                pread(fd, buffer.data() + start, buffer.size() - start, offset);
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (rc < 0)
+            {
+                ec = {errno, std::generic_category()};
+                break;
+            }
+            if (rc == 0)
+            {
+                // Truncated since the fstat, caught on the next call
+                break;
+            }
+            start += static_cast<size_t>(rc);
+            offset += rc;
+        }
+        close(fd);
+        buffer.resize(start);
+
+        size_t lastNewline = buffer.rfind('\n');
+        if (lastNewline == std::string::npos)
+        {
+            return {};
+        }
+        consumed = lastNewline + 1;
+        return std::string_view(buffer).substr(0, consumed);
+    }
+
+  private:
+    const std::string path;
+    bool isPositioned = false;
+    dev_t device = 0;
+    ino_t inode = 0;
+    // Offset of the first byte not in buffer
+    off_t offset = 0;
+    // An incomplete record held back from the last call, followed by what
+    // was read in this one
+    std::string buffer;
+    // Length of the records at the start of buffer handed out last call
+    size_t consumed = 0;
+};
+
+} // namespace redfish
@@ -14,6 +14,7 @@
 // limitations under the License.
 */
 #pragma once
+#include "event_log_tail.hpp"
 #include "metric_report.hpp"
 #include "registries.hpp"
 #include "registries/base_message_registry.hpp"
@@ -31,11 +32,15 @@
 #include <random.hpp>
 #include <server_sent_events.hpp>
 #include <utils/json_utils.hpp>
+#include <worker_pool.hpp>
 
+#include <charconv>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 
 namespace redfish
@@ -52,22 +57,21 @@ static constexpr const char* eventServiceFile =
 
 namespace message_registries
 {
-inline boost::beast::span<const MessageEntry>
-    getRegistryFromPrefix(const std::string& registryName)
+inline RegistryView getRegistryFromPrefix(std::string_view registryName)
 {
     if (task_event::header.registryPrefix == registryName)
     {
-        return boost::beast::span<const MessageEntry>(task_event::registry);
+        return {task_event::registry, task_event::registryIndex};
     }
     if (openbmc::header.registryPrefix == registryName)
     {
-        return boost::beast::span<const MessageEntry>(openbmc::registry);
+        return {openbmc::registry, openbmc::registryIndex};
     }
     if (base::header.registryPrefix == registryName)
     {
-        return boost::beast::span<const MessageEntry>(base::registry);
+        return {base::registry, base::registryIndex};
     }
-    return boost::beast::span<const MessageEntry>(openbmc::registry);
+    return {openbmc::registry, openbmc::registryIndex};
 }
 } // namespace message_registries
 
@@ -81,52 +85,41 @@ static int dirWatchDesc = -1;
 static int fileWatchDesc = -1;
 
 // <ID, timestamp, RedfishLogId, registryPrefix, MessageId, MessageArgs>
+// Apart from the ID, the fields refer to the log records they were parsed
+// from, see EventServiceManager::readEventLogsFromFile.
 using EventLogObjectsType =
-    std::tuple<std::string, std::string, std::string, std::string, std::string,
-               std::vector<std::string>>;
+    std::tuple<std::string, std::string_view, std::string_view,
+               std::string_view, std::string_view,
+               std::vector<std::string_view>>;
 
 namespace message_registries
 {
-static const Message*
-    getMsgFromRegistry(const std::string& messageKey,
-                       const boost::beast::span<const MessageEntry>& registry)
+static const Message* formatMessage(std::string_view messageID)
 {
-    boost::beast::span<const MessageEntry>::const_iterator messageIt =
-        std::find_if(registry.cbegin(), registry.cend(),
-                     [&messageKey](const MessageEntry& messageEntry) {
-                         return !messageKey.compare(messageEntry.first);
-                     });
-    if (messageIt != registry.cend())
-    {
-        return &messageIt->second;
-    }
-
-    return nullptr;
-}
-
-static const Message* formatMessage(const std::string_view& messageID)
-{
-    // Redfish MessageIds are in the form
-    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
-    // the right Message
-    std::vector<std::string> fields;
-    fields.reserve(4);
-    boost::split(fields, messageID, boost::is_any_of("."));
-    if (fields.size() != 4)
+    std::optional<MessageId> fields = parseMessageId(messageID);
+    if (!fields)
     {
         return nullptr;
     }
-    std::string& registryName = fields[0];
-    std::string& messageKey = fields[3];
 
     // Find the right registry and check it for the MessageKey
-    return getMsgFromRegistry(messageKey, getRegistryFromPrefix(registryName));
+    return getRegistryFromPrefix(fields->registryName)
+        .find(fields->messageKey);
 }
 } // namespace message_registries
 
 namespace event_log
 {
-inline bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
+// Parses a fixed-width field of the timestamp, returning false if it isn't
+// all digits
+inline bool parseTimeField(std::string_view field, int& value)
+{
+    const char* end = field.data() + field.size();
+    auto [ptr, ec] = std::from_chars(field.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+inline bool getUniqueEntryID(std::string_view logEntry, std::string& entryID,
                              const bool firstEntry = true)
 {
     static time_t prevTs = 0;
@@ -136,12 +129,20 @@ inline bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
         prevTs = 0;
     }
 
-    // Get the entry timestamp
+    // Get the entry timestamp, "%Y-%m-%dT%H:%M:%S"
     std::time_t curTs = 0;
     std::tm timeStruct = {};
-    std::istringstream entryStream(logEntry);
-    if (entryStream >> std::get_time(&timeStruct, "%Y-%m-%dT%H:%M:%S"))
+    if (logEntry.size() >= 19 && logEntry[4] == '-' && logEntry[7] == '-' &&
+        logEntry[10] == 'T' && logEntry[13] == ':' && logEntry[16] == ':' &&
+        parseTimeField(logEntry.substr(0, 4), timeStruct.tm_year) &&
+        parseTimeField(logEntry.substr(5, 2), timeStruct.tm_mon) &&
+        parseTimeField(logEntry.substr(8, 2), timeStruct.tm_mday) &&
+        parseTimeField(logEntry.substr(11, 2), timeStruct.tm_hour) &&
+        parseTimeField(logEntry.substr(14, 2), timeStruct.tm_min) &&
+        parseTimeField(logEntry.substr(17, 2), timeStruct.tm_sec))
     {
+        timeStruct.tm_year -= 1900;
+        timeStruct.tm_mon -= 1;
         curTs = std::mktime(&timeStruct);
         if (curTs == -1)
         {
@@ -162,72 +163,79 @@ inline bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
     return true;
 }
 
-inline int getEventLogParams(const std::string& logEntry,
-                             std::string& timestamp, std::string& messageID,
-                             std::vector<std::string>& messageArgs)
+// The fields refer to the storage of logEntry
+inline int getEventLogParams(std::string_view logEntry,
+                             std::string_view& timestamp,
+                             std::string_view& messageID,
+                             std::vector<std::string_view>& messageArgs)
 {
     // The redfish log format is "<Timestamp> <MessageId>,<MessageArgs>"
     // First get the Timestamp
     size_t space = logEntry.find_first_of(' ');
-    if (space == std::string::npos)
+    if (space == std::string_view::npos)
     {
         return -EINVAL;
     }
     timestamp = logEntry.substr(0, space);
     // Then get the log contents
     size_t entryStart = logEntry.find_first_not_of(' ', space);
-    if (entryStart == std::string::npos)
+    if (entryStart == std::string_view::npos)
     {
         return -EINVAL;
     }
-    std::string_view entry(logEntry);
-    entry.remove_prefix(entryStart);
-    // Use split to separate the entry into its fields
-    std::vector<std::string> logEntryFields;
-    boost::split(logEntryFields, entry, boost::is_any_of(","),
-                 boost::token_compress_on);
-    // We need at least a MessageId to be valid
-    if (logEntryFields.size() < 1)
+    std::string_view entry = logEntry.substr(entryStart);
+
+    // Separate the entry into its fields, treating a run of commas as one
+    size_t comma = entry.find(',');
+    messageID = entry.substr(0, comma);
+    messageArgs.clear();
+    if (comma == std::string_view::npos)
     {
-        return -EINVAL;
+        return 0;
     }
-    messageID = logEntryFields[0];
-
-    // Get the MessageArgs from the log if there are any
-    if (logEntryFields.size() > 1)
+    size_t argStart = entry.find_first_not_of(',', comma);
+    // If the first argument is empty, assume there are no MessageArgs
+    if (argStart == std::string_view::npos)
     {
-        std::string& messageArgsStart = logEntryFields[1];
-        // If the first string is empty, assume there are no MessageArgs
-        if (!messageArgsStart.empty())
+        return 0;
+    }
+    entry.remove_prefix(argStart);
+    while (true)
+    {
+        comma = entry.find(',');
+        messageArgs.push_back(entry.substr(0, comma));
+        if (comma == std::string_view::npos)
+        {
+            break;
+        }
+        argStart = entry.find_first_not_of(',', comma);
+        if (argStart == std::string_view::npos)
         {
-            messageArgs.assign(logEntryFields.begin() + 1,
-                               logEntryFields.end());
+            messageArgs.emplace_back();
+            break;
         }
+        entry.remove_prefix(argStart);
     }
 
     return 0;
 }
 
-inline void getRegistryAndMessageKey(const std::string& messageID,
-                                     std::string& registryName,
-                                     std::string& messageKey)
+inline void getRegistryAndMessageKey(std::string_view messageID,
+                                     std::string_view& registryName,
+                                     std::string_view& messageKey)
 {
-    // Redfish MessageIds are in the form
-    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
-    // the right Message
-    std::vector<std::string> fields;
-    fields.reserve(4);
-    boost::split(fields, messageID, boost::is_any_of("."));
-    if (fields.size() == 4)
+    std::optional<message_registries::MessageId> fields =
+        message_registries::parseMessageId(messageID);
+    if (fields)
     {
-        registryName = fields[0];
-        messageKey = fields[3];
+        registryName = fields->registryName;
+        messageKey = fields->messageKey;
     }
 }
 
 inline int formatEventLogEntry(const std::string& logEntryID,
-                               const std::string& messageID,
-                               const std::vector<std::string>& messageArgs,
+                               std::string_view messageID,
+                               const std::vector<std::string_view>& messageArgs,
                                std::string timestamp,
                                const std::string& customText,
                                nlohmann::json& logEntryJson)
@@ -246,7 +254,7 @@ inline int formatEventLogEntry(const std::string& logEntryID,
 
     // Fill the MessageArgs into the Message
     int i = 0;
-    for (const std::string& messageArg : messageArgs)
+    for (std::string_view messageArg : messageArgs)
     {
         std::string argStr = "%" + std::to_string(++i);
         size_t argPos = msg.find(argStr);
@@ -371,6 +379,59 @@ inline bool
     return true;
 }
 
+// Hashes std::string and std::string_view alike, so the sets below can be
+// searched with views into the event log
+struct StringViewHash
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view value) const
+    {
+        return std::hash<std::string_view>{}(value);
+    }
+};
+
+using StringSet =
+    std::unordered_set<std::string, StringViewHash, std::equal_to<>>;
+
+// The filters of a subscription as hashed sets, compiled when the
+// subscription is added.  An empty set matches everything.
+struct EventFilter
+{
+    StringSet registryPrefixes;
+    StringSet messageKeys;
+    StringSet resourceTypes;
+    StringSet metricReports;
+
+    static bool matches(const StringSet& wanted, std::string_view value)
+    {
+        return wanted.empty() || wanted.contains(value);
+    }
+};
+
+inline nlohmann::json makeTestEventLog(const std::string& id,
+                                       const std::string& customText)
+{
+    nlohmann::json logEntryArray;
+    logEntryArray.push_back({});
+    nlohmann::json& logEntryJson = logEntryArray.back();
+
+    logEntryJson = {
+        {"EventId", "TestID"},
+        {"EventType", "Event"},
+        {"Severity", "OK"},
+        {"Message", "Generated test event"},
+        {"MessageId", "OpenBMC.0.2.TestEventLog"},
+        {"MessageArgs", nlohmann::json::array()},
+        {"EventTimestamp", crow::utility::getDateTimeOffsetNow().first},
+        {"Context", customText}};
+
+    return {{"@odata.type", "#Event.v1_4_0.Event"},
+            {"Id", id},
+            {"Name", "Event Log"},
+            {"Events", logEntryArray}};
+}
+
 class Subscription : public persistent_data::UserSubscription
 {
   public:
@@ -387,16 +448,28 @@ class Subscription : public persistent_data::UserSubscription
         // Subscription constructor
     }
 
-    Subscription(const std::shared_ptr<boost::beast::tcp_stream>& adaptor) :
+    // An SSE stream, which sends the events in ring that match filter.
+    // lastEventId is the Last-Event-ID header of the request, if the client
+    // is reconnecting.
+    Subscription(const std::shared_ptr<boost::beast::tcp_stream>& adaptor,
+                 crow::SseEventRing& ring, crow::SseFilter&& filter,
+                 std::string_view lastEventId) :
         eventSeqNum(1)
     {
-        sseConn = std::make_shared<crow::ServerSentEvents>(adaptor);
+        sseConn = std::make_shared<crow::ServerSentEvents>(
+            adaptor, ring, std::move(filter), ring.resumeId(lastEventId));
+        ring.attach(sseConn);
     }
 
     ~Subscription() = default;
 
     void sendEvent(const std::string& msg)
     {
+        if (sseConn != nullptr)
+        {
+            // SSE streams read their events from the shared ring
+            return;
+        }
         if ((conn != nullptr) &&
             (conn->getConnState() != crow::ConnState::terminated))
         {
@@ -415,130 +488,58 @@ class Subscription : public persistent_data::UserSubscription
             conn->sendData(msg);
             this->eventSeqNum++;
         }
-        if (sseConn != nullptr)
-        {
-            sseConn->sendData(eventSeqNum, msg);
-        }
     }
 
     void sendTestEventLog()
     {
-        nlohmann::json logEntryArray;
-        logEntryArray.push_back({});
-        nlohmann::json& logEntryJson = logEntryArray.back();
-
-        logEntryJson = {
-            {"EventId", "TestID"},
-            {"EventType", "Event"},
-            {"Severity", "OK"},
-            {"Message", "Generated test event"},
-            {"MessageId", "OpenBMC.0.2.TestEventLog"},
-            {"MessageArgs", nlohmann::json::array()},
-            {"EventTimestamp", crow::utility::getDateTimeOffsetNow().first},
-            {"Context", customText}};
-
-        nlohmann::json msg = {{"@odata.type", "#Event.v1_4_0.Event"},
-                              {"Id", std::to_string(eventSeqNum)},
-                              {"Name", "Event Log"},
-                              {"Events", logEntryArray}};
-
         this->sendEvent(
-            msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
+            makeTestEventLog(std::to_string(eventSeqNum), customText)
+                .dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
     }
 
-#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-    void filterAndSendEventLogs(
-        const std::vector<EventLogObjectsType>& eventRecords)
+    // Builds compiledFilter from the filter lists of the subscription
+    void compileFilter()
     {
-        nlohmann::json logEntryArray;
-        for (const EventLogObjectsType& logEntry : eventRecords)
-        {
-            const std::string& idStr = std::get<0>(logEntry);
-            const std::string& timestamp = std::get<1>(logEntry);
-            const std::string& messageID = std::get<2>(logEntry);
-            const std::string& registryName = std::get<3>(logEntry);
-            const std::string& messageKey = std::get<4>(logEntry);
-            const std::vector<std::string>& messageArgs = std::get<5>(logEntry);
-
-            // If registryPrefixes list is empty, don't filter events
-            // send everything.
-            if (registryPrefixes.size())
-            {
-                auto obj = std::find(registryPrefixes.begin(),
-                                     registryPrefixes.end(), registryName);
-                if (obj == registryPrefixes.end())
-                {
-                    continue;
-                }
-            }
-
-            // If registryMsgIds list is empty, don't filter events
-            // send everything.
-            if (registryMsgIds.size())
-            {
-                auto obj = std::find(registryMsgIds.begin(),
-                                     registryMsgIds.end(), messageKey);
-                if (obj == registryMsgIds.end())
-                {
-                    continue;
-                }
-            }
-
-            logEntryArray.push_back({});
-            nlohmann::json& bmcLogEntry = logEntryArray.back();
-            if (event_log::formatEventLogEntry(idStr, messageID, messageArgs,
-                                               timestamp, customText,
-                                               bmcLogEntry) != 0)
-            {
-                BMCWEB_LOG_DEBUG << "Read eventLog entry failed";
-                continue;
-            }
-        }
+        compiledFilter.registryPrefixes = StringSet(registryPrefixes.begin(),
+                                                    registryPrefixes.end());
+        compiledFilter.messageKeys =
+            StringSet(registryMsgIds.begin(), registryMsgIds.end());
+        compiledFilter.resourceTypes =
+            StringSet(resourceTypes.begin(), resourceTypes.end());
+        compiledFilter.metricReports = StringSet(
+            metricReportDefinitions.begin(), metricReportDefinitions.end());
+    }
 
-        if (logEntryArray.size() < 1)
+    // logEntries are the formatted event log records this subscription
+    // wants, Context is filled in here
+    void sendEventLogs(std::vector<nlohmann::json>&& logEntries)
+    {
+        for (nlohmann::json& logEntry : logEntries)
         {
-            BMCWEB_LOG_DEBUG << "No log entries available to be transferred.";
-            return;
+            logEntry["Context"] = customText;
         }
 
         nlohmann::json msg = {{"@odata.type", "#Event.v1_4_0.Event"},
                               {"Id", std::to_string(eventSeqNum)},
                               {"Name", "Event Log"},
-                              {"Events", logEntryArray}};
+                              {"Events", std::move(logEntries)}};
 
         this->sendEvent(
             msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
     }
-#endif
 
-    void filterAndSendReports(
-        const std::string& id,
-        const std::variant<telemetry::TimestampReadings>& var)
+    // report is the MetricReport of the update, serialized once for all
+    // subscribers
+    void filterAndSendReport(const std::string& mrdUri,
+                             const std::string& report)
     {
-        std::string mrdUri = telemetry::metricReportDefinitionUri + id;
-
         // Empty list means no filter. Send everything.
-        if (metricReportDefinitions.size())
+        if (!EventFilter::matches(compiledFilter.metricReports, mrdUri))
         {
-            if (std::find(metricReportDefinitions.begin(),
-                          metricReportDefinitions.end(),
-                          mrdUri) == metricReportDefinitions.end())
-            {
-                return;
-            }
-        }
-
-        nlohmann::json msg;
-        if (!telemetry::fillReport(msg, id, var))
-        {
-            BMCWEB_LOG_ERROR << "Failed to fill the MetricReport for DBus "
-                                "Report with id "
-                             << id;
             return;
         }
 
-        this->sendEvent(
-            msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
+        this->sendEvent(report);
     }
 
     void updateRetryConfig(const uint32_t retryAttempts,
@@ -563,6 +564,8 @@ class Subscription : public persistent_data::UserSubscription
         return eventSeqNum;
     }
 
+    EventFilter compiledFilter;
+
     void setSubId(const std::string& id)
     {
         subId = id;
@@ -579,6 +582,87 @@ class Subscription : public persistent_data::UserSubscription
     std::shared_ptr<crow::ServerSentEvents> sseConn = nullptr;
 };
 
+// Event log subscriptions by the records they want, so dispatching a record
+// only looks at the subscriptions that might want it.  Those with message
+// keys are listed under each of them, those with only registry prefixes
+// under each prefix, and the rest want everything.
+class EventLogIndex
+{
+  public:
+    void clear()
+    {
+        byMessageKey.clear();
+        byRegistryPrefix.clear();
+        unfiltered.clear();
+    }
+
+    // Lists entry by its compiled filter
+    void add(const std::shared_ptr<Subscription>& entry)
+    {
+        const EventFilter& filter = entry->compiledFilter;
+        if (!filter.messageKeys.empty())
+        {
+            for (const std::string& messageKey : filter.messageKeys)
+            {
+                byMessageKey[messageKey].push_back(entry);
+            }
+        }
+        else if (!filter.registryPrefixes.empty())
+        {
+            for (const std::string& prefix : filter.registryPrefixes)
+            {
+                byRegistryPrefix[prefix].push_back(entry);
+            }
+        }
+        else
+        {
+            unfiltered.push_back(entry);
+        }
+    }
+
+    // Calls handler with each subscription that wants records of messageKey
+    // from registryPrefix, once
+    template <typename Handler>
+    void forEach(std::string_view registryPrefix, std::string_view messageKey,
+                 Handler&& handler) const
+    {
+        auto byKey = byMessageKey.find(messageKey);
+        if (byKey != byMessageKey.end())
+        {
+            for (const std::shared_ptr<Subscription>& entry : byKey->second)
+            {
+                if (EventFilter::matches(
+                        entry->compiledFilter.registryPrefixes,
+                        registryPrefix))
+                {
+                    handler(entry);
+                }
+            }
+        }
+        auto byPrefix = byRegistryPrefix.find(registryPrefix);
+        if (byPrefix != byRegistryPrefix.end())
+        {
+            for (const std::shared_ptr<Subscription>& entry : byPrefix->second)
+            {
+                handler(entry);
+            }
+        }
+        for (const std::shared_ptr<Subscription>& entry : unfiltered)
+        {
+            handler(entry);
+        }
+    }
+
+  private:
+    using SubscriptionIndex =
+        std::unordered_map<std::string,
+                           std::vector<std::shared_ptr<Subscription>>,
+                           StringViewHash, std::equal_to<>>;
+    SubscriptionIndex byMessageKey;
+    SubscriptionIndex byRegistryPrefix;
+    std::vector<std::shared_ptr<Subscription>> unfiltered;
+};
+
 class EventServiceManager
 {
   private:
@@ -593,14 +677,61 @@ class EventServiceManager
     }
 
     std::string snmpDbusId;
-    std::string lastEventTStr;
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+    EventLogTail eventLogTail{redfishEventLogFile};
+#endif
     size_t noOfEventLogSubscribers{0};
     size_t noOfMetricReportSubscribers{0};
-    std::shared_ptr<sdbusplus::bus::match::match> matchTelemetryMonitor;
+    bool metricReportListening = false;
     boost::container::flat_map<std::string, std::shared_ptr<Subscription>>
         subscriptionsMap;
 
+    // Event log subscriptions by the records they want
+    EventLogIndex eventLogIndex;
+
     uint64_t eventId{1};
+    crow::SseEventRing sseEvents;
+
+    // Renders an event once for all of the SSE streams
+    void pushSseEvent(crow::SseEvent&& event, const nlohmann::json& msg)
+    {
+        pushSseEvent(std::move(event),
+                     msg.dump(2, ' ', true,
+                              nlohmann::json::error_handler_t::replace));
+    }
+
+    // The workers keep a copy of the ring of the coordinator, for the
+    // streams they serve
+    void pushSseEvent(crow::SseEvent&& event, const std::string& data)
+    {
+        if (!crow::workers::isCoordinator())
+        {
+            sseEvents.push(std::move(event), data);
+            return;
+        }
+        nlohmann::json change = {{"format_type", event.formatType},
+                                 {"registry_prefix", event.registryPrefix},
+                                 {"message_key", event.messageKey},
+                                 {"resource_type", event.resourceType},
+                                 {"metric_report", event.metricReport},
+                                 {"data", data}};
+        change["id"] = sseEvents.push(std::move(event), data);
+        publish("sse", std::move(change));
+    }
+
+    static void publish(std::string_view op, nlohmann::json&& change)
+    {
+        change["type"] = "event_service";
+        change["op"] = op;
+        crow::workers::publish(std::move(change));
+    }
+
+    static void forward(std::string_view op, nlohmann::json&& msg)
+    {
+        msg["type"] = "event_service";
+        msg["op"] = op;
+        crow::workers::forward(std::move(msg));
+    }
 
   public:
     EventServiceManager(const EventServiceManager&) = delete;
@@ -614,6 +745,11 @@ class EventServiceManager
         return handler;
     }
 
+    crow::SseEventRing& getSseEvents()
+    {
+        return sseEvents;
+    }
+
     void initConfig()
     {
         loadOldBehavior();
@@ -629,37 +765,12 @@ class EventServiceManager
         for (const auto& it : persistent_data::EventServiceStore::getInstance()
                                   .subscriptionsConfigMap)
         {
-            std::shared_ptr<persistent_data::UserSubscription> newSub =
-                it.second;
-
-            std::string host;
-            std::string urlProto;
-            std::string port;
-            std::string path;
-            bool status = validateAndSplitUrl(newSub->destinationUrl, urlProto,
-                                              host, port, path);
-
-            if (!status)
+            std::shared_ptr<Subscription> subValue =
+                makeSubscription(*it.second);
+            if (subValue == nullptr)
             {
-                BMCWEB_LOG_ERROR
-                    << "Failed to validate and split destination url";
                 continue;
             }
-            std::shared_ptr<Subscription> subValue =
-                std::make_shared<Subscription>(host, port, path, urlProto);
-
-            subValue->id = newSub->id;
-            subValue->destinationUrl = newSub->destinationUrl;
-            subValue->protocol = newSub->protocol;
-            subValue->retryPolicy = newSub->retryPolicy;
-            subValue->customText = newSub->customText;
-            subValue->eventFormatType = newSub->eventFormatType;
-            subValue->subscriptionType = newSub->subscriptionType;
-            subValue->registryMsgIds = newSub->registryMsgIds;
-            subValue->registryPrefixes = newSub->registryPrefixes;
-            subValue->resourceTypes = newSub->resourceTypes;
-            subValue->httpHeaders = newSub->httpHeaders;
-            subValue->metricReportDefinitions = newSub->metricReportDefinitions;
 
             if (subValue->id.empty())
             {
@@ -670,9 +781,9 @@ class EventServiceManager
             updateNoOfSubscribersCount();
 
 #ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-            if (lastEventTStr.empty())
+            if (!eventLogTail.positioned())
             {
-                cacheLastEventTimestamp();
+                eventLogTail.seekToEnd();
             }
 #endif
             // Update retry configuration.
@@ -682,6 +793,88 @@ class EventServiceManager
         return;
     }
 
+    // A subscription that sends to the destination of newSub, nullptr if
+    // it isn't valid
+    std::shared_ptr<Subscription>
+        makeSubscription(const persistent_data::UserSubscription& newSub)
+    {
+        std::string host;
+        std::string urlProto;
+        std::string port;
+        std::string path;
+        bool status = validateAndSplitUrl(newSub.destinationUrl, urlProto, host,
+                                          port, path);
+
+        if (!status)
+        {
+            BMCWEB_LOG_ERROR << "Failed to validate and split destination url";
+            return nullptr;
+        }
+        std::shared_ptr<Subscription> subValue =
+            std::make_shared<Subscription>(host, port, path, urlProto);
+
+        subValue->id = newSub.id;
+        subValue->destinationUrl = newSub.destinationUrl;
+        subValue->protocol = newSub.protocol;
+        subValue->retryPolicy = newSub.retryPolicy;
+        subValue->customText = newSub.customText;
+        subValue->eventFormatType = newSub.eventFormatType;
+        subValue->subscriptionType = newSub.subscriptionType;
+        subValue->registryMsgIds = newSub.registryMsgIds;
+        subValue->registryPrefixes = newSub.registryPrefixes;
+        subValue->resourceTypes = newSub.resourceTypes;
+        subValue->httpHeaders = newSub.httpHeaders;
+        subValue->metricReportDefinitions = newSub.metricReportDefinitions;
+        return subValue;
+    }
+
+    // Adds or replaces a subscription made by another process
+    void applySubscription(const nlohmann::json& subscription)
+    {
+        std::shared_ptr<persistent_data::UserSubscription> newSub =
+            persistent_data::UserSubscription::fromJson(subscription);
+        if (newSub == nullptr)
+        {
+            return;
+        }
+        std::shared_ptr<Subscription> subValue = makeSubscription(*newSub);
+        if (subValue == nullptr)
+        {
+            return;
+        }
+        subscriptionsMap.erase(newSub->id);
+        persistent_data::EventServiceStore::getInstance()
+            .subscriptionsConfigMap.erase(newSub->id);
+        addSubscription(subValue, newSub->id);
+    }
+
+    void applySync(const nlohmann::json& sync)
+    {
+        persistent_data::EventServiceConfig cfg;
+        cfg.fromJson(sync.value("config", nlohmann::json::object()));
+        setEventServiceConfig(cfg);
+
+        std::vector<std::string> synced;
+        auto subscriptions = sync.find("subscriptions");
+        if (subscriptions != sync.end() && subscriptions->is_array())
+        {
+            for (const nlohmann::json& subscription : *subscriptions)
+            {
+                applySubscription(subscription);
+                synced.emplace_back(subscription.value("Id", ""));
+            }
+        }
+        for (const std::string& id : getAllIDs())
+        {
+            if (std::find(synced.begin(), synced.end(), id) == synced.end() &&
+                subscriptionsMap[id]->subscriptionType != "SSE")
+            {
+                deleteSubscription(id);
+            }
+        }
+        sseEvents.renumber(sync.value("sse_next_id", sseEvents.nextId()));
+    }
+
     void loadOldBehavior()
     {
         std::ifstream eventConfigFile(eventServiceFile);
@@ -771,7 +964,7 @@ class EventServiceManager
         persistent_data::EventServiceStore::getInstance()
             .eventServiceConfig.retryTimeoutInterval = retryTimeoutInterval;
 
-        persistent_data::getConfig().writeData();
+        persistent_data::getConfig().scheduleWrite();
     }
 
     void setEventServiceConfig(const persistent_data::EventServiceConfig& cfg)
@@ -810,6 +1003,7 @@ class EventServiceManager
         if (updateConfig)
         {
             updateSubscriptionData();
+            publish("config", {{"config", cfg.toJson()}});
         }
 
         if (updateRetryCfg)
@@ -824,8 +1018,25 @@ class EventServiceManager
         }
     }
 
+    void rebuildEventLogIndex()
+    {
+        eventLogIndex.clear();
+        for (const auto& it : subscriptionsMap)
+        {
+            const std::shared_ptr<Subscription>& entry = it.second;
+            entry->compileFilter();
+            if (entry->eventFormatType != eventFormatType)
+            {
+                continue;
+            }
+            eventLogIndex.add(entry);
+        }
+    }
+
     void updateNoOfSubscribersCount()
     {
+        rebuildEventLogIndex();
+
         size_t eventLogSubCount = 0;
         size_t metricReportSubCount = 0;
         for (const auto& it : subscriptionsMap)
@@ -908,6 +1119,7 @@ class EventServiceManager
             BMCWEB_LOG_ERROR << "Failed to generate random number";
             return "";
         }
+        subValue->id = id;
 
         std::shared_ptr<persistent_data::UserSubscription> newSub =
             std::make_shared<persistent_data::UserSubscription>();
@@ -934,18 +1146,43 @@ class EventServiceManager
         }
 
 #ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-        if (lastEventTStr.empty())
+        if (!eventLogTail.positioned())
         {
-            cacheLastEventTimestamp();
+            eventLogTail.seekToEnd();
         }
 #endif
         // Update retry configuration.
         subValue->updateRetryConfig(retryAttempts, retryTimeoutInterval);
         subValue->updateRetryPolicy();
 
+        if (newSub->subscriptionType != "SSE")
+        {
+            publish("subscription", {{"subscription", newSub->toJson()}});
+        }
         return id;
     }
 
+    // Saves the changes made to the subscription id
+    void updateSubscription(const std::string& id)
+    {
+        std::shared_ptr<Subscription> subValue = getSubscription(id);
+        auto persisted = persistent_data::EventServiceStore::getInstance()
+                             .subscriptionsConfigMap.find(id);
+        if (subValue == nullptr ||
+            persisted ==
+                persistent_data::EventServiceStore::getInstance()
+                    .subscriptionsConfigMap.end())
+        {
+            return;
+        }
+        persistent_data::UserSubscription& newSub = *persisted->second;
+        newSub.customText = subValue->customText;
+        newSub.retryPolicy = subValue->retryPolicy;
+        newSub.httpHeaders = subValue->httpHeaders;
+        updateSubscriptionData();
+        publish("subscription", {{"subscription", newSub.toJson()}});
+    }
+
     bool isSubscriptionExist(const std::string& id)
     {
         auto obj = subscriptionsMap.find(id);
@@ -968,9 +1205,83 @@ class EventServiceManager
                 .subscriptionsConfigMap.erase(obj2);
             updateNoOfSubscribersCount();
             updateSubscriptionData();
+            publish("delete", {{"id", id}});
+        }
+    }
+
+    // Makes a change published by another bmcweb process, or does what a
+    // worker forwarded, see worker_pool.hpp
+    void applyChange(const nlohmann::json& change)
+    {
+        std::string op = change.value("op", "");
+        if (op == "subscription")
+        {
+            applySubscription(
+                change.value("subscription", nlohmann::json::object()));
+        }
+        else if (op == "delete")
+        {
+            deleteSubscription(change.value("id", ""));
+        }
+        else if (op == "config")
+        {
+            persistent_data::EventServiceConfig cfg;
+            cfg.fromJson(change.value("config", nlohmann::json::object()));
+            setEventServiceConfig(cfg);
+        }
+        else if (op == "event")
+        {
+            sendEvent(change.value("message", nlohmann::json::object()),
+                      change.value("origin", ""),
+                      change.value("resource_type", ""));
+        }
+        else if (op == "test_event")
+        {
+            sendTestEventLog();
+        }
+        else if (op == "broadcast")
+        {
+            sendBroadcastMsg(change.value("message", ""));
+        }
+        else if (op == "sse")
+        {
+            crow::SseEvent event;
+            event.formatType = change.value("format_type", "");
+            event.registryPrefix = change.value("registry_prefix", "");
+            event.messageKey = change.value("message_key", "");
+            event.resourceType = change.value("resource_type", "");
+            event.metricReport = change.value("metric_report", "");
+            sseEvents.renumber(change.value("id", sseEvents.nextId()));
+            sseEvents.push(std::move(event), change.value("data", ""));
+        }
+        else if (op == "sync")
+        {
+            applySync(change);
         }
     }
 
+    // The subscriptions and configuration, to bring a new worker process up
+    // to date
+    nlohmann::json snapshot()
+    {
+        nlohmann::json::array_t subscriptions;
+        for (const auto& it : persistent_data::EventServiceStore::getInstance()
+                                  .subscriptionsConfigMap)
+        {
+            if (it.second->subscriptionType != "SSE")
+            {
+                subscriptions.emplace_back(it.second->toJson());
+            }
+        }
+        return {{"type", "event_service"},
+                {"op", "sync"},
+                {"config", persistent_data::EventServiceStore::getInstance()
+                               .getEventServiceConfig()
+                               .toJson()},
+                {"subscriptions", std::move(subscriptions)},
+                {"sse_next_id", sseEvents.nextId()}};
+    }
+
     size_t getNumberOfSubscriptions()
     {
         return subscriptionsMap.size();
@@ -1002,17 +1313,35 @@ class EventServiceManager
 
     void sendTestEventLog()
     {
+        if (crow::workers::isWorker())
+        {
+            forward("test_event", {});
+            return;
+        }
         for (const auto& it : this->subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
             entry->sendTestEventLog();
         }
+        if (sseEvents.inUse())
+        {
+            pushSseEvent({}, makeTestEventLog(
+                                 std::to_string(sseEvents.nextId()), ""));
+        }
     }
 
     void sendEvent(const nlohmann::json& eventMessageIn,
                    const std::string& origin, const std::string& resType)
     {
-        if (!serviceEnabled || !noOfEventLogSubscribers)
+        if (crow::workers::isWorker())
+        {
+            forward("event", {{"message", eventMessageIn},
+                              {"origin", origin},
+                              {"resource_type", resType}});
+            return;
+        }
+        if (!serviceEnabled ||
+            (!noOfEventLogSubscribers && !sseEvents.inUse()))
         {
             BMCWEB_LOG_DEBUG << "EventService disabled or no Subscriptions.";
             return;
@@ -1037,28 +1366,10 @@ class EventServiceManager
         for (const auto& it : this->subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
-            bool isSubscribed = false;
-            // Search the resourceTypes list for the subscription.
             // If resourceTypes list is empty, don't filter events
             // send everything.
-            if (entry->resourceTypes.size())
-            {
-                for (const auto& resource : entry->resourceTypes)
-                {
-                    if (resType == resource)
-                    {
-                        BMCWEB_LOG_INFO << "ResourceType " << resource
-                                        << " found in the subscribed list";
-                        isSubscribed = true;
-                        break;
-                    }
-                }
-            }
-            else // resourceTypes list is empty.
-            {
-                isSubscribed = true;
-            }
-            if (isSubscribed)
+            if (EventFilter::matches(entry->compiledFilter.resourceTypes,
+                                     resType))
             {
                 nlohmann::json msgJson = {
                     {"@odata.type", "#Event.v1_4_0.Event"},
@@ -1074,9 +1385,25 @@ class EventServiceManager
                 BMCWEB_LOG_INFO << "Not subscribed to this resource";
             }
         }
+
+        if (sseEvents.inUse())
+        {
+            crow::SseEvent sseEvent;
+            sseEvent.resourceType = resType;
+            pushSseEvent(std::move(sseEvent),
+                         {{"@odata.type", "#Event.v1_4_0.Event"},
+                          {"Name", "Event Log"},
+                          {"Id", std::to_string(sseEvents.nextId())},
+                          {"Events", eventRecord}});
+        }
     }
     void sendBroadcastMsg(const std::string& broadcastMsg)
     {
+        if (crow::workers::isWorker())
+        {
+            forward("broadcast", {{"message", broadcastMsg}});
+            return;
+        }
         for (const auto& it : this->subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
@@ -1088,63 +1415,50 @@ class EventServiceManager
             entry->sendEvent(msgJson.dump(
                 2, ' ', true, nlohmann::json::error_handler_t::replace));
         }
-    }
-
-#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-    void cacheLastEventTimestamp()
-    {
-        lastEventTStr.clear();
-        std::ifstream logStream(redfishEventLogFile);
-        if (!logStream.good())
-        {
-            BMCWEB_LOG_ERROR << " Redfish log file open failed \n";
-            return;
-        }
-        std::string logEntry;
-        while (std::getline(logStream, logEntry))
+        if (sseEvents.inUse())
         {
-            size_t space = logEntry.find_first_of(' ');
-            if (space == std::string::npos)
-            {
-                // Shouldn't enter here but lets skip it.
-                BMCWEB_LOG_DEBUG << "Invalid log entry found.";
-                continue;
-            }
-            lastEventTStr = logEntry.substr(0, space);
+            pushSseEvent(
+                {}, {{"Timestamp", crow::utility::getDateTimeOffsetNow().first},
+                     {"OriginOfCondition", "/ibm/v1/HMC/BroadcastService"},
+                     {"Name", "Broadcast Message"},
+                     {"Message", broadcastMsg}});
         }
-        BMCWEB_LOG_DEBUG << "Last Event time stamp set: " << lastEventTStr;
     }
 
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+    // Sends the records appended to the redfish event log since the last
+    // call to the subscribers, in one batch
     void readEventLogsFromFile()
     {
-        if (!serviceEnabled || !noOfEventLogSubscribers)
+        if (!serviceEnabled ||
+            (!noOfEventLogSubscribers && !sseEvents.inUse()))
         {
             BMCWEB_LOG_DEBUG << "EventService disabled or no Subscriptions.";
+            // Nobody to send them to, don't send them to later subscribers
+            // either
+            eventLogTail.seekToEnd();
             return;
         }
-        std::ifstream logStream(redfishEventLogFile);
-        if (!logStream.good())
+        std::error_code ec;
+        std::string_view logRecords = eventLogTail.readAppended(ec);
+        if (ec)
         {
-            BMCWEB_LOG_ERROR << " Redfish log file open failed";
+            BMCWEB_LOG_ERROR << " Redfish log file read failed: "
+                             << ec.message();
             return;
         }
 
+        // The records refer to logRecords, which stays valid until the next
+        // read
         std::vector<EventLogObjectsType> eventRecords;
-
-        bool startLogCollection = false;
         bool firstEntry = true;
-
-        std::string logEntry;
-        while (std::getline(logStream, logEntry))
+        while (!logRecords.empty())
         {
-            if (!startLogCollection && !lastEventTStr.empty())
-            {
-                if (boost::starts_with(logEntry, lastEventTStr))
-                {
-                    startLogCollection = true;
-                }
-                continue;
-            }
+            size_t newline = logRecords.find('\n');
+            std::string_view logEntry = logRecords.substr(0, newline);
+            logRecords.remove_prefix(
+                newline == std::string_view::npos ? logRecords.size()
+                                                  : newline + 1);
 
             std::string idStr;
             if (!event_log::getUniqueEntryID(logEntry, idStr, firstEntry))
@@ -1153,9 +1467,9 @@ class EventServiceManager
             }
             firstEntry = false;
 
-            std::string timestamp;
-            std::string messageID;
-            std::vector<std::string> messageArgs;
+            std::string_view timestamp;
+            std::string_view messageID;
+            std::vector<std::string_view> messageArgs;
             if (event_log::getEventLogParams(logEntry, timestamp, messageID,
                                              messageArgs) != 0)
             {
@@ -1163,8 +1477,8 @@ class EventServiceManager
                 continue;
             }
 
-            std::string registryName;
-            std::string messageKey;
+            std::string_view registryName;
+            std::string_view messageKey;
             event_log::getRegistryAndMessageKey(messageID, registryName,
                                                 messageKey);
             if (registryName.empty() || messageKey.empty())
@@ -1172,18 +1486,66 @@ class EventServiceManager
                 continue;
             }
 
-            lastEventTStr = timestamp;
-            eventRecords.emplace_back(idStr, timestamp, messageID, registryName,
-                                      messageKey, messageArgs);
+            eventRecords.emplace_back(std::move(idStr), timestamp, messageID,
+                                      registryName, messageKey,
+                                      std::move(messageArgs));
+        }
+        if (eventRecords.empty())
+        {
+            return;
         }
 
-        for (const auto& it : this->subscriptionsMap)
+        // Format each record once, and hand it to the subscriptions that
+        // want it.  Batches are by subscription id, so they go out in the
+        // same order every time.
+        struct Batch
         {
-            std::shared_ptr<Subscription> entry = it.second;
-            if (entry->eventFormatType == "Event")
+            std::shared_ptr<Subscription> subscription;
+            std::vector<nlohmann::json> logEntries;
+        };
+        boost::container::flat_map<std::string, Batch> batches;
+        for (const EventLogObjectsType& logEntry : eventRecords)
+        {
+            std::string_view registryName = std::get<3>(logEntry);
+            std::string_view messageKey = std::get<4>(logEntry);
+
+            nlohmann::json bmcLogEntry;
+            if (event_log::formatEventLogEntry(
+                    std::get<0>(logEntry), std::get<2>(logEntry),
+                    std::get<5>(logEntry), std::string(std::get<1>(logEntry)),
+                    "", bmcLogEntry) != 0)
             {
-                entry->filterAndSendEventLogs(eventRecords);
+                BMCWEB_LOG_DEBUG << "Read eventLog entry failed";
+                continue;
             }
+            eventLogIndex.forEach(
+                registryName, messageKey,
+                [&batches,
+                 &bmcLogEntry](const std::shared_ptr<Subscription>& entry) {
+                    Batch& batch = batches[entry->id];
+                    batch.subscription = entry;
+                    batch.logEntries.push_back(bmcLogEntry);
+                });
+
+            // One event per record, so each stream can filter them
+            if (sseEvents.inUse())
+            {
+                crow::SseEvent sseEvent;
+                sseEvent.formatType = eventFormatType;
+                sseEvent.registryPrefix = registryName;
+                sseEvent.messageKey = messageKey;
+                pushSseEvent(std::move(sseEvent),
+                             {{"@odata.type", "#Event.v1_4_0.Event"},
+                              {"Id", std::to_string(sseEvents.nextId())},
+                              {"Name", "Event Log"},
+                              {"Events", nlohmann::json::array(
+                                             {std::move(bmcLogEntry)})}});
+            }
+        }
+
+        for (auto& [id, batch] : batches)
+        {
+            batch.subscription->sendEventLogs(std::move(batch.logEntries));
         }
     }
 
@@ -1205,6 +1567,8 @@ class EventServiceManager
                     BMCWEB_LOG_ERROR << "Callback Error: " << ec.message();
                     return;
                 }
+                // Read the log once for all of the events in this wakeup
+                bool logModified = false;
                 std::size_t index = 0;
                 while ((index + iEventSize) <= bytesTransferred)
                 {
@@ -1253,10 +1617,9 @@ class EventServiceManager
                                 return;
                             }
 
-                            EventServiceManager::getInstance()
-                                .cacheLastEventTimestamp();
-                            EventServiceManager::getInstance()
-                                .readEventLogsFromFile();
+                            // The new file has a new inode, so the tail
+                            // starts over at its beginning
+                            logModified = true;
                         }
                         else if ((event.mask == IN_DELETE) ||
                                  (event.mask == IN_MOVED_TO))
@@ -1272,12 +1635,15 @@ class EventServiceManager
                     {
                         if (event.mask == IN_MODIFY)
                         {
-                            EventServiceManager::getInstance()
-                                .readEventLogsFromFile();
+                            logModified = true;
                         }
                     }
                     index += (iEventSize + event.len);
                 }
+                if (logModified)
+                {
+                    EventServiceManager::getInstance().readEventLogsFromFile();
+                }
 
                 watchRedfishEventLogFile();
             });
@@ -1323,79 +1689,62 @@ class EventServiceManager
     }
 
 #endif
-    void getReadingsForReport(sdbusplus::message::message& msg)
+    void sendMetricReport(const std::string& id,
+                          const telemetry::ReadingsRing& readings)
     {
-        sdbusplus::message::object_path path(msg.get_path());
-        std::string id = path.filename();
-        if (id.empty())
-        {
-            BMCWEB_LOG_ERROR << "Failed to get Id from path";
-            return;
-        }
-
-        std::string interface;
-        std::vector<
-            std::pair<std::string, std::variant<telemetry::TimestampReadings>>>
-            props;
-        std::vector<std::string> invalidProps;
-        msg.read(interface, props, invalidProps);
-
-        auto found =
-            std::find_if(props.begin(), props.end(),
-                         [](const auto& x) { return x.first == "Readings"; });
-        if (found == props.end())
-        {
-            BMCWEB_LOG_INFO << "Failed to get Readings from Report properties";
-            return;
-        }
+        nlohmann::json msg;
+        telemetry::fillReport(msg, id, readings);
+        std::string report =
+            msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+        std::string mrdUri = telemetry::metricReportDefinitionUri + id;
 
-        const std::variant<telemetry::TimestampReadings>& readings =
-            found->second;
-        for (const auto& it :
-             EventServiceManager::getInstance().subscriptionsMap)
+        for (const auto& it : subscriptionsMap)
         {
             Subscription& entry = *it.second.get();
             if (entry.eventFormatType == metricReportFormatType)
             {
-                entry.filterAndSendReports(id, readings);
+                entry.filterAndSendReport(mrdUri, report);
             }
         }
+
+        if (sseEvents.inUse())
+        {
+            crow::SseEvent sseEvent;
+            sseEvent.formatType = metricReportFormatType;
+            sseEvent.metricReport = std::move(mrdUri);
+            pushSseEvent(std::move(sseEvent), report);
+        }
     }
 
     void unregisterMetricReportSignal()
     {
-        if (matchTelemetryMonitor)
+        if (metricReportListening)
         {
-            BMCWEB_LOG_DEBUG << "Metrics report signal - Unregister";
-            matchTelemetryMonitor.reset();
-            matchTelemetryMonitor = nullptr;
+            BMCWEB_LOG_DEBUG << "Metrics report listener - Unregister";
+            // The store keeps watching, MetricReport GETs use it
+            telemetry::ReportStore::getInstance().setListener(nullptr);
+            metricReportListening = false;
         }
     }
 
     void registerMetricReportSignal()
     {
-        if (!serviceEnabled || matchTelemetryMonitor)
+        // The coordinator sends the reports of all processes
+        if (!serviceEnabled || metricReportListening ||
+            crow::workers::isWorker())
         {
             BMCWEB_LOG_DEBUG << "Not registering metric report signal.";
             return;
         }
 
-        BMCWEB_LOG_DEBUG << "Metrics report signal - Register";
-        std::string matchStr = "type='signal',member='PropertiesChanged',"
-                               "interface='org.freedesktop.DBus.Properties',"
-                               "arg0=xyz.openbmc_project.Telemetry.Report";
-
-        matchTelemetryMonitor = std::make_shared<sdbusplus::bus::match::match>(
-            *crow::connections::systemBus, matchStr,
-            [this](sdbusplus::message::message& msg) {
-                if (msg.is_method_error())
-                {
-                    BMCWEB_LOG_ERROR << "TelemetryMonitor Signal error";
-                    return;
-                }
-
-                getReadingsForReport(msg);
-            });
+        BMCWEB_LOG_DEBUG << "Metrics report listener - Register";
+        telemetry::ReportStore& store = telemetry::ReportStore::getInstance();
+        store.watch();
+        store.setListener([this](const std::string& id,
+                                 const telemetry::ReadingsRing& readings) {
+            sendMetricReport(id, readings);
+        });
+        metricReportListening = true;
     }
 
     bool validateAndSplitUrl(const std::string& destUrl, std::string& urlProto,
@@ -14,6 +14,15 @@
 // limitations under the License.
 */
 #pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
 namespace redfish::message_registries
 {
 struct Header
@@ -40,4 +49,110 @@ struct Message
     const char* resolution;
 };
 using MessageEntry = std::pair<const char*, const Message>;
+
+// Positions of a registry's entries, ordered by MessageKey.  Every registry
+// header defines one of these next to its registry, computed at compile time,
+// so that lookups are a binary search rather than a scan and the registry
+// itself can stay in whatever order is convenient to maintain.
+template <size_t N>
+using RegistryIndex = std::array<uint16_t, N>;
+
+template <size_t N>
+constexpr RegistryIndex<N>
+    makeRegistryIndex(const std::array<MessageEntry, N>& registry)
+{
+    static_assert(N <= UINT16_MAX, "Registry too large to index");
+    RegistryIndex<N> index{};
+    for (size_t i = 0; i < N; i++)
+    {
+        index[i] = static_cast<uint16_t>(i);
+    }
+    std::sort(index.begin(), index.end(),
+              [&registry](uint16_t left, uint16_t right) {
+                  return std::string_view(registry[left].first) <
+                         std::string_view(registry[right].first);
+              });
+    return index;
+}
+
+// A registry paired with its index
+class RegistryView
+{
+  public:
+    constexpr RegistryView() = default;
+
+    template <size_t N>
+    constexpr RegistryView(const std::array<MessageEntry, N>& registryIn,
+                           const RegistryIndex<N>& indexIn) :
+        entries(registryIn),
+        index(indexIn)
+    {}
+
+    std::span<const MessageEntry> getEntries() const
+    {
+        return entries;
+    }
+
+    const MessageEntry* findEntry(std::string_view messageKey) const
+    {
+        std::span<const uint16_t>::iterator it = std::lower_bound(
+            index.begin(), index.end(), messageKey,
+            [this](uint16_t position, std::string_view key) {
+                return std::string_view(entries[position].first) < key;
+            });
+        if (it == index.end() ||
+            std::string_view(entries[*it].first) != messageKey)
+        {
+            return nullptr;
+        }
+        return &entries[*it];
+    }
+
+    const Message* find(std::string_view messageKey) const
+    {
+        const MessageEntry* entry = findEntry(messageKey);
+        if (entry == nullptr)
+        {
+            return nullptr;
+        }
+        return &entry->second;
+    }
+
+  private:
+    std::span<const MessageEntry> entries;
+    std::span<const uint16_t> index;
+};
+
+// Redfish MessageIds are in the form
+// RegistryName.MajorVersion.MinorVersion.MessageKey
+struct MessageId
+{
+    std::string_view registryName;
+    std::string_view majorVersion;
+    std::string_view minorVersion;
+    std::string_view messageKey;
+};
+
+// Splits a MessageId into its fields without allocating.  The fields refer to
+// the storage of messageId.
+constexpr std::optional<MessageId> parseMessageId(std::string_view messageId)
+{
+    std::array<std::string_view, 4> fields;
+    for (size_t i = 0; i < fields.size() - 1; i++)
+    {
+        size_t dot = messageId.find('.');
+        if (dot == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        fields[i] = messageId.substr(0, dot);
+        messageId.remove_prefix(dot + 1);
+    }
+    if (messageId.find('.') != std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+    fields[3] = messageId;
+    return MessageId{fields[0], fields[1], fields[2], fields[3]};
+}
 } // namespace redfish::message_registries
@@ -1411,4 +1411,6 @@ constexpr std::array<MessageEntry, 93> registry = {
             "Correct the request body and resubmit the request if it failed.",
         }},
 };
+
+constexpr RegistryIndex<93> registryIndex = makeRegistryIndex(registry);
 } // namespace redfish::message_registries::base
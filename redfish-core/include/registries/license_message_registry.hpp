@@ -127,4 +127,6 @@ constexpr std::array<MessageEntry, 8> registry = {
             "Add `AuthorizedDevices` to `Links` and resubmit the request.",
         }},
 };
+
+constexpr RegistryIndex<8> registryIndex = makeRegistryIndex(registry);
 } // namespace redfish::message_registries::license
@@ -2447,4 +2447,6 @@ constexpr std::array<MessageEntry, 190> registry = {
         }},
 
 };
+
+constexpr RegistryIndex<190> registryIndex = makeRegistryIndex(registry);
 } // namespace redfish::message_registries::openbmc
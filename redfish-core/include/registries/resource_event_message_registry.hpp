@@ -293,4 +293,6 @@ constexpr std::array<MessageEntry, 19> registry = {
             "None.",
         }},
 };
+
+constexpr RegistryIndex<19> registryIndex = makeRegistryIndex(registry);
 } // namespace redfish::message_registries::resource_event
@@ -136,4 +136,6 @@ constexpr std::array<MessageEntry, 9> registry = {
                      "None.",
                  }},
 };
+
+constexpr RegistryIndex<9> registryIndex = makeRegistryIndex(registry);
 } // namespace redfish::message_registries::task_event
@@ -18,21 +18,187 @@
 
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core/span.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/http/buffer_body.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/write.hpp>
 #include <boost/beast/version.hpp>
+#include <logging.hpp>
 
+#include <algorithm>
+#include <charconv>
 #include <cstdlib>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <memory>
-#include <queue>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace crow
 {
 
-static constexpr uint8_t maxReqQueueSize = 50;
+// An event kept for the SSE streams.  The tags say which streams want it, an
+// empty tag matches every stream.
+struct SseEvent
+{
+    uint64_t id = 0;
+    std::string formatType;
+    std::string registryPrefix;
+    std::string messageKey;
+    std::string resourceType;
+    std::string metricReport;
+    // The event as it goes on the wire, "id: <id>\ndata: ...\n\n"
+    std::string framed;
+};
+
+// Which events a stream sends, from the SSE filter query.  An empty list
+// matches everything.
+struct SseFilter
+{
+    std::string formatType;
+    std::vector<std::string> registryPrefixes;
+    std::vector<std::string> messageKeys;
+    std::vector<std::string> resourceTypes;
+    std::vector<std::string> metricReports;
+
+    bool matches(const SseEvent& event) const
+    {
+        return tagMatches(formatType, event.formatType) &&
+               tagMatches(registryPrefixes, event.registryPrefix) &&
+               tagMatches(messageKeys, event.messageKey) &&
+               tagMatches(resourceTypes, event.resourceType) &&
+               tagMatches(metricReports, event.metricReport);
+    }
+
+  private:
+    static bool tagMatches(const std::string& wanted, const std::string& tag)
+    {
+        return wanted.empty() || tag.empty() || wanted == tag;
+    }
+
+    static bool tagMatches(const std::vector<std::string>& wanted,
+                           const std::string& tag)
+    {
+        return wanted.empty() || tag.empty() ||
+               std::find(wanted.begin(), wanted.end(), tag) != wanted.end();
+    }
+};
+
+class ServerSentEvents;
+
+/**
+ * @brief The most recent events, numbered in the order they were sent, that
+ * every SSE stream reads from.
+ *
+ * An event is framed once when it is pushed, and each stream only keeps the
+ * id of the next event it hasn't looked at.  Events are kept after they have
+ * been sent, so a client that reconnects with the id of the last event it
+ * got in Last-Event-ID is sent the ones it missed.  When the ring has
+ * dropped some of those, the stream says so before it carries on.
+ */
+class SseEventRing
+{
+  public:
+    static constexpr size_t maxEvents = 256;
+    static constexpr size_t maxBytes = 1024 * 1024;
+
+    SseEventRing() = default;
+
+    SseEventRing(const SseEventRing&) = delete;
+    SseEventRing& operator=(const SseEventRing&) = delete;
+    SseEventRing(SseEventRing&&) = delete;
+    SseEventRing& operator=(SseEventRing&&) = delete;
+
+    // Id the next event pushed gets
+    uint64_t nextId() const
+    {
+        return nextEventId;
+    }
+
+    // Id of the oldest event still kept, nextId() if there is none
+    uint64_t firstId() const
+    {
+        return nextEventId - events.size();
+    }
+
+    // Returns nullptr if the event was dropped or hasn't been pushed yet
+    std::shared_ptr<const SseEvent> get(uint64_t id) const
+    {
+        if (id < firstId() || id >= nextEventId)
+        {
+            return nullptr;
+        }
+        return events[static_cast<size_t>(id - firstId())];
+    }
+
+    // Whether a stream was ever attached.  Events are only worth keeping
+    // from then on, for that stream or for one that reconnects.
+    bool inUse() const
+    {
+        return everAttached;
+    }
+
+    // Numbers and frames data, keeps it, and wakes up the streams.  Returns
+    // the id of the event.
+    uint64_t push(SseEvent&& event, std::string_view data);
+
+    // For a ring that is mirrored by those of other processes, which need
+    // the events whether or not a stream is attached here
+    void keepEvents()
+    {
+        everAttached = true;
+    }
+
+    // Numbers the events pushed from now on from id, for a ring mirroring
+    // the one of another process.  If the numbering jumps, the events kept
+    // are dropped, and the streams report the ones that never got here.
+    void renumber(uint64_t id)
+    {
+        if (id == nextEventId)
+        {
+            return;
+        }
+        events.clear();
+        totalBytes = 0;
+        nextEventId = id;
+    }
+
+    void attach(const std::shared_ptr<ServerSentEvents>& stream)
+    {
+        everAttached = true;
+        streams.emplace_back(stream);
+    }
+
+    // The id of the first event to send to a client, given the
+    // Last-Event-ID it sent.  Without one, the client only gets new events.
+    // An id this ring never handed out comes from before a restart; the
+    // stream then reports everything before the oldest event as missed.
+    uint64_t resumeId(std::string_view lastEventId) const
+    {
+        if (lastEventId.empty())
+        {
+            return nextEventId;
+        }
+        uint64_t lastId = 0;
+        const char* end = lastEventId.data() + lastEventId.size();
+        auto [ptr, ec] = std::from_chars(lastEventId.data(), end, lastId);
+        if (ec != std::errc() || ptr != end || lastId >= nextEventId)
+        {
+            BMCWEB_LOG_DEBUG << "Unknown Last-Event-ID " << lastEventId;
+            return 0;
+        }
+        return lastId + 1;
+    }
+
+  private:
+    std::deque<std::shared_ptr<const SseEvent>> events;
+    size_t totalBytes = 0;
+    uint64_t nextEventId = 1;
+    bool everAttached = false;
+    std::vector<std::weak_ptr<ServerSentEvents>> streams;
+};
 
 enum class SseConnState
 {
@@ -51,43 +217,64 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
 {
   private:
     std::shared_ptr<boost::beast::tcp_stream> sseConn;
-    std::queue<std::pair<uint64_t, std::string>> requestDataQueue;
-    std::string outBuffer;
+    SseEventRing& ring;
+    SseFilter filter;
+    // Id of the next event in the ring to look at
+    uint64_t cursor;
+    // The event being written, kept in case the ring drops it meanwhile
+    std::shared_ptr<const SseEvent> inFlight;
+    // Gap notices aren't in the ring
+    std::string notice;
+    // What is left to write of inFlight or notice
+    std::string_view outBuffer;
     SseConnState state;
     int retryCount;
     int maxRetryAttempts;
 
-    void sendEvent(const std::string& id, const std::string& msg)
+    // Points outBuffer at the next thing to send, returns false if there is
+    // nothing
+    bool nextEvent()
     {
-        if (msg.empty())
+        uint64_t firstId = ring.firstId();
+        if (cursor < firstId)
         {
-            BMCWEB_LOG_DEBUG << "Empty data, bailing out.";
-            return;
+            BMCWEB_LOG_ERROR << "SSE events " << cursor << " to "
+                             << firstId - 1 << " were dropped";
+            notice = "event: gap\ndata: {\"FirstMissedId\": \"" +
+                     std::to_string(cursor) + "\", \"LastMissedId\": \"" +
+                     std::to_string(firstId - 1) + "\"}\n\n";
+            cursor = firstId;
+            inFlight = nullptr;
+            outBuffer = notice;
+            return true;
         }
-
-        if (state == SseConnState::sendInProgress)
+        while (std::shared_ptr<const SseEvent> event = ring.get(cursor))
         {
-            return;
+            cursor++;
+            if (filter.matches(*event))
+            {
+                inFlight = std::move(event);
+                outBuffer = inFlight->framed;
+                return true;
+            }
         }
-        state = SseConnState::sendInProgress;
+        return false;
+    }
 
-        if (!id.empty())
+    void sendEvent()
+    {
+        if (state == SseConnState::sendInProgress)
         {
-            outBuffer += "id: ";
-            outBuffer.append(id.begin(), id.end());
-            outBuffer += "\n";
+            return;
         }
-
-        outBuffer += "data: ";
-        for (char character : msg)
+        // A write that failed half way is carried on from where it stopped
+        if (outBuffer.empty() && !nextEvent())
         {
-            outBuffer += character;
-            if (character == '\n')
-            {
-                outBuffer += "data: ";
-            }
+            BMCWEB_LOG_DEBUG << "No events for this stream.";
+            state = SseConnState::idle;
+            return;
         }
-        outBuffer += "\n\n";
+        state = SseConnState::sendInProgress;
 
         doWrite();
     }
@@ -97,9 +284,8 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
         if (outBuffer.empty())
         {
             BMCWEB_LOG_DEBUG << "All data sent successfully.";
-            // Send is successful, Lets remove data from queue
-            // check for next request data in queue.
-            requestDataQueue.pop();
+            // Send is successful, check for the next event in the ring.
+            inFlight = nullptr;
             state = SseConnState::idle;
             checkQueue();
             return;
@@ -110,13 +296,14 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
             [self(shared_from_this())](
                 boost::beast::error_code ec,
                 [[maybe_unused]] const std::size_t& bytesTransferred) {
-                self->outBuffer.erase(0, bytesTransferred);
+                self->outBuffer.remove_prefix(bytesTransferred);
 
                 if (ec == boost::asio::error::eof)
                 {
-                    // Send is successful, Lets remove data from queue
-                    // check for next request data in queue.
-                    self->requestDataQueue.pop();
+                    // Send is successful, check for the next event in the
+                    // ring.
+                    self->outBuffer = {};
+                    self->inFlight = nullptr;
                     self->state = SseConnState::idle;
                     self->checkQueue();
                     return;
@@ -136,7 +323,6 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
                 self->doWrite();
             });
     }
-
     void startSSE()
     {
         if (state == SseConnState::initInProgress)
@@ -183,9 +369,9 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
 
     void checkQueue(const bool newRecord = false)
     {
-        if (requestDataQueue.empty())
+        if (outBuffer.empty() && cursor >= ring.nextId())
         {
-            BMCWEB_LOG_DEBUG << "requestDataQueue is empty\n";
+            BMCWEB_LOG_DEBUG << "No new events in the ring";
             return;
         }
 
@@ -193,11 +379,10 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
         {
             BMCWEB_LOG_ERROR << "Maximum number of retries is reached.";
 
-            // Clear queue.
-            while (!requestDataQueue.empty())
-            {
-                requestDataQueue.pop();
-            }
+            // Skip what was pending.
+            outBuffer = {};
+            inFlight = nullptr;
+            cursor = ring.nextId();
 
             // TODO: Take 'DeliveryRetryPolicy' action.
             // For now, doing 'SuspendRetries' action.
@@ -211,8 +396,8 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
             if (newRecord)
             {
                 // We are already running async wait and retry.
-                // Since record is added to queue, it gets the
-                // turn in FIFO.
+                // Since the new event is in the ring, it gets its
+                // turn in order.
                 return;
             }
 
@@ -243,9 +428,7 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
             case SseConnState::idle:
             case SseConnState::sendFailed:
             {
-                std::pair<uint64_t, std::string> reqData =
-                    requestDataQueue.front();
-                sendEvent(std::to_string(reqData.first), reqData.second);
+                sendEvent();
                 break;
             }
         }
@@ -259,32 +442,67 @@ class ServerSentEvents : public std::enable_shared_from_this<ServerSentEvents>
     ServerSentEvents(ServerSentEvents&&) = delete;
     ServerSentEvents& operator=(ServerSentEvents&&) = delete;
 
-    ServerSentEvents(const std::shared_ptr<boost::beast::tcp_stream>& adaptor) :
-        sseConn(adaptor), state(SseConnState::startInit), retryCount(0),
-        maxRetryAttempts(5)
+    // Sends the events in ring from startId on that match filterIn.  The
+    // stream has to be attached to the ring to hear about new events.
+    ServerSentEvents(const std::shared_ptr<boost::beast::tcp_stream>& adaptor,
+                     SseEventRing& ringIn, SseFilter&& filterIn,
+                     uint64_t startId) :
+        sseConn(adaptor),
+        ring(ringIn), filter(std::move(filterIn)), cursor(startId),
+        state(SseConnState::startInit), retryCount(0), maxRetryAttempts(5)
     {
         startSSE();
     }
 
     ~ServerSentEvents() = default;
 
-    void sendData(const uint64_t& id, const std::string& data)
+    // Called by the ring when an event was pushed
+    void onNewEvent()
     {
         if (state == SseConnState::suspended)
         {
             return;
         }
+        checkQueue(true);
+    }
+};
 
-        if (requestDataQueue.size() <= maxReqQueueSize)
+inline uint64_t SseEventRing::push(SseEvent&& event, std::string_view data)
+{
+    uint64_t id = nextEventId++;
+    event.id = id;
+    event.framed = "id: " + std::to_string(event.id) + "\ndata: ";
+    for (char character : data)
+    {
+        event.framed += character;
+        if (character == '\n')
         {
-            requestDataQueue.push(std::pair(id, data));
-            checkQueue(true);
+            event.framed += "data: ";
         }
-        else
+    }
+    event.framed += "\n\n";
+
+    totalBytes += event.framed.size();
+    events.emplace_back(std::make_shared<const SseEvent>(std::move(event)));
+    while (events.size() > maxEvents ||
+           (totalBytes > maxBytes && events.size() > 1))
+    {
+        totalBytes -= events.front()->framed.size();
+        events.pop_front();
+    }
+
+    for (auto it = streams.begin(); it != streams.end();)
+    {
+        std::shared_ptr<ServerSentEvents> stream = it->lock();
+        if (stream == nullptr)
         {
-            BMCWEB_LOG_ERROR << "Request queue is full. So ignoring data.";
+            it = streams.erase(it);
+            continue;
         }
+        stream->onNewEvent();
+        it++;
     }
-};
+    return id;
+}
 
 } // namespace crow
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "http_utility.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace redfish
+{
+
+namespace immutable_response
+{
+
+// A document that never changes once bmcweb has started, kept fully
+// serialized so that serving it is a copy rather than building and dumping
+// the JSON again
+struct Document
+{
+    std::string body;
+    std::string etag;
+};
+
+inline std::unordered_map<std::string, Document>& getCache()
+{
+    static std::unordered_map<std::string, Document> cache;
+    return cache;
+}
+
+inline std::string makeEtag(std::string_view body)
+{
+    std::array<char, 19> buf{};
+    std::snprintf(buf.data(), buf.size(), "\"%016zx\"",
+                  std::hash<std::string_view>{}(body));
+    return {buf.data()};
+}
+
+// Returns the cached document for key, calling build to create it the first
+// time.  Only use this for a bounded set of keys whose content can't change.
+inline const Document&
+    getDocument(const std::string& key,
+                const std::function<nlohmann::json()>& build)
+{
+    std::unordered_map<std::string, Document>& cache = getCache();
+    auto it = cache.find(key);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+    Document doc;
+    // Same formatting as Connection::completeRequest
+    doc.body = build().dump(2, ' ', true,
+                            nlohmann::json::error_handler_t::replace);
+    doc.etag = makeEtag(doc.body);
+    return cache.emplace(key, std::move(doc)).first->second;
+}
+
+// Fills res with the immutable document stored under key.  Clients that
+// already hold it get a 304 through If-None-Match.  Clients that prefer HTML
+// get the JSON parsed back from the body, which the connection renders as
+// usual.
+inline void send(const crow::Request& req, crow::Response& res,
+                 const std::string& key,
+                 const std::function<nlohmann::json()>& build)
+{
+    const Document& doc = getDocument(key, build);
+    res.addHeader(boost::beast::http::field::etag, doc.etag);
+    if (http_helpers::ifNoneMatchMatches(
+            req.getHeaderValue(boost::beast::http::field::if_none_match),
+            doc.etag))
+    {
+        res.result(boost::beast::http::status::not_modified);
+        return;
+    }
+    if (http_helpers::requestPrefersHtml(req.getHeaderValue("Accept")))
+    {
+        res.jsonValue = nlohmann::json::parse(doc.body, nullptr, false);
+        return;
+    }
+    res.addHeader("Content-Type", "application/json");
+    res.body() = doc.body;
+}
+
+} // namespace immutable_response
+} // namespace redfish
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <utility.hpp>
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace redfish
+{
+
+namespace telemetry
+{
+
+using Readings =
+    std::vector<std::tuple<std::string, std::string, double, uint64_t>>;
+using TimestampReadings = std::tuple<uint64_t, Readings>;
+
+/**
+ * @brief The last readings of a metric report, kept column by column.
+ *
+ * The metric ids and metadata of a report don't change from one update to
+ * the next, so they are kept once.  An update only adds its timestamp, and a
+ * value and a timestamp per metric, to fixed size columns that wrap around
+ * once maxUpdates updates are kept.  A report whose metrics change starts
+ * over.
+ */
+class ReadingsRing
+{
+  public:
+    static constexpr size_t maxUpdates = 32;
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    // Timestamp of the newest update, 0 if there is none
+    uint64_t timestamp() const
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+        return reportTimestamps[slot(count - 1)];
+    }
+
+    void push(const TimestampReadings& update)
+    {
+        const auto& [reportTimestamp, readings] = update;
+        if (!sameMetrics(readings))
+        {
+            metricIds.clear();
+            metricProperties.clear();
+            for (const auto& [id, metadata, value, valueTimestamp] : readings)
+            {
+                metricIds.push_back(id);
+                metricProperties.push_back(metadata);
+            }
+            values.assign(maxUpdates * readings.size(), 0.0);
+            valueTimestamps.assign(maxUpdates * readings.size(), 0);
+            head = 0;
+            count = 0;
+        }
+
+        // The same readings delivered twice, by a signal and by a Get
+        if (count != 0 && timestamp() == reportTimestamp)
+        {
+            count--;
+        }
+        if (count == maxUpdates)
+        {
+            head = (head + 1) % maxUpdates;
+            count--;
+        }
+
+        size_t row = slot(count);
+        reportTimestamps[row] = reportTimestamp;
+        size_t column = 0;
+        for (const auto& [id, metadata, value, valueTimestamp] : readings)
+        {
+            values[row * metricIds.size() + column] = value;
+            valueTimestamps[row * metricIds.size() + column] = valueTimestamp;
+            column++;
+        }
+        count++;
+    }
+
+    /**
+     * @brief The MetricValues of a MetricReport.
+     *
+     * Without since, those of the newest update.  With it, every value kept
+     * that is newer than since, oldest first, so a client that polls can
+     * ask for what it hasn't seen.
+     */
+    nlohmann::json metricValues(std::optional<uint64_t> since) const
+    {
+        nlohmann::json metricValues = nlohmann::json::array_t();
+        if (count == 0)
+        {
+            return metricValues;
+        }
+        size_t first = since ? 0 : count - 1;
+        for (size_t age = first; age < count; age++)
+        {
+            size_t row = slot(age);
+            for (size_t column = 0; column < metricIds.size(); column++)
+            {
+                uint64_t valueTimestamp =
+                    valueTimestamps[row * metricIds.size() + column];
+                if (since && valueTimestamp <= *since)
+                {
+                    continue;
+                }
+                metricValues.push_back(
+                    {{"MetricId", metricIds[column]},
+                     {"MetricProperty", metricProperties[column]},
+                     {"MetricValue",
+                      std::to_string(values[row * metricIds.size() + column])},
+                     {"Timestamp", crow::utility::getDateTime(
+                                       static_cast<time_t>(valueTimestamp))}});
+            }
+        }
+        return metricValues;
+    }
+
+  private:
+    // Row of the update age updates after the oldest one kept
+    size_t slot(size_t age) const
+    {
+        return (head + age) % maxUpdates;
+    }
+
+    bool sameMetrics(const Readings& readings) const
+    {
+        if (readings.size() != metricIds.size())
+        {
+            return false;
+        }
+        size_t column = 0;
+        for (const auto& [id, metadata, value, valueTimestamp] : readings)
+        {
+            if (id != metricIds[column] || metadata != metricProperties[column])
+            {
+                return false;
+            }
+            column++;
+        }
+        return true;
+    }
+
+    std::vector<std::string> metricIds;
+    std::vector<std::string> metricProperties;
+    std::array<uint64_t, maxUpdates> reportTimestamps{};
+    // maxUpdates rows of one column per metric
+    std::vector<double> values;
+    std::vector<uint64_t> valueTimestamps;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+} // namespace telemetry
+} // namespace redfish
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <boost/container/flat_map.hpp>
+#include <dbus_singleton.hpp>
+#include <dbus_utility.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace redfish
+{
+
+/**
+ * @brief Collects the D-Bus properties an aggregate resource needs, fetches
+ * them with as few calls as possible, and lets the resource render once
+ * everything has arrived.
+ *
+ * Handlers register the service, path and interface they read.  All of the
+ * interfaces read from one object are fetched by a single GetAll with an
+ * empty interface name, which sd-bus answers with the properties of every
+ * interface on the object.  If the service refuses that, the plan falls back
+ * to one GetAll per interface.  Each handler gets the error code and the
+ * property map of the call that served it, so property names read from the
+ * same object must not repeat across its interfaces.  Completion callbacks
+ * run after the last reply has been delivered to its handlers, which is
+ * where values that depend on more than one interface are rendered.
+ *
+ * The GetAll calls are coalesced with identical calls from other requests,
+ * see dbus::utility::coalescedMethodCall.
+ */
+class PropertyPlan : public std::enable_shared_from_this<PropertyPlan>
+{
+  public:
+    using Handler =
+        std::function<void(const boost::system::error_code&,
+                           const dbus::utility::DBusPropertiesMap&)>;
+
+    PropertyPlan() = default;
+
+    PropertyPlan(const PropertyPlan&) = delete;
+    PropertyPlan(PropertyPlan&&) = delete;
+    PropertyPlan& operator=(const PropertyPlan&) = delete;
+    PropertyPlan& operator=(PropertyPlan&&) = delete;
+
+    ~PropertyPlan()
+    {
+        for (const std::function<void()>& completion : completions)
+        {
+            completion();
+        }
+    }
+
+    // Must be called before run()
+    void add(const std::string& service, const std::string& path,
+             const std::string& interface, Handler&& handler)
+    {
+        objects[std::make_pair(service, path)][interface].emplace_back(
+            std::move(handler));
+    }
+
+    void addCompletion(std::function<void()>&& completion)
+    {
+        completions.emplace_back(std::move(completion));
+    }
+
+    // The number of calls run() sends when every service takes the empty
+    // interface name
+    size_t callCount() const
+    {
+        return objects.size();
+    }
+
+    // Sends one GetAll per object.  Every reply holds a reference to the
+    // plan, so the completions run when the last one has been handled.
+    void run()
+    {
+        for (const auto& object : objects)
+        {
+            const auto& [service, path] = object.first;
+            if (object.second.size() == 1)
+            {
+                getInterface(service, path, *object.second.begin());
+                continue;
+            }
+            BMCWEB_LOG_DEBUG << "PropertyPlan GetAll of "
+                             << object.second.size() << " interfaces on "
+                             << path;
+            dbus::utility::coalescedMethodCall<
+                dbus::utility::DBusPropertiesMap>(
+                [self{shared_from_this()}, toNotify{&object}](
+                    const boost::system::error_code ec,
+                    const dbus::utility::DBusPropertiesMap& properties) {
+                    const auto& [service, path] = toNotify->first;
+                    if (ec)
+                    {
+                        BMCWEB_LOG_DEBUG << "GetAll of all interfaces on "
+                                         << path << " failed: " << ec
+                                         << ", asking for each one";
+                        for (const auto& interface : toNotify->second)
+                        {
+                            self->getInterface(service, path, interface);
+                        }
+                        return;
+                    }
+                    for (const auto& interface : toNotify->second)
+                    {
+                        for (const Handler& handler : interface.second)
+                        {
+                            handler(ec, properties);
+                        }
+                    }
+                },
+                service, path, "org.freedesktop.DBus.Properties", "GetAll",
+                std::string());
+        }
+    }
+
+  private:
+    using InterfaceHandlers =
+        boost::container::flat_map<std::string, std::vector<Handler>>;
+
+    void getInterface(const std::string& service, const std::string& path,
+                      const InterfaceHandlers::value_type& interface)
+    {
+        BMCWEB_LOG_DEBUG << "PropertyPlan GetAll " << interface.first
+                         << " on " << path << " for "
+                         << interface.second.size() << " handler(s)";
+        dbus::utility::coalescedMethodCall<dbus::utility::DBusPropertiesMap>(
+            [self{shared_from_this()}, toNotify{&interface.second}](
+                const boost::system::error_code ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
+                for (const Handler& handler : *toNotify)
+                {
+                    handler(ec, properties);
+                }
+            },
+            service, path, "org.freedesktop.DBus.Properties", "GetAll",
+            interface.first);
+    }
+
+    // Keyed by service and path, then by interface
+    boost::container::flat_map<std::pair<std::string, std::string>,
+                               InterfaceHandlers>
+        objects;
+    std::vector<std::function<void()>> completions;
+};
+
+} // namespace redfish
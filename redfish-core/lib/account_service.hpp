@@ -1083,8 +1083,7 @@ inline void
 
     persistent_data::SessionStore::getInstance().updateAuthMethodsConfig(
         authMethodsConfig);
-    // Save configuration immediately
-    persistent_data::getConfig().writeData();
+    persistent_data::getConfig().scheduleWrite();
 
     messages::success(asyncResp->res);
 }
@@ -745,17 +745,9 @@ inline void requestRoutesEventDestinationCollection(App& app)
                         // Check for Message ID in each of the selected Registry
                         for (const std::string& it : registryPrefix)
                         {
-                            const boost::beast::span<
-                                const redfish::message_registries::MessageEntry>
-                                registry = redfish::message_registries::
-                                    getRegistryFromPrefix(it);
-
-                            if (std::any_of(
-                                    registry.cbegin(), registry.cend(),
-                                    [&id](const redfish::message_registries::
-                                              MessageEntry& messageEntry) {
-                                        return !id.compare(messageEntry.first);
-                                    }))
+                            if (redfish::message_registries::
+                                    getRegistryFromPrefix(it)
+                                        .findEntry(id) != nullptr)
                             {
                                 validId = true;
                                 break;
@@ -972,7 +964,7 @@ inline void requestRoutesEventDestination(App& app)
                     subValue->updateRetryPolicy();
                 }
 
-                EventServiceManager::getInstance().updateSubscriptionData();
+                EventServiceManager::getInstance().updateSubscription(param);
             });
     BMCWEB_ROUTE(app, "/redfish/v1/EventService/Subscriptions/<str>/")
         // The below privilege is wrong, it should be ConfigureManager OR
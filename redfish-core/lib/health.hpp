@@ -21,6 +21,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/container/flat_set.hpp>
 #include <dbus_singleton.hpp>
+#include <dbus_utility.hpp>
 
 #include <variant>
 
@@ -178,15 +179,15 @@ struct HealthPopulate : std::enable_shared_from_this<HealthPopulate>
     void getGlobalPath()
     {
         std::shared_ptr<HealthPopulate> self = shared_from_this();
-        crow::connections::systemBus->async_method_call(
+        dbus::utility::coalescedMethodCall<std::vector<std::string>>(
             [self](const boost::system::error_code ec,
-                   std::vector<std::string>& resp) {
+                   const std::vector<std::string>& resp) {
                 if (ec || resp.size() != 1)
                 {
                     // no global item, or too many
                     return;
                 }
-                self->globalInventoryPath = std::move(resp[0]);
+                self->globalInventoryPath = resp[0];
             },
             "xyz.openbmc_project.ObjectMapper",
             "/xyz/openbmc_project/object_mapper",
@@ -198,24 +199,21 @@ struct HealthPopulate : std::enable_shared_from_this<HealthPopulate>
     void getAllStatusAssociations()
     {
         std::shared_ptr<HealthPopulate> self = shared_from_this();
-        crow::connections::systemBus->async_method_call(
+        dbus::utility::coalescedMethodCall<dbus::utility::ManagedObjectType>(
             [self](const boost::system::error_code ec,
-                   dbus::utility::ManagedObjectType& resp) {
+                   const dbus::utility::ManagedObjectType& resp) {
                 if (ec)
                 {
                     return;
                 }
-                for (auto it = resp.begin(); it != resp.end();)
+                for (const auto& object : resp)
                 {
-                    if (boost::ends_with(it->first.str, "critical") ||
-                        boost::ends_with(it->first.str, "warning"))
+                    if (boost::ends_with(object.first.str, "critical") ||
+                        boost::ends_with(object.first.str, "warning"))
                     {
-                        it++;
-                        continue;
+                        self->statuses.emplace_back(object);
                     }
-                    it = resp.erase(it);
                 }
-                self->statuses = std::move(resp);
             },
             "xyz.openbmc_project.ObjectMapper", "/",
             "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
@@ -16,11 +16,13 @@
 #pragma once
 
 #include "http_utility.hpp"
+#include "ranged_download.hpp"
 #include "registries.hpp"
 #include "registries/base_message_registry.hpp"
 #include "registries/openbmc_message_registry.hpp"
 #include "task.hpp"
 
+#include <fcntl.h>
 #include <systemd/sd-journal.h>
 #include <unistd.h>
 
@@ -31,8 +33,10 @@
 #include <boost/beast/http.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/system/linux_error.hpp>
+#include <coroutine.hpp>
 #include <error_messages.hpp>
 #include <registries/privilege_registry.hpp>
+#include <sliced_loop.hpp>
 #include <utils/error_log_utils.hpp>
 
 #include <charconv>
@@ -82,46 +86,24 @@ enum class eventLogTypes
 
 namespace message_registries
 {
-static const Message* getMessageFromRegistry(
-    const std::string& messageKey,
-    const boost::beast::span<const MessageEntry> registry)
+static const Message* getMessage(std::string_view messageID)
 {
-    boost::beast::span<const MessageEntry>::const_iterator messageIt =
-        std::find_if(registry.cbegin(), registry.cend(),
-                     [&messageKey](const MessageEntry& messageEntry) {
-                         return !std::strcmp(messageEntry.first,
-                                             messageKey.c_str());
-                     });
-    if (messageIt != registry.cend())
+    std::optional<MessageId> fields = parseMessageId(messageID);
+    if (!fields)
     {
-        return &messageIt->second;
+        return nullptr;
     }
 
-    return nullptr;
-}
-
-static const Message* getMessage(const std::string_view& messageID)
-{
-    // Redfish MessageIds are in the form
-    // RegistryName.MajorVersion.MinorVersion.MessageKey, so parse it to find
-    // the right Message
-    std::vector<std::string> fields;
-    fields.reserve(4);
-    boost::split(fields, messageID, boost::is_any_of("."));
-    std::string& registryName = fields[0];
-    std::string& messageKey = fields[3];
-
     // Find the right registry and check it for the MessageKey
-    if (std::string(base::header.registryPrefix) == registryName)
+    if (base::header.registryPrefix == fields->registryName)
     {
-        return getMessageFromRegistry(
-            messageKey, boost::beast::span<const MessageEntry>(base::registry));
+        return RegistryView(base::registry, base::registryIndex)
+            .find(fields->messageKey);
     }
-    if (std::string(openbmc::header.registryPrefix) == registryName)
+    if (openbmc::header.registryPrefix == fields->registryName)
     {
-        return getMessageFromRegistry(
-            messageKey,
-            boost::beast::span<const MessageEntry>(openbmc::registry));
+        return RegistryView(openbmc::registry, openbmc::registryIndex)
+            .find(fields->messageKey);
     }
     return nullptr;
 }
@@ -263,12 +245,21 @@ static bool getTopParam(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     return true;
 }
 
+// The last timestamp seen by a walk through a log, entries after the first
+// with the same timestamp get an _N suffix.  Each walk needs one of its own.
+struct UniqueEntryIDState
+{
+    uint64_t prevTs = 0;
+    int index = 0;
+};
+
 inline static bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
+                                    UniqueEntryIDState& state,
                                     const bool firstEntry = true)
 {
     int ret = 0;
-    static uint64_t prevTs = 0;
-    static int index = 0;
+    uint64_t& prevTs = state.prevTs;
+    int& index = state.index;
     if (firstEntry)
     {
         prevTs = 0;
@@ -305,10 +296,11 @@ inline static bool getUniqueEntryID(sd_journal* journal, std::string& entryID,
 }
 
 static bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
+                             UniqueEntryIDState& state,
                              const bool firstEntry = true)
 {
-    static time_t prevTs = 0;
-    static int index = 0;
+    uint64_t& prevTs = state.prevTs;
+    int& index = state.index;
     if (firstEntry)
     {
         prevTs = 0;
@@ -323,7 +315,7 @@ static bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
         curTs = std::mktime(&timeStruct);
     }
     // If the timestamp isn't unique, increment the index
-    if (curTs == prevTs)
+    if (static_cast<uint64_t>(curTs) == prevTs)
     {
         index++;
     }
@@ -333,7 +325,7 @@ static bool getUniqueEntryID(const std::string& logEntry, std::string& entryID,
         index = 0;
     }
     // Save the timestamp
-    prevTs = curTs;
+    prevTs = static_cast<uint64_t>(curTs);
 
     entryID = std::to_string(curTs);
     if (index > 0)
@@ -941,6 +933,66 @@ inline void createDumpTaskCallback(
     task->payload.emplace(req);
 }
 
+using CreateDumpParams =
+    std::vector<std::pair<std::string, std::variant<std::string, uint64_t>>>;
+
+inline crow::coro::Task<>
+    requestDump(std::shared_ptr<bmcweb::AsyncResp> asyncResp,
+                crow::Request req, std::string dumpType, std::string dumpPath,
+                CreateDumpParams createDumpParams)
+{
+    dbus::utility::MethodResult<sdbusplus::message::object_path> created =
+        co_await dbus::utility::methodCall<sdbusplus::message::object_path>(
+            "xyz.openbmc_project.Dump.Manager", dumpPath,
+            "xyz.openbmc_project.Dump.Create", "CreateDump", createDumpParams);
+    if (created.ec)
+    {
+        BMCWEB_LOG_ERROR << "CreateDump resp_handler got error "
+                         << created.ec;
+        if (created.errorName.empty())
+        {
+            messages::internalError(asyncResp->res);
+            co_return;
+        }
+
+        BMCWEB_LOG_ERROR << "CreateDump DBus error: " << created.errorName
+                         << " and error msg: " << created.errorMessage;
+
+        if (created.errorName == "xyz.openbmc_project.Common.Error.NotAllowed")
+        {
+            // This will be returned as a result of createDump call made when
+            // the host is not powered on.
+            messages::resourceInStandby(asyncResp->res);
+            co_return;
+        }
+        if (created.errorName ==
+            "xyz.openbmc_project.Dump.Create.Error.Disabled")
+        {
+            std::string dumpUri;
+            if (dumpType == "BMC")
+            {
+                dumpUri = "/redfish/v1/Managers/bmc/LogServices/Dump/";
+            }
+            else if (dumpType == "System")
+            {
+                dumpUri = "/redfish/v1/Systems/system/LogServices/Dump/";
+            }
+            messages::serviceDisabled(asyncResp->res, dumpUri);
+            co_return;
+        }
+        // Other Dbus errors such as:
+        // xyz.openbmc_project.Common.Error.InvalidArgument &
+        // org.freedesktop.DBus.Error.InvalidArgs are all related to the dbus
+        // call that is made here in the bmcweb implementation and has
+        // nothing to do with the client's input in the request. Hence,
+        // returning internal error back to the client.
+        messages::internalError(asyncResp->res);
+        co_return;
+    }
+    BMCWEB_LOG_DEBUG << "Dump Created. Path: " << created.value.str;
+    createDumpTaskCallback(req, asyncResp, created.value);
+}
+
 inline void createDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                        const crow::Request& req, const std::string& dumpType)
 {
@@ -956,8 +1008,7 @@ inline void createDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     }
 
     std::string dumpPath;
-    std::vector<std::pair<std::string, std::variant<std::string, uint64_t>>>
-        createDumpParams;
+    CreateDumpParams createDumpParams;
     if (dumpType == "System")
     {
         if (!oemDiagnosticDataType || !diagnosticDataType)
@@ -1044,66 +1095,8 @@ inline void createDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         "xyz.openbmc_project.Dump.Create.CreateParameters.GeneratorId",
         req.session->clientIp));
 
-    std::vector<std::pair<std::string, std::variant<std::string, uint64_t>>>
-        createDumpParamVec(createDumpParams);
-
-    crow::connections::systemBus->async_method_call(
-        [asyncResp, req,
-         dumpType](const boost::system::error_code ec,
-                   const sdbusplus::message::message& msg,
-                   const sdbusplus::message::object_path& objPath) {
-            if (ec)
-            {
-                BMCWEB_LOG_ERROR << "CreateDump resp_handler got error " << ec;
-                const sd_bus_error* dbusError = msg.get_error();
-                if (dbusError == nullptr)
-                {
-                    messages::internalError(asyncResp->res);
-                    return;
-                }
-
-                BMCWEB_LOG_ERROR << "CreateDump DBus error: " << dbusError->name
-                                 << " and error msg: " << dbusError->message;
-
-                if (strcmp(dbusError->name, "xyz.openbmc_project.Common.Error."
-                                            "NotAllowed") == 0)
-                {
-                    // This will be returned as a result of createDump call
-                    // made when the host is not powered on.
-                    messages::resourceInStandby(asyncResp->res);
-                    return;
-                }
-                if (strcmp(dbusError->name, "xyz.openbmc_project.Dump."
-                                            "Create.Error.Disabled") == 0)
-                {
-                    std::string dumpPath;
-                    if (dumpType == "BMC")
-                    {
-                        dumpPath = "/redfish/v1/Managers/bmc/LogServices/Dump/";
-                    }
-                    else if (dumpType == "System")
-                    {
-                        dumpPath =
-                            "/redfish/v1/Systems/system/LogServices/Dump/";
-                    }
-                    messages::serviceDisabled(asyncResp->res, dumpPath);
-                    return;
-                }
-                // Other Dbus errors such as:
-                // xyz.openbmc_project.Common.Error.InvalidArgument &
-                // org.freedesktop.DBus.Error.InvalidArgs are all related to
-                // the dbus call that is made here in the bmcweb
-                // implementation and has nothing to do with the client's
-                // input in the request. Hence, returning internal error
-                // back to the client.
-                messages::internalError(asyncResp->res);
-                return;
-            }
-            BMCWEB_LOG_DEBUG << "Dump Created. Path: " << objPath.str;
-            createDumpTaskCallback(req, asyncResp, objPath);
-        },
-        "xyz.openbmc_project.Dump.Manager", dumpPath,
-        "xyz.openbmc_project.Dump.Create", "CreateDump", createDumpParamVec);
+    crow::coro::spawn(requestDump(asyncResp, req, dumpType, dumpPath,
+                                  std::move(createDumpParams)));
 }
 
 inline void clearDump(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
@@ -1491,6 +1484,39 @@ static int fillEventLogEntryJson(const std::string& logEntryID,
     return 0;
 }
 
+// State of a walk through the redfish event log files, kept across the
+// slices of the walk
+struct EventLogWalk
+{
+    std::vector<std::filesystem::path> files;
+    // Oldest logs are in the last file, so start there and go backwards
+    size_t filesLeft = 0;
+    std::ifstream logStream;
+    std::string logEntry;
+    uint64_t entryCount = 0;
+    // Reset the unique ID on the first entry of each file
+    bool firstEntry = true;
+    UniqueEntryIDState idState;
+    bool failed = false;
+
+    // Returns false once there are no files left
+    bool openNextFile()
+    {
+        while (filesLeft > 0)
+        {
+            filesLeft--;
+            logStream.clear();
+            logStream.open(files[filesLeft]);
+            if (logStream.is_open())
+            {
+                firstEntry = true;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 inline void requestRoutesJournalEventLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app,
@@ -1519,69 +1545,74 @@ inline void requestRoutesJournalEventLogEntryCollection(App& app)
                 asyncResp->res.jsonValue["Description"] =
                     "Collection of System Event Log Entries";
 
-                nlohmann::json& logEntryArray =
-                    asyncResp->res.jsonValue["Members"];
-                logEntryArray = nlohmann::json::array();
+                asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
                 // Go through the log files and create a unique ID for each
                 // entry
-                std::vector<std::filesystem::path> redfishLogFiles;
-                getRedfishLogFiles(redfishLogFiles);
-                uint64_t entryCount = 0;
-                std::string logEntry;
-
-                // Oldest logs are in the last file, so start there and loop
-                // backwards
-                for (auto it = redfishLogFiles.rbegin();
-                     it < redfishLogFiles.rend(); it++)
-                {
-                    std::ifstream logStream(*it);
-                    if (!logStream.is_open())
-                    {
-                        continue;
-                    }
-
-                    // Reset the unique ID on the first entry
-                    bool firstEntry = true;
-                    while (std::getline(logStream, logEntry))
-                    {
-                        entryCount++;
+                auto walk = std::make_shared<EventLogWalk>();
+                getRedfishLogFiles(walk->files);
+                walk->filesLeft = walk->files.size();
+                crow::SlicedLoop::run(
+                    crow::connections::systemBus->get_io_context(),
+                    [asyncResp, walk, skip, top]() {
+                        if (!walk->logStream.is_open())
+                        {
+                            return walk->openNextFile();
+                        }
+                        if (!std::getline(walk->logStream, walk->logEntry))
+                        {
+                            walk->logStream.close();
+                            return true;
+                        }
+                        walk->entryCount++;
                         // Handle paging using skip (number of entries to skip
                         // from the start) and top (number of entries to
                         // display)
-                        if (entryCount <= skip || entryCount > skip + top)
+                        if (walk->entryCount <= skip ||
+                            walk->entryCount > skip + top)
                         {
-                            continue;
+                            return true;
                         }
 
                         std::string idStr;
-                        if (!getUniqueEntryID(logEntry, idStr, firstEntry))
+                        if (!getUniqueEntryID(walk->logEntry, idStr,
+                                              walk->idState, walk->firstEntry))
                         {
-                            continue;
+                            return true;
                         }
 
-                        if (firstEntry)
+                        if (walk->firstEntry)
                         {
-                            firstEntry = false;
+                            walk->firstEntry = false;
                         }
 
+                        nlohmann::json& logEntryArray =
+                            asyncResp->res.jsonValue["Members"];
                         logEntryArray.push_back({});
                         nlohmann::json& bmcLogEntry = logEntryArray.back();
-                        if (fillEventLogEntryJson(idStr, logEntry,
+                        if (fillEventLogEntryJson(idStr, walk->logEntry,
                                                   bmcLogEntry) != 0)
                         {
                             messages::internalError(asyncResp->res);
+                            walk->failed = true;
+                            return false;
+                        }
+                        return true;
+                    },
+                    [asyncResp, walk, skip, top]() {
+                        if (walk->failed)
+                        {
                             return;
                         }
-                    }
-                }
-                asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
-                if (skip + top < entryCount)
-                {
-                    asyncResp->res.jsonValue["Members@odata.nextLink"] =
-                        "/redfish/v1/Systems/system/LogServices/EventLog/"
-                        "Entries?$skip=" +
-                        std::to_string(skip + top);
-                }
+                        asyncResp->res.jsonValue["Members@odata.count"] =
+                            walk->entryCount;
+                        if (skip + top < walk->entryCount)
+                        {
+                            asyncResp->res.jsonValue["Members@odata.nextLink"] =
+                                "/redfish/v1/Systems/system/LogServices/"
+                                "EventLog/Entries?$skip=" +
+                                std::to_string(skip + top);
+                        }
+                    });
             });
 }
 
@@ -1615,10 +1646,12 @@ inline void requestRoutesJournalEventLogEntry(App& app)
 
                     // Reset the unique ID on the first entry
                     bool firstEntry = true;
+                    UniqueEntryIDState idState;
                     while (std::getline(logStream, logEntry))
                     {
                         std::string idStr;
-                        if (!getUniqueEntryID(logEntry, idStr, firstEntry))
+                        if (!getUniqueEntryID(logEntry, idStr, idState,
+                                              firstEntry))
                         {
                             continue;
                         }
@@ -1677,257 +1710,293 @@ void getHiddenPropertyValue(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
         "org.open_power.Logging.PEL.Entry", "Hidden");
 }
 
-inline void getDBusLogEntryCollection(
+// Adds the LogEntry of objectPath to the Members of asyncResp, if it is one
+// of type.  Returns false if the response was failed.
+inline bool addDBusLogEntry(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    GetManagedObjectsType& resp, eventLogTypes type)
+    GetManagedObjectsType::value_type& objectPath, eventLogTypes type)
 {
-    nlohmann::json& entriesArray = asyncResp->res.jsonValue["Members"];
-    entriesArray = nlohmann::json::array();
-    for (auto& objectPath : resp)
-    {
-        uint32_t* id = nullptr;
-        std::time_t timestamp{};
-        std::time_t updateTimestamp{};
-        std::string* severity = nullptr;
-        std::string* subsystem = nullptr;
-        std::string* filePath = nullptr;
-        std::string* eventId = nullptr;
-        std::string* resolution = nullptr;
-        bool resolved = false;
-        bool* hiddenProp = nullptr;
-        bool serviceProviderNotified = false;
+    uint32_t* id = nullptr;
+    std::time_t timestamp{};
+    std::time_t updateTimestamp{};
+    std::string* severity = nullptr;
+    std::string* subsystem = nullptr;
+    std::string* filePath = nullptr;
+    std::string* eventId = nullptr;
+    std::string* resolution = nullptr;
+    bool resolved = false;
+    bool* hiddenProp = nullptr;
+    bool serviceProviderNotified = false;
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-        bool managementSystemAck = false;
+    bool managementSystemAck = false;
 #endif
 
-        for (auto& interfaceMap : objectPath.second)
+    for (auto& interfaceMap : objectPath.second)
+    {
+        if (interfaceMap.first == "xyz.openbmc_project.Logging.Entry")
         {
-            if (interfaceMap.first == "xyz.openbmc_project.Logging.Entry")
+            for (auto& propertyMap : interfaceMap.second)
             {
-                for (auto& propertyMap : interfaceMap.second)
+                if (propertyMap.first == "Id")
                 {
-                    if (propertyMap.first == "Id")
+                    id = std::get_if<uint32_t>(&propertyMap.second);
+                    if (id == nullptr)
                     {
-                        id = std::get_if<uint32_t>(&propertyMap.second);
-                        if (id == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                    }
-                    else if (propertyMap.first == "Timestamp")
-                    {
-                        const uint64_t* millisTimeStamp =
-                            std::get_if<uint64_t>(&propertyMap.second);
-                        if (millisTimeStamp == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        timestamp =
-                            crow::utility::getTimestamp(*millisTimeStamp);
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "UpdateTimestamp")
+                }
+                else if (propertyMap.first == "Timestamp")
+                {
+                    const uint64_t* millisTimeStamp =
+                        std::get_if<uint64_t>(&propertyMap.second);
+                    if (millisTimeStamp == nullptr)
                     {
-                        const uint64_t* millisTimeStamp =
-                            std::get_if<uint64_t>(&propertyMap.second);
-                        if (millisTimeStamp == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        updateTimestamp =
-                            crow::utility::getTimestamp(*millisTimeStamp);
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "Severity")
+                    timestamp =
+                        crow::utility::getTimestamp(*millisTimeStamp);
+                }
+                else if (propertyMap.first == "UpdateTimestamp")
+                {
+                    const uint64_t* millisTimeStamp =
+                        std::get_if<uint64_t>(&propertyMap.second);
+                    if (millisTimeStamp == nullptr)
                     {
-                        severity =
-                            std::get_if<std::string>(&propertyMap.second);
-                        if (severity == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "Resolution")
+                    updateTimestamp =
+                        crow::utility::getTimestamp(*millisTimeStamp);
+                }
+                else if (propertyMap.first == "Severity")
+                {
+                    severity =
+                        std::get_if<std::string>(&propertyMap.second);
+                    if (severity == nullptr)
                     {
-                        resolution =
-                            std::get_if<std::string>(&propertyMap.second);
-                        if (resolution == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "EventId")
+                }
+                else if (propertyMap.first == "Resolution")
+                {
+                    resolution =
+                        std::get_if<std::string>(&propertyMap.second);
+                    if (resolution == nullptr)
                     {
-                        eventId = std::get_if<std::string>(&propertyMap.second);
-                        if (eventId == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "Resolved")
+                }
+                else if (propertyMap.first == "EventId")
+                {
+                    eventId = std::get_if<std::string>(&propertyMap.second);
+                    if (eventId == nullptr)
                     {
-                        bool* resolveptr =
-                            std::get_if<bool>(&propertyMap.second);
-                        if (resolveptr == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        resolved = *resolveptr;
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "ServiceProviderNotify")
+                }
+                else if (propertyMap.first == "Resolved")
+                {
+                    bool* resolveptr =
+                        std::get_if<bool>(&propertyMap.second);
+                    if (resolveptr == nullptr)
                     {
-                        bool* serviceProviderNotifiedptr =
-                            std::get_if<bool>(&propertyMap.second);
-                        if (serviceProviderNotifiedptr == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        serviceProviderNotified = *serviceProviderNotifiedptr;
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
+                    resolved = *resolveptr;
                 }
-                if ((id == nullptr) || (resolution == nullptr) ||
-                    (severity == nullptr))
+                else if (propertyMap.first == "ServiceProviderNotify")
                 {
-                    messages::internalError(asyncResp->res);
-                    return;
+                    bool* serviceProviderNotifiedptr =
+                        std::get_if<bool>(&propertyMap.second);
+                    if (serviceProviderNotifiedptr == nullptr)
+                    {
+                        messages::internalError(asyncResp->res);
+                        return false;
+                    }
+                    serviceProviderNotified = *serviceProviderNotifiedptr;
                 }
             }
-            else if (interfaceMap.first ==
-                     "xyz.openbmc_project.Common.FilePath")
+            if ((id == nullptr) || (resolution == nullptr) ||
+                (severity == nullptr))
+            {
+                messages::internalError(asyncResp->res);
+                return false;
+            }
+        }
+        else if (interfaceMap.first ==
+                 "xyz.openbmc_project.Common.FilePath")
+        {
+            for (auto& propertyMap : interfaceMap.second)
             {
-                for (auto& propertyMap : interfaceMap.second)
+                if (propertyMap.first == "Path")
                 {
-                    if (propertyMap.first == "Path")
-                    {
-                        filePath =
-                            std::get_if<std::string>(&propertyMap.second);
-                    }
+                    filePath =
+                        std::get_if<std::string>(&propertyMap.second);
                 }
             }
-            else if (interfaceMap.first == "org.open_power.Logging.PEL.Entry")
+        }
+        else if (interfaceMap.first == "org.open_power.Logging.PEL.Entry")
+        {
+            for (auto& propertyMap : interfaceMap.second)
             {
-                for (auto& propertyMap : interfaceMap.second)
+                if (propertyMap.first == "Hidden")
                 {
-                    if (propertyMap.first == "Hidden")
+                    hiddenProp = std::get_if<bool>(&propertyMap.second);
+                    if (hiddenProp == nullptr)
                     {
-                        hiddenProp = std::get_if<bool>(&propertyMap.second);
-                        if (hiddenProp == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-                    else if (propertyMap.first == "Subsystem")
+                }
+                else if (propertyMap.first == "Subsystem")
+                {
+                    subsystem =
+                        std::get_if<std::string>(&propertyMap.second);
+                    if (subsystem == nullptr)
                     {
-                        subsystem =
-                            std::get_if<std::string>(&propertyMap.second);
-                        if (subsystem == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
+                }
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-                    else if (propertyMap.first == "ManagementSystemAck")
+                else if (propertyMap.first == "ManagementSystemAck")
+                {
+                    bool* managementSystemAckptr =
+                        std::get_if<bool>(&propertyMap.second);
+                    if (managementSystemAckptr == nullptr)
                     {
-                        bool* managementSystemAckptr =
-                            std::get_if<bool>(&propertyMap.second);
-                        if (managementSystemAckptr == nullptr)
-                        {
-                            messages::internalError(asyncResp->res);
-                            return;
-                        }
-                        managementSystemAck = *managementSystemAckptr;
+                        messages::internalError(asyncResp->res);
+                        return false;
                     }
-#endif
+                    managementSystemAck = *managementSystemAckptr;
                 }
+#endif
             }
         }
-        // Object path without the
-        // xyz.openbmc_project.Logging.Entry interface and/or
-        // org.open_power.Logging.PEL.Entry ignore and continue.
-        if ((id == nullptr) || (severity == nullptr) ||
-            (hiddenProp == nullptr) || (eventId == nullptr) ||
-            (subsystem == nullptr))
-        {
-            continue;
-        }
+    }
+    // Object path without the
+    // xyz.openbmc_project.Logging.Entry interface and/or
+    // org.open_power.Logging.PEL.Entry ignore and continue.
+    if ((id == nullptr) || (severity == nullptr) ||
+        (hiddenProp == nullptr) || (eventId == nullptr) ||
+        (subsystem == nullptr))
+    {
+        return true;
+    }
+
+    std::string entryID = std::to_string(*id);
+    // Ignore and continue if the event log entry is 'hidden
+    // and EventLog collection' OR 'not hidden and CELog
+    // collection'
+    if (((type == eventLogTypes::eventLog) && (*hiddenProp)) ||
+        ((type == eventLogTypes::ceLog) && !(*hiddenProp)))
+    {
+        return true;
+    }
+
+    nlohmann::json& entriesArray = asyncResp->res.jsonValue["Members"];
+    entriesArray.push_back({});
+    nlohmann::json& thisEntry = entriesArray.back();
+    thisEntry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
+    thisEntry["EntryType"] = "Event";
+    thisEntry["Id"] = entryID;
+    thisEntry["EventId"] = *eventId;
+    thisEntry["Message"] =
+        (*eventId).substr(0, 8) + " event in subsystem: " + *subsystem;
+    thisEntry["Resolved"] = resolved;
+    if (!(*resolution).empty())
+    {
+        thisEntry["Resolution"] = *resolution;
+    }
+    thisEntry["ServiceProviderNotified"] = serviceProviderNotified;
+    thisEntry["Severity"] = translateSeverityDbusToRedfish(*severity);
+    thisEntry["Created"] = crow::utility::getDateTime(timestamp);
+    thisEntry["Modified"] = crow::utility::getDateTime(updateTimestamp);
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+    thisEntry["Oem"]["OpenBMC"]["@odata.type"] =
+        "#OemLogEntry.v1_0_0.LogEntry";
+    thisEntry["Oem"]["OpenBMC"]["ManagementSystemAck"] =
+        managementSystemAck;
+#endif
+    if (type == eventLogTypes::eventLog)
+    {
+        thisEntry["@odata.id"] = "/redfish/v1/Systems/system/"
+                                 "LogServices/EventLog/Entries/" +
+                                 entryID;
+        thisEntry["Name"] = "System Event Log Entry";
 
-        std::string entryID = std::to_string(*id);
-        // Ignore and continue if the event log entry is 'hidden
-        // and EventLog collection' OR 'not hidden and CELog
-        // collection'
-        if (((type == eventLogTypes::eventLog) && (*hiddenProp)) ||
-            ((type == eventLogTypes::ceLog) && !(*hiddenProp)))
+        if (filePath != nullptr)
         {
-            continue;
+            thisEntry["AdditionalDataURI"] =
+                "/redfish/v1/Systems/system/LogServices/"
+                "EventLog/Entries/" +
+                entryID + "/attachment";
         }
+    }
+    else
+    {
+        thisEntry["@odata.id"] = "/redfish/v1/Systems/system/"
+                                 "LogServices/CELog/Entries/" +
+                                 entryID;
+        thisEntry["Name"] = "System CE Log Entry";
 
-        entriesArray.push_back({});
-        nlohmann::json& thisEntry = entriesArray.back();
-        thisEntry["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
-        thisEntry["EntryType"] = "Event";
-        thisEntry["Id"] = entryID;
-        thisEntry["EventId"] = *eventId;
-        thisEntry["Message"] =
-            (*eventId).substr(0, 8) + " event in subsystem: " + *subsystem;
-        thisEntry["Resolved"] = resolved;
-        if (!(*resolution).empty())
+        if (filePath != nullptr)
         {
-            thisEntry["Resolution"] = *resolution;
+            thisEntry["AdditionalDataURI"] =
+                "/redfish/v1/Systems/system/LogServices/"
+                "CELog/Entries/" +
+                entryID + "/attachment";
         }
-        thisEntry["ServiceProviderNotified"] = serviceProviderNotified;
-        thisEntry["Severity"] = translateSeverityDbusToRedfish(*severity);
-        thisEntry["Created"] = crow::utility::getDateTime(timestamp);
-        thisEntry["Modified"] = crow::utility::getDateTime(updateTimestamp);
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-        thisEntry["Oem"]["OpenBMC"]["@odata.type"] =
-            "#OemLogEntry.v1_0_0.LogEntry";
-        thisEntry["Oem"]["OpenBMC"]["ManagementSystemAck"] =
-            managementSystemAck;
-#endif
-        if (type == eventLogTypes::eventLog)
-        {
-            thisEntry["@odata.id"] = "/redfish/v1/Systems/system/"
-                                     "LogServices/EventLog/Entries/" +
-                                     entryID;
-            thisEntry["Name"] = "System Event Log Entry";
+    }
+    return true;
+}
 
-            if (filePath != nullptr)
+// Renders the entries a slice at a time, there can be thousands of them
+inline void getDBusLogEntryCollection(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    GetManagedObjectsType& resp, eventLogTypes type)
+{
+    asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
+    auto objects = std::make_shared<GetManagedObjectsType>(std::move(resp));
+    auto next = std::make_shared<GetManagedObjectsType::iterator>(
+        objects->begin());
+    auto failed = std::make_shared<bool>(false);
+    crow::SlicedLoop::run(
+        crow::connections::systemBus->get_io_context(),
+        [asyncResp, objects, next, failed, type]() {
+            if (*next == objects->end())
             {
-                thisEntry["AdditionalDataURI"] =
-                    "/redfish/v1/Systems/system/LogServices/"
-                    "EventLog/Entries/" +
-                    entryID + "/attachment";
+                return false;
             }
-        }
-        else
-        {
-            thisEntry["@odata.id"] = "/redfish/v1/Systems/system/"
-                                     "LogServices/CELog/Entries/" +
-                                     entryID;
-            thisEntry["Name"] = "System CE Log Entry";
-
-            if (filePath != nullptr)
+            if (!addDBusLogEntry(asyncResp, **next, type))
             {
-                thisEntry["AdditionalDataURI"] =
-                    "/redfish/v1/Systems/system/LogServices/"
-                    "CELog/Entries/" +
-                    entryID + "/attachment";
+                *failed = true;
+                return false;
             }
-        }
-    }
-    std::sort(entriesArray.begin(), entriesArray.end(),
-              [](const nlohmann::json& left, const nlohmann::json& right) {
-                  return (left["Id"] <= right["Id"]);
-              });
-    asyncResp->res.jsonValue["Members@odata.count"] = entriesArray.size();
+            (*next)++;
+            return true;
+        },
+        [asyncResp, failed]() {
+            if (*failed)
+            {
+                return;
+            }
+            nlohmann::json& entriesArray =
+                asyncResp->res.jsonValue["Members"];
+            std::sort(entriesArray.begin(), entriesArray.end(),
+                      [](const nlohmann::json& left,
+                         const nlohmann::json& right) {
+                          return (left["Id"] <= right["Id"]);
+                      });
+            asyncResp->res.jsonValue["Members@odata.count"] =
+                entriesArray.size();
+        });
 }
 
 inline void requestRoutesDBusEventLogEntryCollection(App& app)
@@ -2508,11 +2577,12 @@ inline void requestRoutesDBusCELogEntry(App& app)
 
 inline void getEventLogEntryAttachment(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& entryID)
+    const std::string& entryID,
+    const crow::ranged_download::RangeHeaders& rangeHeaders)
 {
-    auto respHandler = [asyncResp,
-                        entryID](const boost::system::error_code ec,
-                                 const sdbusplus::message::unix_fd& unixfd) {
+    auto respHandler = [asyncResp, entryID, rangeHeaders](
+                           const boost::system::error_code ec,
+                           const sdbusplus::message::unix_fd& unixfd) {
         if (ec.value() == EBADR)
         {
             messages::resourceNotFound(asyncResp->res, "CELogAttachment",
@@ -2534,43 +2604,40 @@ inline void getEventLogEntryAttachment(
             return;
         }
 
-        long long int size = lseek(fd, 0, SEEK_END);
-        if (size == -1)
+        struct stat st
+        {};
+        if (fstat(fd, &st) != 0)
         {
+            close(fd);
             messages::internalError(asyncResp->res);
             return;
         }
 
         // Arbitrary max size of 64kb
         constexpr int maxFileSize = 65536;
-        if (size > maxFileSize)
+        if (st.st_size > maxFileSize)
         {
+            close(fd);
             BMCWEB_LOG_ERROR << "File size exceeds maximum allowed size of "
                              << maxFileSize;
             messages::internalError(asyncResp->res);
             return;
         }
-        std::vector<char> data(static_cast<size_t>(size));
-        long long int rc = lseek(fd, 0, SEEK_SET);
-        if (rc == -1)
-        {
-            messages::internalError(asyncResp->res);
-            return;
-        }
-        rc = read(fd, data.data(), data.size());
-        if ((rc == -1) || (rc != size))
+        std::string data(static_cast<size_t>(st.st_size), '\0');
+        ssize_t rc = pread(fd, data.data(), data.size(), 0);
+        close(fd);
+        if (rc != st.st_size)
         {
             messages::internalError(asyncResp->res);
             return;
         }
-        close(fd);
-
-        std::string_view strData(data.data(), data.size());
-        std::string output = crow::utility::base64encode(strData);
 
         asyncResp->res.addHeader("Content-Type", "application/octet-stream");
         asyncResp->res.addHeader("Content-Transfer-Encoding", "Base64");
-        asyncResp->res.body() = std::move(output);
+        // Ranges apply to the encoded body, which is what the client gets
+        crow::ranged_download::sendBody(
+            rangeHeaders, asyncResp->res, crow::utility::base64encode(data),
+            crow::ranged_download::makeFileEtag(st));
     };
 
     crow::connections::systemBus->async_method_call(
@@ -2601,15 +2668,17 @@ inline void requestRoutesDBusEventLogEntryDownload(App& app)
                 std::string entryID = param;
                 dbus::utility::escapePathForDbus(entryID);
 
+                crow::ranged_download::RangeHeaders rangeHeaders(req.req);
                 auto eventLogAttachmentCallback =
-                    [asyncResp, entryID](bool hiddenPropVal) {
+                    [asyncResp, entryID, rangeHeaders](bool hiddenPropVal) {
                         if (hiddenPropVal)
                         {
                             messages::resourceNotFound(asyncResp->res,
                                                        "LogEntry", entryID);
                             return;
                         }
-                        getEventLogEntryAttachment(asyncResp, entryID);
+                        getEventLogEntryAttachment(asyncResp, entryID,
+                                                   rangeHeaders);
                     };
                 getHiddenPropertyValue(asyncResp, entryID,
                                        std::move(eventLogAttachmentCallback));
@@ -2655,15 +2724,17 @@ inline void requestRoutesDBusCELogEntryDownload(App& app)
                 std::string entryID = param;
                 dbus::utility::escapePathForDbus(entryID);
 
+                crow::ranged_download::RangeHeaders rangeHeaders(req.req);
                 auto eventLogAttachmentCallback =
-                    [asyncResp, entryID](bool hiddenPropVal) {
+                    [asyncResp, entryID, rangeHeaders](bool hiddenPropVal) {
                         if (!hiddenPropVal)
                         {
                             messages::resourceNotFound(asyncResp->res,
                                                        "LogEntry", entryID);
                             return;
                         }
-                        getEventLogEntryAttachment(asyncResp, entryID);
+                        getEventLogEntryAttachment(asyncResp, entryID,
+                                                   rangeHeaders);
                     };
 
                 getHiddenPropertyValue(asyncResp, entryID,
@@ -2800,6 +2871,21 @@ static int fillBMCJournalLogEntryJson(const std::string& bmcJournalLogEntryID,
     return 0;
 }
 
+// State of a walk through the journal, kept across the slices of the walk
+struct JournalWalk
+{
+    explicit JournalWalk(sd_journal* journalIn) :
+        journal(journalIn, sd_journal_close)
+    {}
+
+    std::unique_ptr<sd_journal, decltype(&sd_journal_close)> journal;
+    uint64_t entryCount = 0;
+    // Reset the unique ID on the first entry
+    bool firstEntry = true;
+    UniqueEntryIDState idState;
+    bool failed = false;
+};
+
 inline void requestRoutesBMCJournalLogEntryCollection(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Managers/bmc/LogServices/Journal/Entries/")
@@ -2827,9 +2913,7 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
                 asyncResp->res.jsonValue["Name"] = "Open BMC Journal Entries";
                 asyncResp->res.jsonValue["Description"] =
                     "Collection of BMC Journal Entries";
-                nlohmann::json& logEntryArray =
-                    asyncResp->res.jsonValue["Members"];
-                logEntryArray = nlohmann::json::array();
+                asyncResp->res.jsonValue["Members"] = nlohmann::json::array();
 
                 // Go through the journal and use the timestamp to create a
                 // unique ID for each entry
@@ -2842,50 +2926,68 @@ inline void requestRoutesBMCJournalLogEntryCollection(App& app)
                     messages::internalError(asyncResp->res);
                     return;
                 }
-                std::unique_ptr<sd_journal, decltype(&sd_journal_close)>
-                    journal(journalTmp, sd_journal_close);
+                auto walk = std::make_shared<JournalWalk>(journalTmp);
                 journalTmp = nullptr;
-                uint64_t entryCount = 0;
-                // Reset the unique ID on the first entry
-                bool firstEntry = true;
-                SD_JOURNAL_FOREACH(journal.get())
-                {
-                    entryCount++;
-                    // Handle paging using skip (number of entries to skip from
-                    // the start) and top (number of entries to display)
-                    if (entryCount <= skip || entryCount > skip + top)
-                    {
-                        continue;
-                    }
+                sd_journal_seek_head(walk->journal.get());
+                crow::SlicedLoop::run(
+                    crow::connections::systemBus->get_io_context(),
+                    [asyncResp, walk, skip, top]() {
+                        if (sd_journal_next(walk->journal.get()) <= 0)
+                        {
+                            return false;
+                        }
+                        walk->entryCount++;
+                        // Handle paging using skip (number of entries to skip
+                        // from the start) and top (number of entries to
+                        // display)
+                        if (walk->entryCount <= skip ||
+                            walk->entryCount > skip + top)
+                        {
+                            return true;
+                        }
 
-                    std::string idStr;
-                    if (!getUniqueEntryID(journal.get(), idStr, firstEntry))
-                    {
-                        continue;
-                    }
+                        std::string idStr;
+                        if (!getUniqueEntryID(walk->journal.get(), idStr,
+                                              walk->idState, walk->firstEntry))
+                        {
+                            return true;
+                        }
 
-                    if (firstEntry)
-                    {
-                        firstEntry = false;
-                    }
+                        if (walk->firstEntry)
+                        {
+                            walk->firstEntry = false;
+                        }
 
-                    logEntryArray.push_back({});
-                    nlohmann::json& bmcJournalLogEntry = logEntryArray.back();
-                    if (fillBMCJournalLogEntryJson(idStr, journal.get(),
-                                                   bmcJournalLogEntry) != 0)
-                    {
-                        messages::internalError(asyncResp->res);
-                        return;
-                    }
-                }
-                asyncResp->res.jsonValue["Members@odata.count"] = entryCount;
-                if (skip + top < entryCount)
-                {
-                    asyncResp->res.jsonValue["Members@odata.nextLink"] =
-                        "/redfish/v1/Managers/bmc/LogServices/Journal/"
-                        "Entries?$skip=" +
-                        std::to_string(skip + top);
-                }
+                        nlohmann::json& logEntryArray =
+                            asyncResp->res.jsonValue["Members"];
+                        logEntryArray.push_back({});
+                        nlohmann::json& bmcJournalLogEntry =
+                            logEntryArray.back();
+                        if (fillBMCJournalLogEntryJson(idStr,
+                                                       walk->journal.get(),
+                                                       bmcJournalLogEntry) != 0)
+                        {
+                            messages::internalError(asyncResp->res);
+                            walk->failed = true;
+                            return false;
+                        }
+                        return true;
+                    },
+                    [asyncResp, walk, skip, top]() {
+                        if (walk->failed)
+                        {
+                            return;
+                        }
+                        asyncResp->res.jsonValue["Members@odata.count"] =
+                            walk->entryCount;
+                        if (skip + top < walk->entryCount)
+                        {
+                            asyncResp->res.jsonValue["Members@odata.nextLink"] =
+                                "/redfish/v1/Managers/bmc/LogServices/Journal/"
+                                "Entries?$skip=" +
+                                std::to_string(skip + top);
+                        }
+                    });
             });
 }
 
@@ -2922,6 +3024,7 @@ inline void requestRoutesBMCJournalLogEntry(App& app)
                 // index tracking the unique ID
                 std::string idStr;
                 bool firstEntry = true;
+                UniqueEntryIDState idState;
                 ret = sd_journal_seek_realtime_usec(journal.get(), ts);
                 if (ret < 0)
                 {
@@ -2933,7 +3036,8 @@ inline void requestRoutesBMCJournalLogEntry(App& app)
                 for (uint64_t i = 0; i <= index; i++)
                 {
                     sd_journal_next(journal.get());
-                    if (!getUniqueEntryID(journal.get(), idStr, firstEntry))
+                    if (!getUniqueEntryID(journal.get(), idStr, idState,
+                                          firstEntry))
                     {
                         messages::internalError(asyncResp->res);
                         return;
@@ -3477,11 +3581,12 @@ inline void requestRoutesCrashdumpFile(App& app)
         "/redfish/v1/Systems/system/LogServices/Crashdump/Entries/<str>/<str>/")
         .privileges(redfish::privileges::getLogEntry)
         .methods(boost::beast::http::verb::get)(
-            [](const crow::Request&,
+            [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                const std::string& logID, const std::string& fileName) {
+                crow::ranged_download::RangeHeaders rangeHeaders(req.req);
                 auto getStoredLogCallback =
-                    [asyncResp, logID, fileName](
+                    [asyncResp, logID, fileName, rangeHeaders](
                         const boost::system::error_code ec,
                         const std::vector<std::pair<std::string, VariantType>>&
                             resp) {
@@ -3516,32 +3621,25 @@ inline void requestRoutesCrashdumpFile(App& app)
                             return;
                         }
 
-                        if (!std::filesystem::exists(dbusFilepath))
+                        int fd = open(dbusFilepath.c_str(),
+                                      O_RDONLY | O_CLOEXEC);
+                        if (fd < 0)
                         {
                             messages::resourceMissingAtURI(asyncResp->res,
                                                            fileName);
                             return;
                         }
-                        std::ifstream ifs(dbusFilepath, std::ios::in |
-                                                            std::ios::binary |
-                                                            std::ios::ate);
-                        std::ifstream::pos_type fileSize = ifs.tellg();
-                        if (fileSize < 0)
+                        // Only the requested range is read, so an
+                        // interrupted download can be resumed without
+                        // sending the whole file again
+                        bool sent = crow::ranged_download::sendFile(
+                            rangeHeaders, asyncResp->res, fd);
+                        close(fd);
+                        if (!sent)
                         {
                             messages::generalError(asyncResp->res);
                             return;
                         }
-                        ifs.seekg(0, std::ios::beg);
-
-                        auto crashData = std::make_unique<char[]>(
-                            static_cast<unsigned int>(fileSize));
-
-                        ifs.read(crashData.get(), static_cast<int>(fileSize));
-
-                        // The cast to std::string is intentional in order to
-                        // use the assign() that applies move mechanics
-                        asyncResp->res.body().assign(
-                            static_cast<std::string>(crashData.get()));
 
                         // Configure this to be a file download when accessed
                         // from a browser
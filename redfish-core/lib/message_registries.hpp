@@ -25,17 +25,19 @@
 
 #include <app.hpp>
 #include <registries/privilege_registry.hpp>
+#include <utils/immutable_response.hpp>
+
+#include <span>
 
 namespace redfish
 {
 
-inline void handleMessageRegistryFileCollectionGet(
-    const crow::Request&, const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+inline nlohmann::json getMessageRegistryFileCollection()
 {
     // Collections don't include the static data added by SubRoute
     // because it has a duplicate entry for members
 
-    asyncResp->res.jsonValue = {
+    return {
         {"@odata.type", "#MessageRegistryFileCollection."
                         "MessageRegistryFileCollection"},
         {"@odata.id", "/redfish/v1/Registries"},
@@ -51,6 +53,14 @@ inline void handleMessageRegistryFileCollectionGet(
           {{"@odata.id", "/redfish/v1/Registries/OpenBMC"}}}}};
 }
 
+inline void handleMessageRegistryFileCollectionGet(
+    const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    immutable_response::send(req, asyncResp->res, "/redfish/v1/Registries",
+                             getMessageRegistryFileCollection);
+}
+
 inline void requestRoutesMessageRegistryFileCollection(App& app)
 {
     /**
@@ -62,8 +72,36 @@ inline void requestRoutesMessageRegistryFileCollection(App& app)
             handleMessageRegistryFileCollectionGet);
 }
 
+inline nlohmann::json
+    getMessageRegistryFile(const std::string& registry,
+                           const std::string& dmtf,
+                           const message_registries::Header& header,
+                           const char* url)
+{
+    nlohmann::json file = {
+        {"@odata.id", "/redfish/v1/Registries/" + registry},
+        {"@odata.type", "#MessageRegistryFile.v1_1_0.MessageRegistryFile"},
+        {"Name", registry + " Message Registry File"},
+        {"Description", dmtf + registry + " Message Registry File Location"},
+        {"Id", header.registryPrefix},
+        {"Registry", header.id},
+        {"Languages", {"en"}},
+        {"Languages@odata.count", 1},
+        {"Location",
+         {{{"Language", "en"},
+           {"Uri", "/redfish/v1/Registries/" + registry + "/" + registry}}}},
+        {"Location@odata.count", 1}};
+
+    if (url != nullptr)
+    {
+        file["Location"][0]["PublicationUri"] = url;
+    }
+    return file;
+}
+
 inline void handleMessageRoutesMessageRegistryFileGet(
-    const crow::Request&, const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& registry)
 {
     const message_registries::Header* header;
@@ -108,24 +146,10 @@ inline void handleMessageRoutesMessageRegistryFileGet(
         return;
     }
 
-    asyncResp->res.jsonValue = {
-        {"@odata.id", "/redfish/v1/Registries/" + registry},
-        {"@odata.type", "#MessageRegistryFile.v1_1_0.MessageRegistryFile"},
-        {"Name", registry + " Message Registry File"},
-        {"Description", dmtf + registry + " Message Registry File Location"},
-        {"Id", header->registryPrefix},
-        {"Registry", header->id},
-        {"Languages", {"en"}},
-        {"Languages@odata.count", 1},
-        {"Location",
-         {{{"Language", "en"},
-           {"Uri", "/redfish/v1/Registries/" + registry + "/" + registry}}}},
-        {"Location@odata.count", 1}};
-
-    if (url != nullptr)
-    {
-        asyncResp->res.jsonValue["Location"][0]["PublicationUri"] = url;
-    }
+    immutable_response::send(
+        req, asyncResp->res, "/redfish/v1/Registries/" + registry, [&]() {
+            return getMessageRegistryFile(registry, dmtf, *header, url);
+        });
 }
 
 inline void requestRoutesMessageRegistryFile(App& app)
@@ -136,56 +160,80 @@ inline void requestRoutesMessageRegistryFile(App& app)
             handleMessageRoutesMessageRegistryFileGet);
 }
 
+inline nlohmann::json getMessageRegistry(
+    const message_registries::Header& header,
+    std::span<const message_registries::MessageEntry> registryEntries)
+{
+    nlohmann::json registry = {{"@Redfish.Copyright", header.copyright},
+                               {"@odata.type", header.type},
+                               {"Id", header.id},
+                               {"Name", header.name},
+                               {"Language", header.language},
+                               {"Description", header.description},
+                               {"RegistryPrefix", header.registryPrefix},
+                               {"RegistryVersion", header.registryVersion},
+                               {"OwningEntity", header.owningEntity}};
+
+    nlohmann::json& messageObj = registry["Messages"];
+
+    // Go through the Message Registry and populate each Message
+    for (const message_registries::MessageEntry& message : registryEntries)
+    {
+        nlohmann::json& obj = messageObj[message.first];
+        obj = {{"Description", message.second.description},
+               {"Message", message.second.message},
+               {"Severity", message.second.severity},
+               {"MessageSeverity", message.second.messageSeverity},
+               {"NumberOfArgs", message.second.numberOfArgs},
+               {"Resolution", message.second.resolution}};
+        if (message.second.numberOfArgs > 0)
+        {
+            nlohmann::json& messageParamArray = obj["ParamTypes"];
+            messageParamArray = nlohmann::json::array();
+            for (const char* str : message.second.paramTypes)
+            {
+                if (str == nullptr)
+                {
+                    break;
+                }
+                messageParamArray.push_back(str);
+            }
+        }
+    }
+    return registry;
+}
+
 inline void handleMessageRegistryGet(
-    const crow::Request&, const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& registry, const std::string& registryMatch)
 {
     const message_registries::Header* header;
-    std::vector<const message_registries::MessageEntry*> registryEntries;
+    std::span<const message_registries::MessageEntry> registryEntries;
     if (registry == "Base")
     {
         header = &message_registries::base::header;
-        for (const message_registries::MessageEntry& entry :
-             message_registries::base::registry)
-        {
-            registryEntries.emplace_back(&entry);
-        }
+        registryEntries = message_registries::base::registry;
     }
     else if (registry == "TaskEvent")
     {
         header = &message_registries::task_event::header;
-        for (const message_registries::MessageEntry& entry :
-             message_registries::task_event::registry)
-        {
-            registryEntries.emplace_back(&entry);
-        }
+        registryEntries = message_registries::task_event::registry;
     }
     else if (registry == "OpenBMC")
     {
         header = &message_registries::openbmc::header;
-        for (const message_registries::MessageEntry& entry :
-             message_registries::openbmc::registry)
-        {
-            registryEntries.emplace_back(&entry);
-        }
+        registryEntries = message_registries::openbmc::registry;
     }
     else if (registry == "ResourceEvent")
     {
         header = &message_registries::resource_event::header;
-        for (const message_registries::MessageEntry& entry :
-             message_registries::resource_event::registry)
-        {
-            registryEntries.emplace_back(&entry);
-        }
+        registryEntries = message_registries::resource_event::registry;
     }
     else if (registry == "License")
     {
         header = &message_registries::license::header;
-        for (const message_registries::MessageEntry& entry :
-             message_registries::license::registry)
-        {
-            registryEntries.emplace_back(&entry);
-        }
+        registryEntries = message_registries::license::registry;
     }
     else
     {
@@ -201,42 +249,11 @@ inline void handleMessageRegistryGet(
         return;
     }
 
-    asyncResp->res.jsonValue = {{"@Redfish.Copyright", header->copyright},
-                                {"@odata.type", header->type},
-                                {"Id", header->id},
-                                {"Name", header->name},
-                                {"Language", header->language},
-                                {"Description", header->description},
-                                {"RegistryPrefix", header->registryPrefix},
-                                {"RegistryVersion", header->registryVersion},
-                                {"OwningEntity", header->owningEntity}};
-
-    nlohmann::json& messageObj = asyncResp->res.jsonValue["Messages"];
-
-    // Go through the Message Registry and populate each Message
-    for (const message_registries::MessageEntry* message : registryEntries)
-    {
-        nlohmann::json& obj = messageObj[message->first];
-        obj = {{"Description", message->second.description},
-               {"Message", message->second.message},
-               {"Severity", message->second.severity},
-               {"MessageSeverity", message->second.messageSeverity},
-               {"NumberOfArgs", message->second.numberOfArgs},
-               {"Resolution", message->second.resolution}};
-        if (message->second.numberOfArgs > 0)
-        {
-            nlohmann::json& messageParamArray = obj["ParamTypes"];
-            messageParamArray = nlohmann::json::array();
-            for (const char* str : message->second.paramTypes)
-            {
-                if (str == nullptr)
-                {
-                    break;
-                }
-                messageParamArray.push_back(str);
-            }
-        }
-    }
+    immutable_response::send(
+        req, asyncResp->res,
+        "/redfish/v1/Registries/" + registry + "/" + registry, [&]() {
+            return getMessageRegistry(*header, registryEntries);
+        });
 }
 
 inline void requestRoutesMessageRegistry(App& app)
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "utils/metric_report_ring.hpp"
 #include "utils/telemetry_utils.hpp"
 
 #include <app.hpp>
+#include <boost/container/flat_map.hpp>
 #include <registries/privilege_registry.hpp>
+#include <sdbusplus/bus/match.hpp>
+
+#include <charconv>
+#include <functional>
+#include <memory>
+#include <optional>
 
 namespace redfish
 {
@@ -11,30 +19,9 @@ namespace redfish
 namespace telemetry
 {
 
-using Readings =
-    std::vector<std::tuple<std::string, std::string, double, uint64_t>>;
-using TimestampReadings = std::tuple<uint64_t, Readings>;
-
-inline nlohmann::json toMetricValues(const Readings& readings)
-{
-    nlohmann::json metricValues = nlohmann::json::array_t();
-
-    for (auto& [id, metadata, sensorValue, timestamp] : readings)
-    {
-        metricValues.push_back({
-            {"MetricId", id},
-            {"MetricProperty", metadata},
-            {"MetricValue", std::to_string(sensorValue)},
-            {"Timestamp",
-             crow::utility::getDateTime(static_cast<time_t>(timestamp))},
-        });
-    }
-
-    return metricValues;
-}
-
-inline bool fillReport(nlohmann::json& json, const std::string& id,
-                       const std::variant<TimestampReadings>& var)
+inline void fillReport(nlohmann::json& json, const std::string& id,
+                       const ReadingsRing& readings,
+                       std::optional<uint64_t> since = std::nullopt)
 {
     json["@odata.type"] = "#MetricReport.v1_3_0.MetricReport";
     json["@odata.id"] = telemetry::metricReportUri + std::string("/") + id;
@@ -42,19 +29,205 @@ inline bool fillReport(nlohmann::json& json, const std::string& id,
     json["Name"] = id;
     json["MetricReportDefinition"]["@odata.id"] =
         telemetry::metricReportDefinitionUri + std::string("/") + id;
+    json["Timestamp"] =
+        crow::utility::getDateTime(static_cast<time_t>(readings.timestamp()));
+    json["MetricValues"] = readings.metricValues(since);
+}
 
-    const TimestampReadings* timestampReadings =
-        std::get_if<TimestampReadings>(&var);
-    if (!timestampReadings)
+/**
+ * @brief The last readings of every metric report, kept up to date from the
+ * PropertiesChanged signals of the telemetry service.
+ *
+ * MetricReport GETs are answered from here, and the EventService is told
+ * about every update through the listener, so it can send it on.  The
+ * readings of OnRequest reports only change when asked to, so GETs of those
+ * still go to the telemetry service.
+ */
+class ReportStore
+{
+  public:
+    enum class ReportingType
     {
-        BMCWEB_LOG_ERROR << "Property type mismatch or property is missing";
-        return false;
+        Unknown,
+        OnRequest,
+        // Periodic and OnChange, these send their readings by themselves
+        Signalled,
+    };
+
+    struct Report
+    {
+        ReadingsRing readings;
+        ReportingType type = ReportingType::Unknown;
+
+        bool typeKnown() const
+        {
+            return type != ReportingType::Unknown;
+        }
+
+        // Until the ReportingType is known, assume the worst
+        bool answeredFromStore() const
+        {
+            return type == ReportingType::Signalled;
+        }
+    };
+
+    using Listener =
+        std::function<void(const std::string& id, const ReadingsRing&)>;
+
+    static ReportStore& getInstance()
+    {
+        static ReportStore store;
+        return store;
     }
 
-    const auto& [timestamp, readings] = *timestampReadings;
-    json["Timestamp"] =
-        crow::utility::getDateTime(static_cast<time_t>(timestamp));
-    json["MetricValues"] = toMetricValues(readings);
+    // The matches can only be made once the bus connection exists, so they
+    // are set up on first use
+    void watch()
+    {
+        if (readingsMatch != nullptr)
+        {
+            return;
+        }
+        BMCWEB_LOG_DEBUG << "Metrics report signal - Register";
+        readingsMatch = std::make_unique<sdbusplus::bus::match::match>(
+            *crow::connections::systemBus,
+            "type='signal',member='PropertiesChanged',"
+            "interface='org.freedesktop.DBus.Properties',"
+            "arg0=xyz.openbmc_project.Telemetry.Report",
+            [this](sdbusplus::message::message& msg) {
+                if (msg.is_method_error())
+                {
+                    BMCWEB_LOG_ERROR << "TelemetryMonitor Signal error";
+                    return;
+                }
+                onPropertiesChanged(msg);
+            });
+        removedMatch = std::make_unique<sdbusplus::bus::match::match>(
+            *crow::connections::systemBus,
+            "type='signal',interface='org.freedesktop.DBus.ObjectManager',"
+            "member='InterfacesRemoved',sender='xyz.openbmc_project."
+            "Telemetry'",
+            [this](sdbusplus::message::message& msg) {
+                sdbusplus::message::object_path path;
+                msg.read(path);
+                reports.erase(path.filename());
+            });
+        ownerMatch = std::make_unique<sdbusplus::bus::match::match>(
+            *crow::connections::systemBus,
+            "type='signal',sender='org.freedesktop.DBus',"
+            "interface='org.freedesktop.DBus',member='NameOwnerChanged',"
+            "arg0='xyz.openbmc_project.Telemetry'",
+            [this](sdbusplus::message::message&) { reports.clear(); });
+    }
+
+    // Only one listener, the EventService
+    void setListener(Listener&& listenerIn)
+    {
+        listener = std::move(listenerIn);
+    }
+
+    const Report* find(const std::string& id) const
+    {
+        auto it = reports.find(id);
+        if (it == reports.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    const Report& update(const std::string& id,
+                         const TimestampReadings& readings)
+    {
+        Report& report = reports[id];
+        report.readings.push(readings);
+        return report;
+    }
+
+    void setReportingType(const std::string& id,
+                          const std::string& reportingType)
+    {
+        auto it = reports.find(id);
+        if (it != reports.end())
+        {
+            it->second.type = reportingType == "OnRequest"
+                                  ? ReportingType::OnRequest
+                                  : ReportingType::Signalled;
+        }
+    }
+
+  private:
+    ReportStore() = default;
+
+    void onPropertiesChanged(sdbusplus::message::message& msg)
+    {
+        sdbusplus::message::object_path path(msg.get_path());
+        std::string id = path.filename();
+        if (id.empty())
+        {
+            BMCWEB_LOG_ERROR << "Failed to get Id from path";
+            return;
+        }
+
+        std::string interface;
+        std::vector<
+            std::pair<std::string, std::variant<telemetry::TimestampReadings>>>
+            props;
+        std::vector<std::string> invalidProps;
+        msg.read(interface, props, invalidProps);
+
+        auto found =
+            std::find_if(props.begin(), props.end(),
+                         [](const auto& x) { return x.first == "Readings"; });
+        if (found == props.end())
+        {
+            BMCWEB_LOG_INFO << "Failed to get Readings from Report properties";
+            return;
+        }
+        const TimestampReadings* readings =
+            std::get_if<TimestampReadings>(&found->second);
+        if (readings == nullptr)
+        {
+            BMCWEB_LOG_ERROR << "Property type mismatch or property is missing";
+            return;
+        }
+
+        const Report& report = update(id, *readings);
+        if (listener)
+        {
+            listener(id, report.readings);
+        }
+    }
+
+    boost::container::flat_map<std::string, Report> reports;
+    Listener listener;
+    std::unique_ptr<sdbusplus::bus::match::match> readingsMatch;
+    std::unique_ptr<sdbusplus::bus::match::match> removedMatch;
+    std::unique_ptr<sdbusplus::bus::match::match> ownerMatch;
+};
+
+// Reads the bmcweb specific "since" parameter, the timestamp of the last
+// MetricValue the client has
+inline bool getSinceParam(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                          const crow::Request& req,
+                          std::optional<uint64_t>& since)
+{
+    boost::urls::query_params_view::iterator it = req.urlParams.find("since");
+    if (it == req.urlParams.end())
+    {
+        return true;
+    }
+    std::string sinceParam = it->value();
+    uint64_t value = 0;
+    const char* end = sinceParam.data() + sinceParam.size();
+    auto [ptr, ec] = std::from_chars(sinceParam.data(), end, value);
+    if (ec != std::errc() || ptr != end)
+    {
+        messages::queryParameterValueTypeError(asyncResp->res, sinceParam,
+                                               "since");
+        return false;
+    }
+    since = value;
     return true;
 }
 } // namespace telemetry
@@ -82,13 +255,31 @@ inline void requestRoutesMetricReport(App& app)
     BMCWEB_ROUTE(app, "/redfish/v1/TelemetryService/MetricReports/<str>/")
         .privileges(redfish::privileges::getMetricReport)
         .methods(boost::beast::http::verb::get)(
-            [](const crow::Request&,
+            [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                const std::string& id) {
+                std::optional<uint64_t> since;
+                if (!telemetry::getSinceParam(asyncResp, req, since))
+                {
+                    return;
+                }
+
+                telemetry::ReportStore& store =
+                    telemetry::ReportStore::getInstance();
+                store.watch();
+                const telemetry::ReportStore::Report* report = store.find(id);
+                if (report != nullptr && report->answeredFromStore())
+                {
+                    telemetry::fillReport(asyncResp->res.jsonValue, id,
+                                          report->readings, since);
+                    return;
+                }
+
                 const std::string reportPath = telemetry::getDbusReportPath(id);
                 crow::connections::systemBus->async_method_call(
-                    [asyncResp, id,
-                     reportPath](const boost::system::error_code& ec) {
+                    [asyncResp, id, since, reportPath,
+                     typeKnown{report != nullptr && report->typeKnown()}](
+                        const boost::system::error_code& ec) {
                         if (ec.value() == EBADR ||
                             ec == boost::system::errc::host_unreachable)
                         {
@@ -104,10 +295,10 @@ inline void requestRoutesMetricReport(App& app)
                         }
 
                         crow::connections::systemBus->async_method_call(
-                            [asyncResp,
-                             id](const boost::system::error_code ec,
-                                 const std::variant<
-                                     telemetry::TimestampReadings>& ret) {
+                            [asyncResp, id,
+                             since](const boost::system::error_code ec,
+                                    const std::variant<
+                                        telemetry::TimestampReadings>& ret) {
                                 if (ec)
                                 {
                                     BMCWEB_LOG_ERROR
@@ -116,15 +307,51 @@ inline void requestRoutesMetricReport(App& app)
                                     return;
                                 }
 
-                                if (!telemetry::fillReport(
-                                        asyncResp->res.jsonValue, id, ret))
+                                const telemetry::TimestampReadings* readings =
+                                    std::get_if<telemetry::TimestampReadings>(
+                                        &ret);
+                                if (readings == nullptr)
                                 {
+                                    BMCWEB_LOG_ERROR
+                                        << "Property type mismatch or "
+                                           "property is missing";
                                     messages::internalError(asyncResp->res);
+                                    return;
                                 }
+                                telemetry::fillReport(
+                                    asyncResp->res.jsonValue, id,
+                                    telemetry::ReportStore::getInstance()
+                                        .update(id, *readings)
+                                        .readings,
+                                    since);
                             },
                             telemetry::service, reportPath,
                             "org.freedesktop.DBus.Properties", "Get",
                             telemetry::reportInterface, "Readings");
+
+                        // Reports first seen through a signal don't have
+                        // their type yet either
+                        if (typeKnown)
+                        {
+                            return;
+                        }
+                        // Periodic and OnChange reports are answered from
+                        // the store from now on
+                        crow::connections::systemBus->async_method_call(
+                            [id](const boost::system::error_code ec,
+                                 const std::variant<std::string>& ret) {
+                                const std::string* reportingType =
+                                    std::get_if<std::string>(&ret);
+                                if (ec || reportingType == nullptr)
+                                {
+                                    return;
+                                }
+                                telemetry::ReportStore::getInstance()
+                                    .setReportingType(id, *reportingType);
+                            },
+                            telemetry::service, reportPath,
+                            "org.freedesktop.DBus.Properties", "Get",
+                            telemetry::reportInterface, "ReportingType");
                     },
                     telemetry::service, reportPath, telemetry::reportInterface,
                     "Update");
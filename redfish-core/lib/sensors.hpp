@@ -20,7 +20,9 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/range/algorithm/replace_copy_if.hpp>
+#include <coroutine.hpp>
 #include <dbus_singleton.hpp>
+#include <dbus_utility.hpp>
 #include <registries/privilege_registry.hpp>
 #include <utils/json_utils.hpp>
 
@@ -378,7 +380,7 @@ void getObjectsWithConnection(
         BMCWEB_LOG_DEBUG << "getObjectsWithConnection resp_handler exit";
     };
     // Make call to ObjectMapper to find all sensors objects
-    crow::connections::systemBus->async_method_call(
+    dbus::utility::coalescedMethodCall<GetSubTreeType>(
         std::move(respHandler), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetSubTree", path, 2, interfaces);
@@ -708,7 +710,7 @@ void getObjectManagerPaths(
     };
 
     // Query mapper for all DBus object paths that implement ObjectManager
-    crow::connections::systemBus->async_method_call(
+    dbus::utility::coalescedMethodCall<GetSubTreeType>(
         std::move(respHandler), "xyz.openbmc_project.ObjectMapper",
         "/xyz/openbmc_project/object_mapper",
         "xyz.openbmc_project.ObjectMapper", "GetSubTree", "/", 0, interfaces);
@@ -2359,6 +2361,80 @@ void getPowerSupplyAttributes(
     BMCWEB_LOG_DEBUG << "getPowerSupplyAttributes exit";
 }
 
+// The steps of getInventoryItems(), one after the other
+template <typename Callback>
+static crow::coro::Task<> getInventoryItemsTask(
+    std::shared_ptr<bmcweb::AsyncResp> asyncResp,
+    std::shared_ptr<SensorsAsyncResp> sensorsAsyncResp,
+    std::shared_ptr<boost::container::flat_set<std::string>> sensorNames,
+    std::shared_ptr<boost::container::flat_map<std::string, std::string>>
+        objectMgrPaths,
+    Callback callback)
+{
+    using InventoryItems = std::shared_ptr<std::vector<InventoryItem>>;
+    BMCWEB_LOG_DEBUG << "getInventoryItems enter";
+
+    // Each step drops its callback once it has reported an error, which ends
+    // this task with whatever the response holds
+
+    // Get associations from sensors to inventory items
+    auto associated =
+        co_await crow::coro::callbackOp<InventoryItems>([&](auto&& done) {
+            getInventoryItemAssociations(sensorsAsyncResp, sensorNames,
+                                         objectMgrPaths, std::move(done));
+        });
+    if (!associated)
+    {
+        co_return;
+    }
+    InventoryItems inventoryItems = std::get<0>(*associated);
+
+    // Get connections that provide inventory item data
+    auto invConnections = co_await crow::coro::callbackOp<
+        std::shared_ptr<boost::container::flat_set<std::string>>>(
+        [&](auto&& done) {
+            getInventoryItemsConnections(sensorsAsyncResp, inventoryItems,
+                                         std::move(done));
+        });
+    if (!invConnections)
+    {
+        co_return;
+    }
+
+    // Get inventory item data from connections
+    auto gotData = co_await crow::coro::callbackOp<>([&](auto&& done) {
+        getInventoryItemsData(sensorsAsyncResp, inventoryItems,
+                              std::get<0>(*invConnections), objectMgrPaths,
+                              std::move(done));
+    });
+    if (!gotData)
+    {
+        co_return;
+    }
+
+    // Find led connections and get the data
+    auto gotLeds = co_await crow::coro::callbackOp<>([&](auto&& done) {
+        getInventoryLeds(sensorsAsyncResp, inventoryItems, std::move(done));
+    });
+    if (!gotLeds)
+    {
+        co_return;
+    }
+
+    // Find Power Supply Attributes and get the data
+    auto withAttributes =
+        co_await crow::coro::callbackOp<InventoryItems>([&](auto&& done) {
+            getPowerSupplyAttributes(sensorsAsyncResp, inventoryItems,
+                                     std::move(done));
+        });
+    if (!withAttributes)
+    {
+        co_return;
+    }
+    callback(std::get<0>(*withAttributes));
+    BMCWEB_LOG_DEBUG << "getInventoryItems exit";
+}
+
 /**
  * @brief Gets inventory items associated with sensors.
  *
@@ -2390,58 +2466,9 @@ static void getInventoryItems(
         objectMgrPaths,
     Callback&& callback)
 {
-    BMCWEB_LOG_DEBUG << "getInventoryItems enter";
-    auto getInventoryItemAssociationsCb =
-        [sensorsAsyncResp, objectMgrPaths, callback{std::move(callback)}](
-            std::shared_ptr<std::vector<InventoryItem>> inventoryItems) {
-            BMCWEB_LOG_DEBUG << "getInventoryItemAssociationsCb enter";
-            auto getInventoryItemsConnectionsCb =
-                [sensorsAsyncResp, inventoryItems, objectMgrPaths,
-                 callback{std::move(callback)}](
-                    std::shared_ptr<boost::container::flat_set<std::string>>
-                        invConnections) {
-                    BMCWEB_LOG_DEBUG << "getInventoryItemsConnectionsCb enter";
-                    auto getInventoryItemsDataCb =
-                        [sensorsAsyncResp, inventoryItems,
-                         callback{std::move(callback)}]() {
-                            BMCWEB_LOG_DEBUG << "getInventoryItemsDataCb enter";
-
-                            auto getInventoryLedsCb = [sensorsAsyncResp,
-                                                       inventoryItems,
-                                                       callback{std::move(
-                                                           callback)}]() {
-                                BMCWEB_LOG_DEBUG << "getInventoryLedsCb enter";
-                                // Find Power Supply Attributes and get the data
-                                getPowerSupplyAttributes(sensorsAsyncResp,
-                                                         inventoryItems,
-                                                         std::move(callback));
-                                BMCWEB_LOG_DEBUG << "getInventoryLedsCb exit";
-                            };
-
-                            // Find led connections and get the data
-                            getInventoryLeds(sensorsAsyncResp, inventoryItems,
-                                             std::move(getInventoryLedsCb));
-                            BMCWEB_LOG_DEBUG << "getInventoryItemsDataCb exit";
-                        };
-
-                    // Get inventory item data from connections
-                    getInventoryItemsData(sensorsAsyncResp, inventoryItems,
-                                          invConnections, objectMgrPaths,
-                                          std::move(getInventoryItemsDataCb));
-                    BMCWEB_LOG_DEBUG << "getInventoryItemsConnectionsCb exit";
-                };
-
-            // Get connections that provide inventory item data
-            getInventoryItemsConnections(
-                sensorsAsyncResp, inventoryItems,
-                std::move(getInventoryItemsConnectionsCb));
-            BMCWEB_LOG_DEBUG << "getInventoryItemAssociationsCb exit";
-        };
-
-    // Get associations from sensors to inventory items
-    getInventoryItemAssociations(sensorsAsyncResp, sensorNames, objectMgrPaths,
-                                 std::move(getInventoryItemAssociationsCb));
-    BMCWEB_LOG_DEBUG << "getInventoryItems exit";
+    crow::coro::spawn(getInventoryItemsTask(
+        sensorsAsyncResp->asyncResp, sensorsAsyncResp, sensorNames,
+        objectMgrPaths, std::forward<Callback>(callback)));
 }
 
 /**
@@ -2544,7 +2571,7 @@ inline void getSensorData(
         auto getManagedObjectsCb = [sensorsAsyncResp, sensorNames,
                                     inventoryItems](
                                        const boost::system::error_code ec,
-                                       ManagedObjectsVectorType& resp) {
+                                       const ManagedObjectsVectorType& resp) {
             BMCWEB_LOG_DEBUG << "getManagedObjectsCb enter";
             if (ec)
             {
@@ -2705,7 +2732,7 @@ inline void getSensorData(
         BMCWEB_LOG_DEBUG << "ObjectManager path for " << connection << " is "
                          << objectMgrPath;
 
-        crow::connections::systemBus->async_method_call(
+        dbus::utility::coalescedMethodCall<ManagedObjectsVectorType>(
             getManagedObjectsCb, connection, objectMgrPath,
             "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
     }
@@ -3246,7 +3273,7 @@ inline void getThermalSensorData(
         auto getManagedObjectsCb = [sensorsAsyncResp, sensorNames,
                                     inventoryItems](
                                        const boost::system::error_code ec,
-                                       ManagedObjectsVectorType& resp) {
+                                       const ManagedObjectsVectorType& resp) {
             if (ec)
             {
                 BMCWEB_LOG_ERROR << "getManagedObjectsCb DBUS error: " << ec;
@@ -3322,7 +3349,7 @@ inline void getThermalSensorData(
         BMCWEB_LOG_DEBUG << "ObjectManager path for " << connection << " is "
                          << objectMgrPath;
 
-        crow::connections::systemBus->async_method_call(
+        dbus::utility::coalescedMethodCall<ManagedObjectsVectorType>(
             getManagedObjectsCb, connection, objectMgrPath,
             "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
     }
@@ -23,9 +23,12 @@
 #endif
 #include <app.hpp>
 #include <boost/container/flat_map.hpp>
+#include <coroutine.hpp>
 #include <registries/privilege_registry.hpp>
 #include <utils/fw_utils.hpp>
+#include <utils/immutable_response.hpp>
 #include <utils/json_utils.hpp>
+#include <utils/property_plan.hpp>
 
 #include <variant>
 
@@ -293,308 +296,278 @@ inline void getProcessorSummary(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
 }
 
 /*
- * @brief Retrieves computer system properties over dbus
+ * @brief Adds the memory of a DIMM to MemorySummary
  *
  * @param[in] aResp Shared pointer for completing asynchronous calls
+ * @param[in] service dbus service for Dimm Information
+ * @param[in] path dbus path for Dimm
  *
  * @return None.
  */
-inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+inline crow::coro::Task<>
+    getDimmSummary(std::shared_ptr<bmcweb::AsyncResp> aResp,
+                   std::string service, std::string path)
 {
-    BMCWEB_LOG_DEBUG << "Get available system components.";
+    auto properties = co_await dbus::utility::methodCall<
+        std::vector<std::pair<std::string, VariantType>>>(
+        service, path, "org.freedesktop.DBus.Properties", "GetAll",
+        "xyz.openbmc_project.Inventory.Item.Dimm");
+    if (properties.ec)
+    {
+        BMCWEB_LOG_ERROR << "DBUS response error " << properties.ec;
+        messages::internalError(aResp->res);
+        co_return;
+    }
+    BMCWEB_LOG_DEBUG << "Got " << properties.value.size()
+                     << " Dimm properties.";
 
-    crow::connections::systemBus->async_method_call(
-        [aResp](
-            const boost::system::error_code ec,
-            const std::vector<std::pair<
-                std::string,
-                std::vector<std::pair<std::string, std::vector<std::string>>>>>&
-                subtree) {
-            if (ec)
+    if (properties.value.empty())
+    {
+        dbus::utility::MethodResult<std::variant<bool>> dimmState =
+            co_await dbus::utility::methodCall<std::variant<bool>>(
+                service, path, "org.freedesktop.DBus.Properties", "Get",
+                "xyz.openbmc_project.State.Decorator.OperationalStatus",
+                "Functional");
+        if (dimmState.ec)
+        {
+            BMCWEB_LOG_ERROR << "DBUS response error " << dimmState.ec;
+            co_return;
+        }
+        updateDimmProperties(aResp, dimmState.value);
+        co_return;
+    }
+
+    for (const std::pair<std::string, VariantType>& property :
+         properties.value)
+    {
+        if (property.first != "MemorySizeInKB")
+        {
+            continue;
+        }
+        const uint32_t* value = std::get_if<uint32_t>(&property.second);
+        if (value == nullptr)
+        {
+            BMCWEB_LOG_DEBUG << "Find incorrect type of MemorySize";
+            continue;
+        }
+        nlohmann::json& totalMemory =
+            aResp->res.jsonValue["MemorySummary"]["TotalSystemMemoryGiB"];
+        uint64_t* preValue = totalMemory.get_ptr<uint64_t*>();
+        if (preValue == nullptr)
+        {
+            continue;
+        }
+        aResp->res.jsonValue["MemorySummary"]["TotalSystemMemoryGiB"] =
+            *value / (1024 * 1024) + *preValue;
+        aResp->res.jsonValue["MemorySummary"]["Status"]["State"] = "Enabled";
+    }
+}
+
+/*
+ * @brief Fills in the UUID of the system
+ *
+ * @param[in] aResp Shared pointer for completing asynchronous calls
+ * @param[in] service dbus service for the UUID
+ * @param[in] path dbus path for the UUID
+ *
+ * @return None.
+ */
+inline crow::coro::Task<>
+    getSystemUuid(std::shared_ptr<bmcweb::AsyncResp> aResp, std::string service,
+                  std::string path)
+{
+    auto properties = co_await dbus::utility::methodCall<
+        std::vector<std::pair<std::string, VariantType>>>(
+        service, path, "org.freedesktop.DBus.Properties", "GetAll",
+        "xyz.openbmc_project.Common.UUID");
+    if (properties.ec)
+    {
+        BMCWEB_LOG_DEBUG << "DBUS response error " << properties.ec;
+        messages::internalError(aResp->res);
+        co_return;
+    }
+    BMCWEB_LOG_DEBUG << "Got " << properties.value.size()
+                     << " UUID properties.";
+    for (const std::pair<std::string, VariantType>& property :
+         properties.value)
+    {
+        if (property.first != "UUID")
+        {
+            continue;
+        }
+        const std::string* value = std::get_if<std::string>(&property.second);
+        if (value == nullptr)
+        {
+            continue;
+        }
+        std::string valueStr = *value;
+        if (valueStr.size() == 32)
+        {
+            valueStr.insert(8, 1, '-');
+            valueStr.insert(13, 1, '-');
+            valueStr.insert(18, 1, '-');
+            valueStr.insert(23, 1, '-');
+        }
+        BMCWEB_LOG_DEBUG << "UUID = " << valueStr;
+        aResp->res.jsonValue["UUID"] = valueStr;
+    }
+}
+
+/*
+ * @brief Fills in the asset information of the system and the BIOS version
+ *
+ * @param[in] aResp Shared pointer for completing asynchronous calls
+ * @param[in] service dbus service for the system
+ * @param[in] path dbus path for the system
+ *
+ * @return None.
+ */
+inline crow::coro::Task<>
+    getSystemAsset(std::shared_ptr<bmcweb::AsyncResp> aResp,
+                   std::string service, std::string path)
+{
+    auto asset = co_await dbus::utility::methodCall<
+        std::vector<std::pair<std::string, VariantType>>>(
+        service, path, "org.freedesktop.DBus.Properties", "GetAll",
+        "xyz.openbmc_project.Inventory.Decorator.Asset");
+    if (asset.ec)
+    {
+        // doesn't have to include this interface
+        co_return;
+    }
+    BMCWEB_LOG_DEBUG << "Got " << asset.value.size()
+                     << " properties for system";
+    for (const std::pair<std::string, VariantType>& property : asset.value)
+    {
+        const std::string& propertyName = property.first;
+        if ((propertyName == "PartNumber") ||
+            (propertyName == "SerialNumber") ||
+            (propertyName == "Manufacturer") || (propertyName == "Model") ||
+            (propertyName == "SubModel"))
+        {
+            const std::string* value =
+                std::get_if<std::string>(&property.second);
+            if (value != nullptr)
             {
-                BMCWEB_LOG_DEBUG << "DBUS response error";
-                messages::internalError(aResp->res);
-                return;
+                aResp->res.jsonValue[propertyName] = *value;
             }
-            // Iterate over all retrieved ObjectPaths.
-            for (const std::pair<std::string,
-                                 std::vector<std::pair<
-                                     std::string, std::vector<std::string>>>>&
-                     object : subtree)
+        }
+    }
+
+    // Grab the bios version
+    fw_util::populateFirmwareInformation(aResp, fw_util::biosPurpose,
+                                         "BiosVersion", false);
+}
+
+/*
+ * @brief Fills in the asset tag of the system
+ *
+ * @param[in] aResp Shared pointer for completing asynchronous calls
+ * @param[in] service dbus service for the system
+ * @param[in] path dbus path for the system
+ *
+ * @return None.
+ */
+inline crow::coro::Task<>
+    getSystemAssetTag(std::shared_ptr<bmcweb::AsyncResp> aResp,
+                      std::string service, std::string path)
+{
+    auto assetTag = co_await dbus::utility::methodCall<
+        std::variant<std::string>>(
+        service, path, "org.freedesktop.DBus.Properties", "Get",
+        "xyz.openbmc_project.Inventory.Decorator.AssetTag", "AssetTag");
+    if (assetTag.ec)
+    {
+        // doesn't have to include this interface
+        co_return;
+    }
+    const std::string* value = std::get_if<std::string>(&assetTag.value);
+    if (value != nullptr)
+    {
+        aResp->res.jsonValue["AssetTag"] = *value;
+    }
+}
+
+inline crow::coro::Task<>
+    getComputerSystemTask(std::shared_ptr<bmcweb::AsyncResp> aResp)
+{
+    dbus::utility::MethodResult<dbus::utility::MapperGetSubTreeResponse>
+        subtree =
+            co_await dbus::utility::methodCall<
+                dbus::utility::MapperGetSubTreeResponse>(
+                "xyz.openbmc_project.ObjectMapper",
+                "/xyz/openbmc_project/object_mapper",
+                "xyz.openbmc_project.ObjectMapper", "GetSubTree",
+                "/xyz/openbmc_project/inventory", int32_t(0),
+                std::array<const char*, 5>{
+                    "xyz.openbmc_project.Inventory.Decorator.Asset",
+                    "xyz.openbmc_project.Inventory.Item.Cpu",
+                    "xyz.openbmc_project.Inventory.Item.Dimm",
+                    "xyz.openbmc_project.Inventory.Item.System",
+                    "xyz.openbmc_project.Common.UUID",
+                });
+    if (subtree.ec)
+    {
+        BMCWEB_LOG_DEBUG << "DBUS response error";
+        messages::internalError(aResp->res);
+        co_return;
+    }
+    // Iterate over all retrieved ObjectPaths.  The properties of each are
+    // fetched together, each task holds the response open until it is done.
+    for (const std::pair<std::string, dbus::utility::MapperServiceMap>&
+             object : subtree.value)
+    {
+        const std::string& path = object.first;
+        BMCWEB_LOG_DEBUG << "Got path: " << path;
+
+        // This is not system, so check if it's cpu, dimm, UUID or BiosVer
+        for (const auto& connection : object.second)
+        {
+            for (const auto& interfaceName : connection.second)
             {
-                const std::string& path = object.first;
-                BMCWEB_LOG_DEBUG << "Got path: " << path;
-                const std::vector<
-                    std::pair<std::string, std::vector<std::string>>>&
-                    connectionNames = object.second;
-                if (connectionNames.size() < 1)
+                if (interfaceName == "xyz.openbmc_project.Inventory.Item.Dimm")
                 {
-                    continue;
+                    BMCWEB_LOG_DEBUG << "Found Dimm, now get its properties.";
+                    crow::coro::spawn(
+                        getDimmSummary(aResp, connection.first, path));
                 }
-
-                // This is not system, so check if it's cpu, dimm, UUID or
-                // BiosVer
-                for (const auto& connection : connectionNames)
+                else if (interfaceName ==
+                         "xyz.openbmc_project.Inventory.Item.Cpu")
                 {
-                    for (const auto& interfaceName : connection.second)
-                    {
-                        if (interfaceName ==
-                            "xyz.openbmc_project.Inventory.Item.Dimm")
-                        {
-                            BMCWEB_LOG_DEBUG
-                                << "Found Dimm, now get its properties.";
-
-                            crow::connections::systemBus->async_method_call(
-                                [aResp, service{connection.first},
-                                 path](const boost::system::error_code ec2,
-                                       const std::vector<
-                                           std::pair<std::string, VariantType>>&
-                                           properties) {
-                                    if (ec2)
-                                    {
-                                        BMCWEB_LOG_ERROR
-                                            << "DBUS response error " << ec2;
-                                        messages::internalError(aResp->res);
-                                        return;
-                                    }
-                                    BMCWEB_LOG_DEBUG << "Got "
-                                                     << properties.size()
-                                                     << " Dimm properties.";
-
-                                    if (properties.size() > 0)
-                                    {
-                                        for (const std::pair<std::string,
-                                                             VariantType>&
-                                                 property : properties)
-                                        {
-                                            if (property.first !=
-                                                "MemorySizeInKB")
-                                            {
-                                                continue;
-                                            }
-                                            const uint32_t* value =
-                                                std::get_if<uint32_t>(
-                                                    &property.second);
-                                            if (value == nullptr)
-                                            {
-                                                BMCWEB_LOG_DEBUG
-                                                    << "Find incorrect type of "
-                                                       "MemorySize";
-                                                continue;
-                                            }
-                                            nlohmann::json& totalMemory =
-                                                aResp->res
-                                                    .jsonValue["MemorySummar"
-                                                               "y"]
-                                                              ["TotalSystemMe"
-                                                               "moryGiB"];
-                                            uint64_t* preValue =
-                                                totalMemory
-                                                    .get_ptr<uint64_t*>();
-                                            if (preValue == nullptr)
-                                            {
-                                                continue;
-                                            }
-                                            aResp->res
-                                                .jsonValue["MemorySummary"]
-                                                          ["TotalSystemMemoryGi"
-                                                           "B"] =
-                                                *value / (1024 * 1024) +
-                                                *preValue;
-                                            aResp->res
-                                                .jsonValue["MemorySummary"]
-                                                          ["Status"]["State"] =
-                                                "Enabled";
-                                        }
-                                    }
-                                    else
-                                    {
-                                        auto getDimmProperties =
-                                            [aResp](
-                                                const boost::system::error_code
-                                                    ec3,
-                                                const std::variant<bool>&
-                                                    dimmState) {
-                                                if (ec3)
-                                                {
-                                                    BMCWEB_LOG_ERROR
-                                                        << "DBUS response "
-                                                           "error "
-                                                        << ec3;
-                                                    return;
-                                                }
-                                                updateDimmProperties(aResp,
-                                                                     dimmState);
-                                            };
-                                        crow::connections::systemBus
-                                            ->async_method_call(
-                                                std::move(getDimmProperties),
-                                                service, path,
-                                                "org.freedesktop.DBus."
-                                                "Properties",
-                                                "Get",
-                                                "xyz.openbmc_project.State."
-                                                "Decorator.OperationalStatus",
-                                                "Functional");
-                                    }
-                                },
-                                connection.first, path,
-                                "org.freedesktop.DBus.Properties", "GetAll",
-                                "xyz.openbmc_project.Inventory.Item.Dimm");
-                        }
-                        else if (interfaceName ==
-                                 "xyz.openbmc_project.Inventory.Item.Cpu")
-                        {
-                            BMCWEB_LOG_DEBUG
-                                << "Found Cpu, now get its properties.";
+                    BMCWEB_LOG_DEBUG << "Found Cpu, now get its properties.";
 
-                            getProcessorSummary(aResp, connection.first, path);
-                        }
-                        else if (interfaceName ==
-                                 "xyz.openbmc_project.Common.UUID")
-                        {
-                            BMCWEB_LOG_DEBUG
-                                << "Found UUID, now get its properties.";
-                            crow::connections::systemBus->async_method_call(
-                                [aResp](
-                                    const boost::system::error_code ec3,
-                                    const std::vector<
-                                        std::pair<std::string, VariantType>>&
-                                        properties) {
-                                    if (ec3)
-                                    {
-                                        BMCWEB_LOG_DEBUG
-                                            << "DBUS response error " << ec3;
-                                        messages::internalError(aResp->res);
-                                        return;
-                                    }
-                                    BMCWEB_LOG_DEBUG << "Got "
-                                                     << properties.size()
-                                                     << " UUID properties.";
-                                    for (const std::pair<std::string,
-                                                         VariantType>&
-                                             property : properties)
-                                    {
-                                        if (property.first == "UUID")
-                                        {
-                                            const std::string* value =
-                                                std::get_if<std::string>(
-                                                    &property.second);
-
-                                            if (value != nullptr)
-                                            {
-                                                std::string valueStr = *value;
-                                                if (valueStr.size() == 32)
-                                                {
-                                                    valueStr.insert(8, 1, '-');
-                                                    valueStr.insert(13, 1, '-');
-                                                    valueStr.insert(18, 1, '-');
-                                                    valueStr.insert(23, 1, '-');
-                                                }
-                                                BMCWEB_LOG_DEBUG << "UUID = "
-                                                                 << valueStr;
-                                                aResp->res.jsonValue["UUID"] =
-                                                    valueStr;
-                                            }
-                                        }
-                                    }
-                                },
-                                connection.first, path,
-                                "org.freedesktop.DBus.Properties", "GetAll",
-                                "xyz.openbmc_project.Common.UUID");
-                        }
-                        else if (interfaceName ==
-                                 "xyz.openbmc_project.Inventory.Item.System")
-                        {
-                            crow::connections::systemBus->async_method_call(
-                                [aResp](
-                                    const boost::system::error_code ec2,
-                                    const std::vector<
-                                        std::pair<std::string, VariantType>>&
-                                        propertiesList) {
-                                    if (ec2)
-                                    {
-                                        // doesn't have to include this
-                                        // interface
-                                        return;
-                                    }
-                                    BMCWEB_LOG_DEBUG
-                                        << "Got " << propertiesList.size()
-                                        << " properties for system";
-                                    for (const std::pair<std::string,
-                                                         VariantType>&
-                                             property : propertiesList)
-                                    {
-                                        const std::string& propertyName =
-                                            property.first;
-                                        if ((propertyName == "PartNumber") ||
-                                            (propertyName == "SerialNumber") ||
-                                            (propertyName == "Manufacturer") ||
-                                            (propertyName == "Model") ||
-                                            (propertyName == "SubModel"))
-                                        {
-                                            const std::string* value =
-                                                std::get_if<std::string>(
-                                                    &property.second);
-                                            if (value != nullptr)
-                                            {
-                                                aResp->res
-                                                    .jsonValue[propertyName] =
-                                                    *value;
-                                            }
-                                        }
-                                    }
-
-                                    // Grab the bios version
-                                    fw_util::populateFirmwareInformation(
-                                        aResp, fw_util::biosPurpose,
-                                        "BiosVersion", false);
-                                },
-                                connection.first, path,
-                                "org.freedesktop.DBus.Properties", "GetAll",
-                                "xyz.openbmc_project.Inventory.Decorator."
-                                "Asset");
-
-                            crow::connections::systemBus->async_method_call(
-                                [aResp](
-                                    const boost::system::error_code ec2,
-                                    const std::variant<std::string>& property) {
-                                    if (ec2)
-                                    {
-                                        // doesn't have to include this
-                                        // interface
-                                        return;
-                                    }
-
-                                    const std::string* value =
-                                        std::get_if<std::string>(&property);
-                                    if (value != nullptr)
-                                    {
-                                        aResp->res.jsonValue["AssetTag"] =
-                                            *value;
-                                    }
-                                },
-                                connection.first, path,
-                                "org.freedesktop.DBus.Properties", "Get",
-                                "xyz.openbmc_project.Inventory.Decorator."
-                                "AssetTag",
-                                "AssetTag");
-                        }
-                    }
+                    getProcessorSummary(aResp, connection.first, path);
+                }
+                else if (interfaceName == "xyz.openbmc_project.Common.UUID")
+                {
+                    BMCWEB_LOG_DEBUG << "Found UUID, now get its properties.";
+                    crow::coro::spawn(
+                        getSystemUuid(aResp, connection.first, path));
+                }
+                else if (interfaceName ==
+                         "xyz.openbmc_project.Inventory.Item.System")
+                {
+                    crow::coro::spawn(
+                        getSystemAsset(aResp, connection.first, path));
+                    crow::coro::spawn(
+                        getSystemAssetTag(aResp, connection.first, path));
                 }
             }
-        },
-        "xyz.openbmc_project.ObjectMapper",
-        "/xyz/openbmc_project/object_mapper",
-        "xyz.openbmc_project.ObjectMapper", "GetSubTree",
-        "/xyz/openbmc_project/inventory", int32_t(0),
-        std::array<const char*, 5>{
-            "xyz.openbmc_project.Inventory.Decorator.Asset",
-            "xyz.openbmc_project.Inventory.Item.Cpu",
-            "xyz.openbmc_project.Inventory.Item.Dimm",
-            "xyz.openbmc_project.Inventory.Item.System",
-            "xyz.openbmc_project.Common.UUID",
-        });
+        }
+    }
+}
+
+/*
+ * @brief Retrieves computer system properties over dbus
+ *
+ * @param[in] aResp Shared pointer for completing asynchronous calls
+ *
+ * @return None.
+ */
+inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+{
+    BMCWEB_LOG_DEBUG << "Get available system components.";
+    crow::coro::spawn(getComputerSystemTask(aResp));
 }
 
 /**
@@ -604,12 +577,15 @@ inline void getComputerSystem(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
  *
  * @return None.
  */
-inline void getHostState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+inline void getHostState(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                         const std::shared_ptr<PropertyPlan>& plan)
 {
     BMCWEB_LOG_DEBUG << "Get host information.";
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
-                const std::variant<std::string>& hostState) {
+    plan->add(
+        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
+        "xyz.openbmc_project.State.Host",
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
             if (ec)
             {
                 if (ec == boost::system::errc::host_unreachable)
@@ -624,7 +600,12 @@ inline void getHostState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                 return;
             }
 
-            const std::string* s = std::get_if<std::string>(&hostState);
+            auto hostState = properties.find("CurrentHostState");
+            if (hostState == properties.end())
+            {
+                return;
+            }
+            const std::string* s = std::get_if<std::string>(&hostState->second);
             BMCWEB_LOG_DEBUG << "Host state: " << *s;
             if (s != nullptr)
             {
@@ -664,10 +645,7 @@ inline void getHostState(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
                     aResp->res.jsonValue["Status"]["State"] = "Disabled";
                 }
             }
-        },
-        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
-        "org.freedesktop.DBus.Properties", "Get",
-        "xyz.openbmc_project.State.Host", "CurrentHostState");
+        });
 }
 
 /**
@@ -698,12 +676,16 @@ inline std::string dbusToRfBootType(const std::string& dbusType)
  *
  * @return None.
  */
-inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                            const std::shared_ptr<PropertyPlan>& plan)
 {
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
-                const std::variant<std::string>& bootProgress) {
-            if (ec)
+    plan->add(
+        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
+        "xyz.openbmc_project.State.Boot.Progress",
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
+            auto bootProgress = properties.find("BootProgress");
+            if (ec || bootProgress == properties.end())
             {
                 // BootProgress is an optional object so just do nothing if
                 // not found
@@ -711,7 +693,7 @@ inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             }
 
             const std::string* bootProgressStr =
-                std::get_if<std::string>(&bootProgress);
+                std::get_if<std::string>(&bootProgress->second);
 
             if (!bootProgressStr)
             {
@@ -793,10 +775,7 @@ inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             }
 
             aResp->res.jsonValue["BootProgress"]["LastState"] = rfBpLastState;
-        },
-        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
-        "org.freedesktop.DBus.Properties", "Get",
-        "xyz.openbmc_project.State.Boot.Progress", "BootProgress");
+        });
 }
 
 /**
@@ -811,21 +790,30 @@ inline void getBootProgress(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
  *
  * @return None.
  */
-inline void getLastResetTime(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+inline void getLastResetTime(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                             const std::shared_ptr<PropertyPlan>& plan)
 {
     BMCWEB_LOG_DEBUG << "Getting System Last Reset Time";
 
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
-                std::variant<uint64_t>& lastResetTime) {
+    plan->add(
+        "xyz.openbmc_project.State.Chassis",
+        "/xyz/openbmc_project/state/chassis0",
+        "xyz.openbmc_project.State.Chassis",
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << "D-BUS response error " << ec;
                 return;
             }
+            auto lastResetTime = properties.find("LastStateChangeTime");
+            if (lastResetTime == properties.end())
+            {
+                return;
+            }
 
             const uint64_t* lastResetTimePtr =
-                std::get_if<uint64_t>(&lastResetTime);
+                std::get_if<uint64_t>(&lastResetTime->second);
 
             if (!lastResetTimePtr)
             {
@@ -840,11 +828,7 @@ inline void getLastResetTime(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             // Convert to ISO 8601 standard
             aResp->res.jsonValue["LastResetTime"] =
                 crow::utility::getDateTime(lastResetTimeStamp);
-        },
-        "xyz.openbmc_project.State.Chassis",
-        "/xyz/openbmc_project/state/chassis0",
-        "org.freedesktop.DBus.Properties", "Get",
-        "xyz.openbmc_project.State.Chassis", "LastStateChangeTime");
+        });
 }
 
 /**
@@ -854,21 +838,39 @@ inline void getLastResetTime(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
  *
  * @return None.
  */
-inline void getAutomaticRetry(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+inline void getAutomaticRetry(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                              const std::shared_ptr<PropertyPlan>& plan)
 {
     BMCWEB_LOG_DEBUG << "Get Automatic Retry policy";
 
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
-                std::variant<bool>& autoRebootEnabled) {
+    // The attempts left only matter when AutoReboot is enabled, but both are
+    // fetched together and rendered once the plan has finished
+    struct AutomaticRetry
+    {
+        std::optional<bool> enabled;
+        std::optional<uint32_t> attemptsLeft;
+    };
+    auto retry = std::make_shared<AutomaticRetry>();
+
+    plan->add(
+        "xyz.openbmc_project.Settings",
+        "/xyz/openbmc_project/control/host0/auto_reboot",
+        "xyz.openbmc_project.Control.Boot.RebootPolicy",
+        [aResp, retry](const boost::system::error_code& ec,
+                       const dbus::utility::DBusPropertiesMap& properties) {
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << "D-BUS response error " << ec;
                 return;
             }
+            auto autoRebootEnabled = properties.find("AutoReboot");
+            if (autoRebootEnabled == properties.end())
+            {
+                return;
+            }
 
             const bool* autoRebootEnabledPtr =
-                std::get_if<bool>(&autoRebootEnabled);
+                std::get_if<bool>(&autoRebootEnabled->second);
 
             if (!autoRebootEnabledPtr)
             {
@@ -877,65 +879,72 @@ inline void getAutomaticRetry(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
             }
 
             BMCWEB_LOG_DEBUG << "Auto Reboot: " << *autoRebootEnabledPtr;
-            if (*autoRebootEnabledPtr == true)
-            {
-                aResp->res.jsonValue["Boot"]["AutomaticRetryConfig"] =
-                    "RetryAttempts";
-                // If AutomaticRetry (AutoReboot) is enabled see how many
-                // attempts are left
-                crow::connections::systemBus->async_method_call(
-                    [aResp](const boost::system::error_code ec2,
-                            std::variant<uint32_t>& autoRebootAttemptsLeft) {
-                        if (ec2)
-                        {
-                            BMCWEB_LOG_DEBUG << "D-BUS response error " << ec2;
-                            return;
-                        }
-
-                        const uint32_t* autoRebootAttemptsLeftPtr =
-                            std::get_if<uint32_t>(&autoRebootAttemptsLeft);
-
-                        if (!autoRebootAttemptsLeftPtr)
-                        {
-                            messages::internalError(aResp->res);
-                            return;
-                        }
-
-                        BMCWEB_LOG_DEBUG << "Auto Reboot Attempts Left: "
-                                         << *autoRebootAttemptsLeftPtr;
+            retry->enabled = *autoRebootEnabledPtr;
+        });
 
-                        aResp->res
-                            .jsonValue["Boot"]
-                                      ["RemainingAutomaticRetryAttempts"] =
-                            *autoRebootAttemptsLeftPtr;
-                    },
-                    "xyz.openbmc_project.State.Host",
-                    "/xyz/openbmc_project/state/host0",
-                    "org.freedesktop.DBus.Properties", "Get",
-                    "xyz.openbmc_project.Control.Boot.RebootAttempts",
-                    "AttemptsLeft");
-            }
-            else
+    plan->add("xyz.openbmc_project.State.Host",
+              "/xyz/openbmc_project/state/host0",
+              "xyz.openbmc_project.Control.Boot.RebootAttempts",
+              [aResp, retry](const boost::system::error_code& ec,
+                             const dbus::utility::DBusPropertiesMap&
+                                 properties) {
+                  if (ec)
+                  {
+                      BMCWEB_LOG_DEBUG << "D-BUS response error " << ec;
+                      return;
+                  }
+                  auto attemptsLeft = properties.find("AttemptsLeft");
+                  if (attemptsLeft == properties.end())
+                  {
+                      return;
+                  }
+                  const uint32_t* attemptsLeftPtr =
+                      std::get_if<uint32_t>(&attemptsLeft->second);
+                  if (!attemptsLeftPtr)
+                  {
+                      messages::internalError(aResp->res);
+                      return;
+                  }
+                  retry->attemptsLeft = *attemptsLeftPtr;
+              });
+
+    plan->addCompletion([aResp, retry]() {
+        if (!retry->enabled)
+        {
+            return;
+        }
+        if (*retry->enabled)
+        {
+            aResp->res.jsonValue["Boot"]["AutomaticRetryConfig"] =
+                "RetryAttempts";
+            // If AutomaticRetry (AutoReboot) is enabled see how many
+            // attempts are left
+            if (retry->attemptsLeft)
             {
-                aResp->res.jsonValue["Boot"]["AutomaticRetryConfig"] =
-                    "Disabled";
-            }
+                BMCWEB_LOG_DEBUG << "Auto Reboot Attempts Left: "
+                                 << *retry->attemptsLeft;
 
-            // Not on D-Bus. Hardcoded here:
-            // https://github.com/openbmc/phosphor-state-manager/blob/1dbbef42675e94fb1f78edb87d6b11380260535a/meson_options.txt#L71
-            aResp->res.jsonValue["Boot"]["AutomaticRetryAttempts"] = 3;
+                aResp->res
+                    .jsonValue["Boot"]["RemainingAutomaticRetryAttempts"] =
+                    *retry->attemptsLeft;
+            }
+        }
+        else
+        {
+            aResp->res.jsonValue["Boot"]["AutomaticRetryConfig"] = "Disabled";
+        }
 
-            // "AutomaticRetryConfig" can be 3 values, Disabled, RetryAlways,
-            // and RetryAttempts. OpenBMC only supports Disabled and
-            // RetryAttempts.
-            aResp->res.jsonValue["Boot"]["AutomaticRetryConfig@Redfish."
-                                         "AllowableValues"] = {"Disabled",
-                                                               "RetryAttempts"};
-        },
-        "xyz.openbmc_project.Settings",
-        "/xyz/openbmc_project/control/host0/auto_reboot",
-        "org.freedesktop.DBus.Properties", "Get",
-        "xyz.openbmc_project.Control.Boot.RebootPolicy", "AutoReboot");
+        // Not on D-Bus. Hardcoded here:
+        // https://github.com/openbmc/phosphor-state-manager/blob/1dbbef42675e94fb1f78edb87d6b11380260535a/meson_options.txt#L71
+        aResp->res.jsonValue["Boot"]["AutomaticRetryAttempts"] = 3;
+
+        // "AutomaticRetryConfig" can be 3 values, Disabled, RetryAlways,
+        // and RetryAttempts. OpenBMC only supports Disabled and
+        // RetryAttempts.
+        aResp->res.jsonValue["Boot"]["AutomaticRetryConfig@Redfish."
+                                     "AllowableValues"] = {"Disabled",
+                                                           "RetryAttempts"};
+    });
 }
 
 /**
@@ -946,18 +955,27 @@ inline void getAutomaticRetry(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
  * @return None.
  */
 inline void
-    getPowerRestorePolicy(const std::shared_ptr<bmcweb::AsyncResp>& aResp)
+    getPowerRestorePolicy(const std::shared_ptr<bmcweb::AsyncResp>& aResp,
+                          const std::shared_ptr<PropertyPlan>& plan)
 {
     BMCWEB_LOG_DEBUG << "Get power restore policy";
 
-    crow::connections::systemBus->async_method_call(
-        [aResp](const boost::system::error_code ec,
-                std::variant<std::string>& policy) {
+    plan->add(
+        "xyz.openbmc_project.Settings",
+        "/xyz/openbmc_project/control/host0/power_restore_policy",
+        "xyz.openbmc_project.Control.Power.RestorePolicy",
+        [aResp](const boost::system::error_code& ec,
+                const dbus::utility::DBusPropertiesMap& properties) {
             if (ec)
             {
                 BMCWEB_LOG_DEBUG << "DBUS response error " << ec;
                 return;
             }
+            auto policy = properties.find("PowerRestorePolicy");
+            if (policy == properties.end())
+            {
+                return;
+            }
 
             const boost::container::flat_map<std::string, std::string>
                 policyMaps = {
@@ -971,7 +989,8 @@ inline void
                      "Restore",
                      "LastState"}};
 
-            const std::string* policyPtr = std::get_if<std::string>(&policy);
+            const std::string* policyPtr =
+                std::get_if<std::string>(&policy->second);
 
             if (!policyPtr)
             {
@@ -987,12 +1006,7 @@ inline void
             }
 
             aResp->res.jsonValue["PowerRestorePolicy"] = policyMapsIt->second;
-        },
-        "xyz.openbmc_project.Settings",
-        "/xyz/openbmc_project/control/host0/power_restore_policy",
-        "org.freedesktop.DBus.Properties", "Get",
-        "xyz.openbmc_project.Control.Power.RestorePolicy",
-        "PowerRestorePolicy");
+        });
 }
 
 /**
@@ -2721,14 +2735,19 @@ inline void requestRoutesSystems(App& app)
             // TODO (Gunnar): Remove IndicatorLED after enough time has passed
             getIndicatorLedState(asyncResp);
             getComputerSystem(asyncResp);
-            getHostState(asyncResp);
-            getBootProgress(asyncResp);
             getPCIeDeviceList(asyncResp, "PCIeDevices");
             getHostWatchdogTimer(asyncResp);
-            getPowerRestorePolicy(asyncResp);
             getStopBootOnFault(asyncResp);
-            getAutomaticRetry(asyncResp);
-            getLastResetTime(asyncResp);
+
+            // Fixed-path properties owned by the state manager and the
+            // settings daemon are fetched together
+            auto plan = std::make_shared<PropertyPlan>();
+            getHostState(asyncResp, plan);
+            getBootProgress(asyncResp, plan);
+            getPowerRestorePolicy(asyncResp, plan);
+            getAutomaticRetry(asyncResp, plan);
+            getLastResetTime(asyncResp, plan);
+            plan->run();
 #ifdef BMCWEB_ENABLE_IBM_LAMP_TEST
             getLampTestState(asyncResp);
 #endif
@@ -2893,6 +2912,21 @@ inline void requestRoutesSystems(App& app)
             });
 }
 
+inline nlohmann::json getSystemResetActionInfo()
+{
+    return {{"@odata.type", "#ActionInfo.v1_1_2.ActionInfo"},
+            {"@odata.id", "/redfish/v1/Systems/system/ResetActionInfo"},
+            {"Name", "Reset Action Info"},
+            {"Id", "ResetActionInfo"},
+            {"Parameters",
+             {{{"Name", "ResetType"},
+               {"Required", true},
+               {"DataType", "String"},
+               {"AllowableValues",
+                {"On", "ForceOff", "ForceOn", "GracefulRestart",
+                 "GracefulShutdown", "PowerCycle", "Nmi"}}}}}};
+}
+
 /**
  * SystemResetActionInfo derived class for delivering Computer Systems
  * ResetType AllowableValues using ResetInfo schema.
@@ -2905,20 +2939,12 @@ inline void requestRoutesSystemResetActionInfo(App& app)
     BMCWEB_ROUTE(app, "/redfish/v1/Systems/system/ResetActionInfo/")
         .privileges(redfish::privileges::getActionInfo)
         .methods(boost::beast::http::verb::get)(
-            [](const crow::Request&,
+            [](const crow::Request& req,
                const std::shared_ptr<bmcweb::AsyncResp>& asyncResp) {
-                asyncResp->res.jsonValue = {
-                    {"@odata.type", "#ActionInfo.v1_1_2.ActionInfo"},
-                    {"@odata.id", "/redfish/v1/Systems/system/ResetActionInfo"},
-                    {"Name", "Reset Action Info"},
-                    {"Id", "ResetActionInfo"},
-                    {"Parameters",
-                     {{{"Name", "ResetType"},
-                       {"Required", true},
-                       {"DataType", "String"},
-                       {"AllowableValues",
-                        {"On", "ForceOff", "ForceOn", "GracefulRestart",
-                         "GracefulShutdown", "PowerCycle", "Nmi"}}}}}};
+                immutable_response::send(
+                    req, asyncResp->res,
+                    "/redfish/v1/Systems/system/ResetActionInfo",
+                    getSystemResetActionInfo);
             });
 }
 } // namespace redfish
@@ -0,0 +1,91 @@
+#include "event_log_tail.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gmock/gmock.h"
+
+namespace redfish
+{
+
+class EventLogTailTest : public ::testing::Test
+{
+  protected:
+    EventLogTailTest() :
+        path(std::filesystem::temp_directory_path() /
+             ("event_log_tail_test_" + std::to_string(getpid())))
+    {}
+
+    ~EventLogTailTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    void append(const std::string& data)
+    {
+        std::ofstream(path, std::ios::app) << data;
+    }
+
+    std::filesystem::path path;
+};
+
+TEST_F(EventLogTailTest, ReadsOnlyCompleteAppendedRecords)
+{
+    append("old 1\n");
+    EventLogTail tail(path.string());
+    EXPECT_FALSE(tail.positioned());
+    tail.seekToEnd();
+    EXPECT_TRUE(tail.positioned());
+
+    std::error_code ec;
+    EXPECT_EQ("", tail.readAppended(ec));
+
+    append("new 1\nnew 2\nnew");
+    EXPECT_EQ("new 1\nnew 2\n", tail.readAppended(ec));
+    EXPECT_EQ("", tail.readAppended(ec));
+
+    // The held back part is completed by the next write
+    append(" 3\n");
+    EXPECT_EQ("new 3\n", tail.readAppended(ec));
+    EXPECT_FALSE(ec);
+}
+
+TEST_F(EventLogTailTest, StartsOverAfterRotation)
+{
+    append("old 1\nold 2\n");
+    EventLogTail tail(path.string());
+    tail.seekToEnd();
+
+    // Replaced by a new file, as logrotate does
+    std::filesystem::path rotated = path.string() + ".1";
+    std::filesystem::rename(path, rotated);
+    append("new 1\n");
+    std::error_code ec;
+    EXPECT_EQ("new 1\n", tail.readAppended(ec));
+    std::filesystem::remove(rotated);
+
+    // Truncated in place
+    std::filesystem::resize_file(path, 0);
+    EXPECT_EQ("", tail.readAppended(ec));
+    append("new 2\n");
+    EXPECT_EQ("new 2\n", tail.readAppended(ec));
+
+    // Gone, and created again later
+    std::filesystem::remove(path);
+    EXPECT_EQ("", tail.readAppended(ec));
+    append("new 3\n");
+    EXPECT_EQ("new 3\n", tail.readAppended(ec));
+    EXPECT_FALSE(ec);
+}
+
+TEST_F(EventLogTailTest, ReadsWholeFileWhenNotPositioned)
+{
+    append("old 1\n");
+    EventLogTail tail(path.string());
+    std::error_code ec;
+    EXPECT_EQ("old 1\n", tail.readAppended(ec));
+}
+
+} // namespace redfish
@@ -0,0 +1,82 @@
+#include "event_service_manager.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+namespace redfish
+{
+
+static std::shared_ptr<Subscription>
+    makeSubscription(const std::string& id,
+                     const std::vector<std::string>& registryPrefixes,
+                     const std::vector<std::string>& messageKeys)
+{
+    auto subscription =
+        std::make_shared<Subscription>("localhost", "80", "/", "http");
+    subscription->id = id;
+    subscription->registryPrefixes = registryPrefixes;
+    subscription->registryMsgIds = messageKeys;
+    subscription->compileFilter();
+    return subscription;
+}
+
+static std::vector<std::string> subscribers(const EventLogIndex& index,
+                                            std::string_view registryPrefix,
+                                            std::string_view messageKey)
+{
+    std::vector<std::string> ids;
+    index.forEach(registryPrefix, messageKey,
+                  [&ids](const std::shared_ptr<Subscription>& entry) {
+                      ids.push_back(entry->id);
+                  });
+    return ids;
+}
+
+TEST(EventLogIndex, FindsSubscriptionsByWhatTheyWant)
+{
+    EventLogIndex index;
+    index.add(makeSubscription("all", {}, {}));
+    index.add(makeSubscription("openbmc", {"OpenBMC"}, {}));
+    index.add(makeSubscription("started", {}, {"ServiceStarted"}));
+    index.add(makeSubscription("openbmcStarted", {"OpenBMC"},
+                               {"ServiceStarted"}));
+    index.add(makeSubscription("taskStarted", {"Task"}, {"ServiceStarted"}));
+
+    EXPECT_THAT(subscribers(index, "OpenBMC", "ServiceStarted"),
+                testing::UnorderedElementsAre("all", "openbmc", "started",
+                                              "openbmcStarted"));
+    EXPECT_THAT(subscribers(index, "OpenBMC", "ServiceFailed"),
+                testing::UnorderedElementsAre("all", "openbmc"));
+    EXPECT_THAT(subscribers(index, "Task", "ServiceStarted"),
+                testing::UnorderedElementsAre("all", "started",
+                                              "taskStarted"));
+    EXPECT_THAT(subscribers(index, "Base", "Success"),
+                testing::ElementsAre("all"));
+}
+
+TEST(EventLogIndex, ListsEachSubscriptionOnce)
+{
+    EventLogIndex index;
+    index.add(makeSubscription("both", {"OpenBMC", "Task"},
+                               {"ServiceStarted", "ServiceFailed"}));
+
+    EXPECT_THAT(subscribers(index, "Task", "ServiceFailed"),
+                testing::ElementsAre("both"));
+    EXPECT_TRUE(subscribers(index, "Base", "ServiceFailed").empty());
+    EXPECT_TRUE(subscribers(index, "Task", "Success").empty());
+}
+
+TEST(EventLogIndex, ClearForgetsEverySubscription)
+{
+    EventLogIndex index;
+    index.add(makeSubscription("all", {}, {}));
+    index.add(makeSubscription("openbmc", {"OpenBMC"}, {}));
+    index.clear();
+
+    EXPECT_TRUE(subscribers(index, "OpenBMC", "ServiceStarted").empty());
+}
+
+} // namespace redfish
@@ -0,0 +1,81 @@
+#include "utils/immutable_response.hpp"
+
+#include "gmock/gmock.h"
+
+TEST(ImmutableResponse, BuildsOnceAndServesCachedBody)
+{
+    int builds = 0;
+    auto build = [&builds]() {
+        builds++;
+        return nlohmann::json{{"Id", "Test"}};
+    };
+
+    boost::beast::http::request<boost::beast::http::string_body> req{};
+    std::error_code ec;
+    crow::Request reqIn(req, ec);
+    ASSERT_FALSE(ec);
+
+    crow::Response first;
+    redfish::immutable_response::send(reqIn, first, "/test/once", build);
+    crow::Response second;
+    redfish::immutable_response::send(reqIn, second, "/test/once", build);
+
+    EXPECT_EQ(builds, 1);
+    EXPECT_EQ(first.body(), "{\n  \"Id\": \"Test\"\n}");
+    EXPECT_EQ(second.body(), first.body());
+    EXPECT_TRUE(second.jsonValue.empty());
+    EXPECT_EQ((*second.stringResponse)["ETag"], (*first.stringResponse)["ETag"]);
+    EXPECT_EQ((*second.stringResponse)["Content-Type"], "application/json");
+}
+
+TEST(ImmutableResponse, MatchingIfNoneMatchIsNotModified)
+{
+    auto build = []() { return nlohmann::json{{"Id", "Etag"}}; };
+    const redfish::immutable_response::Document& doc =
+        redfish::immutable_response::getDocument("/test/etag", build);
+
+    boost::beast::http::request<boost::beast::http::string_body> req{};
+    req.set(boost::beast::http::field::if_none_match, doc.etag);
+    std::error_code ec;
+    crow::Request reqIn(req, ec);
+    ASSERT_FALSE(ec);
+
+    crow::Response res;
+    redfish::immutable_response::send(reqIn, res, "/test/etag", build);
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+    EXPECT_TRUE(res.body().empty());
+}
+
+TEST(ImmutableResponse, IfNoneMatchListWithWeakTagIsNotModified)
+{
+    auto build = []() { return nlohmann::json{{"Id", "List"}}; };
+    const redfish::immutable_response::Document& doc =
+        redfish::immutable_response::getDocument("/test/list", build);
+
+    boost::beast::http::request<boost::beast::http::string_body> req{};
+    req.set(boost::beast::http::field::if_none_match,
+            "\"stale\", W/" + doc.etag);
+    std::error_code ec;
+    crow::Request reqIn(req, ec);
+    ASSERT_FALSE(ec);
+
+    crow::Response res;
+    redfish::immutable_response::send(reqIn, res, "/test/list", build);
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+}
+
+TEST(ImmutableResponse, HtmlClientsGetTheJsonBack)
+{
+    auto build = []() { return nlohmann::json{{"Id", "Html"}}; };
+
+    boost::beast::http::request<boost::beast::http::string_body> req{};
+    req.set(boost::beast::http::field::accept, "text/html");
+    std::error_code ec;
+    crow::Request reqIn(req, ec);
+    ASSERT_FALSE(ec);
+
+    crow::Response res;
+    redfish::immutable_response::send(reqIn, res, "/test/html", build);
+    EXPECT_EQ(res.jsonValue, (nlohmann::json{{"Id", "Html"}}));
+    EXPECT_TRUE(res.body().empty());
+}
@@ -1,5 +1,7 @@
 #include "ibm/locks.hpp"
 
+#include <chrono>
+#include <random>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -73,6 +75,12 @@ class MockLock : public crow::ibm_mc_lock::Lock
         bool status = Lock::isConflictRequest(request);
         return status;
     }
+    bool isConflictRecord(const LockRequest& record1,
+                          const LockRequest& record2) override
+    {
+        bool status = Lock::isConflictRecord(record1, record2);
+        return status;
+    }
     Rc isConflictWithTable(const LockRequests& request) override
     {
         auto conflict = Lock::isConflictWithTable(request);
@@ -349,5 +357,128 @@ TEST_F(LockTest, ValidateSessionIDForGetlocklistGoodTestCase)
     ASSERT_EQ(1, result.size());
 }
 
+TEST_F(LockTest, LockIndexMatchesRecordComparison)
+{
+    MockLock lockManager;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::uniform_int_distribution<uint32_t> segmentCount(2, 6);
+    std::uniform_int_distribution<uint32_t> segmentLength(1, 2);
+    std::uniform_int_distribution<int> flag(0, 5);
+    // Few distinct bytes, so that resource ids often share a prefix
+    std::uniform_int_distribution<uint64_t> idByte(0, 2);
+
+    auto randomRecord = [&]() {
+        LockRequest r;
+        std::get<0>(r) = "xxxxx";
+        std::get<1>(r) = "hmc-id";
+        std::get<2>(r) = coin(gen) != 0 ? "Write" : "Read";
+        uint64_t id = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            id = (id << 8) | idByte(gen);
+        }
+        std::get<3>(r) = id;
+        SegmentFlags& segments = std::get<4>(r);
+        uint32_t count = segmentCount(gen);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            int f = flag(gen);
+            segments.emplace_back(f == 0   ? "LockAll"
+                                  : f == 1 ? "LockSame"
+                                           : "DontLock",
+                                  segmentLength(gen));
+        }
+        return r;
+    };
+
+    LockRequests table;
+    LockIndex index;
+    for (uint32_t i = 0; i < 400; i++)
+    {
+        table.push_back(randomRecord());
+        index.insert(table.back(), {i, 0});
+    }
+    // Drop some records again, so that erase is covered too
+    for (uint32_t i = 0; i < table.size(); i += 3)
+    {
+        index.erase(table[i], {i, 0});
+    }
+
+    for (int query = 0; query < 400; query++)
+    {
+        LockRequest record = randomRecord();
+        std::optional<uint32_t> expected;
+        for (uint32_t i = 0; i < table.size(); i++)
+        {
+            if (i % 3 != 0 && lockManager.isConflictRecord(record, table[i]))
+            {
+                expected = i;
+                break;
+            }
+        }
+        std::optional<LockIndex::RecordRef> found = index.findConflict(record);
+        ASSERT_EQ(expected.has_value(), found.has_value());
+        if (expected)
+        {
+            EXPECT_EQ(*expected, found->first);
+        }
+    }
+}
+
+TEST_F(LockTest, ReleaseLockBySessionId)
+{
+    MockLock lockManager;
+    lockManager.isConflictWithTable(request1);
+    LockRequests readRequest = request2;
+    std::get<0>(readRequest[0]) = "yyyyy";
+    std::get<2>(readRequest[0]) = "Read";
+    lockManager.isConflictWithTable(readRequest);
+
+    lockManager.releaseLock("xxxxx");
+    std::vector<std::string> sessionid = {"xxxxx", "yyyyy"};
+    auto result = std::get<std::vector<std::pair<uint32_t, LockRequests>>>(
+        lockManager.getLockList(sessionid));
+    ASSERT_EQ(1U, result.size());
+    EXPECT_EQ(2U, result[0].first);
+
+    // Only the lock that is left can conflict
+    auto rc = lockManager.isConflictWithTable(request2);
+    ASSERT_TRUE(rc.first);
+    auto conflict = std::get<std::pair<uint32_t, LockRequest>>(rc.second);
+    EXPECT_EQ(2U, conflict.first);
+}
+
+// Times conflict checks against lock tables of increasing size.  The index
+// keeps the cost per check close to flat; the timings are recorded as test
+// properties.
+TEST_F(LockTest, ConflictCheckScalesWithTableSize)
+{
+    for (uint32_t tableSize : {1000U, 16000U})
+    {
+        MockLock lockManager;
+        LockRequests lock = {
+            {"xxxxx", "hmc-id", "Write", 0, {{"DontLock", 2}, {"LockSame", 4}}}};
+        for (uint32_t i = 0; i < tableSize; i++)
+        {
+            // Every lock is on a different resource
+            std::get<3>(lock[0]) = static_cast<uint64_t>(i) << 32;
+            ASSERT_FALSE(lockManager.isConflictWithTable(lock).first);
+        }
+
+        constexpr uint32_t queries = 2000;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < queries; i++)
+        {
+            std::get<3>(lock[0]) = static_cast<uint64_t>(i % tableSize) << 32;
+            ASSERT_TRUE(lockManager.isConflictWithTable(lock).first);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+        RecordProperty("NsPerCheckWith" + std::to_string(tableSize) + "Locks",
+                       std::to_string(elapsed.count() / queries));
+    }
+}
+
 } // namespace ibm_mc_lock
 } // namespace crow
@@ -0,0 +1,72 @@
+#include "utils/metric_report_ring.hpp"
+
+#include <string>
+
+#include "gmock/gmock.h"
+
+namespace redfish
+{
+namespace telemetry
+{
+
+static TimestampReadings makeUpdate(uint64_t timestamp, double value)
+{
+    return {timestamp,
+            {{"Metric1", "/sensors/1", value, timestamp},
+             {"Metric2", "/sensors/2", value * 2, timestamp}}};
+}
+
+TEST(ReadingsRing, ServesNewestUpdate)
+{
+    ReadingsRing ring;
+    EXPECT_EQ(0U, ring.timestamp());
+    EXPECT_TRUE(ring.metricValues(std::nullopt).empty());
+
+    ring.push(makeUpdate(100, 1.0));
+    ring.push(makeUpdate(200, 2.0));
+    EXPECT_EQ(200U, ring.timestamp());
+
+    nlohmann::json values = ring.metricValues(std::nullopt);
+    ASSERT_EQ(2U, values.size());
+    EXPECT_EQ("Metric1", values[0]["MetricId"]);
+    EXPECT_EQ("/sensors/2", values[1]["MetricProperty"]);
+    EXPECT_EQ(std::to_string(4.0), values[1]["MetricValue"]);
+
+    // Delivered again by a Get after the signal
+    ring.push(makeUpdate(200, 2.0));
+    EXPECT_EQ(2U, ring.size());
+}
+
+TEST(ReadingsRing, ServesValuesSinceTimestamp)
+{
+    ReadingsRing ring;
+    for (uint64_t i = 1; i <= ReadingsRing::maxUpdates + 5; i++)
+    {
+        ring.push(makeUpdate(i * 10, static_cast<double>(i)));
+    }
+    EXPECT_EQ(ReadingsRing::maxUpdates, ring.size());
+
+    nlohmann::json values = ring.metricValues(ReadingsRing::maxUpdates * 10);
+    ASSERT_EQ(10U, values.size());
+    EXPECT_EQ(std::to_string(static_cast<double>(ReadingsRing::maxUpdates + 1)),
+              values[0]["MetricValue"]);
+
+    // Everything kept, oldest first
+    values = ring.metricValues(0);
+    ASSERT_EQ(2 * ReadingsRing::maxUpdates, values.size());
+    EXPECT_EQ(std::to_string(6.0), values[0]["MetricValue"]);
+}
+
+TEST(ReadingsRing, StartsOverWhenMetricsChange)
+{
+    ReadingsRing ring;
+    ring.push(makeUpdate(100, 1.0));
+    ring.push({200, {{"Metric3", "/sensors/3", 3.0, 200}}});
+    EXPECT_EQ(1U, ring.size());
+    nlohmann::json values = ring.metricValues(0);
+    ASSERT_EQ(1U, values.size());
+    EXPECT_EQ("Metric3", values[0]["MetricId"]);
+}
+
+} // namespace telemetry
+} // namespace redfish
@@ -0,0 +1,39 @@
+#include "metric_report.hpp"
+
+#include <string>
+
+#include "gmock/gmock.h"
+
+namespace redfish
+{
+namespace telemetry
+{
+
+TEST(ReportStore, ReportFirstSeenInASignalStillNeedsItsType)
+{
+    ReportStore& store = ReportStore::getInstance();
+    // What the PropertiesChanged handler does for a report it hasn't seen
+    store.update("signalled", {100, {{"Metric1", "/sensors/1", 1.0, 100}}});
+    const ReportStore::Report* report = store.find("signalled");
+    ASSERT_NE(report, nullptr);
+    EXPECT_FALSE(report->typeKnown());
+    EXPECT_FALSE(report->answeredFromStore());
+
+    store.setReportingType("signalled", "Periodic");
+    EXPECT_TRUE(report->typeKnown());
+    EXPECT_TRUE(report->answeredFromStore());
+
+    store.setReportingType("signalled", "OnRequest");
+    EXPECT_TRUE(report->typeKnown());
+    EXPECT_FALSE(report->answeredFromStore());
+}
+
+TEST(ReportStore, TypeOfAnUnknownReportIsIgnored)
+{
+    ReportStore& store = ReportStore::getInstance();
+    store.setReportingType("never_seen", "Periodic");
+    EXPECT_EQ(store.find("never_seen"), nullptr);
+}
+
+} // namespace telemetry
+} // namespace redfish
@@ -0,0 +1,66 @@
+#include "registries.hpp"
+#include "registries/base_message_registry.hpp"
+#include "registries/openbmc_message_registry.hpp"
+
+#include <string_view>
+
+#include <gmock/gmock.h>
+
+using namespace redfish::message_registries;
+
+TEST(RegistriesTest, ParseMessageId)
+{
+    std::optional<MessageId> id =
+        parseMessageId("OpenBMC.0.2.BIOSPOSTCodeASCII");
+    ASSERT_TRUE(id);
+    EXPECT_EQ(id->registryName, "OpenBMC");
+    EXPECT_EQ(id->majorVersion, "0");
+    EXPECT_EQ(id->minorVersion, "2");
+    EXPECT_EQ(id->messageKey, "BIOSPOSTCodeASCII");
+
+    EXPECT_FALSE(parseMessageId(""));
+    EXPECT_FALSE(parseMessageId("OpenBMC"));
+    EXPECT_FALSE(parseMessageId("OpenBMC.0.BIOSPOSTCodeASCII"));
+    EXPECT_FALSE(parseMessageId("OpenBMC.0.2.BIOSPOSTCodeASCII.Extra"));
+
+    static_assert(parseMessageId("Base.1.11.Success")->messageKey ==
+                  "Success");
+}
+
+TEST(RegistriesTest, IndexIsSorted)
+{
+    for (size_t i = 1; i < openbmc::registryIndex.size(); i++)
+    {
+        EXPECT_LT(
+            std::string_view(openbmc::registry[openbmc::registryIndex[i - 1]]
+                                 .first),
+            std::string_view(
+                openbmc::registry[openbmc::registryIndex[i]].first));
+    }
+}
+
+TEST(RegistriesTest, FindEveryEntry)
+{
+    RegistryView view(openbmc::registry, openbmc::registryIndex);
+    for (const MessageEntry& entry : openbmc::registry)
+    {
+        EXPECT_EQ(view.find(entry.first), &entry.second);
+    }
+    RegistryView baseView(base::registry, base::registryIndex);
+    for (const MessageEntry& entry : base::registry)
+    {
+        EXPECT_EQ(baseView.find(entry.first), &entry.second);
+    }
+}
+
+TEST(RegistriesTest, FindMissingEntry)
+{
+    RegistryView view(openbmc::registry, openbmc::registryIndex);
+    EXPECT_EQ(view.find(""), nullptr);
+    EXPECT_EQ(view.find("NotAMessage"), nullptr);
+    EXPECT_EQ(view.findEntry("BIOSPOSTCodeASCI"), nullptr);
+    EXPECT_NE(view.findEntry("BIOSPOSTCodeASCII"), nullptr);
+
+    RegistryView empty;
+    EXPECT_EQ(empty.find("Success"), nullptr);
+}
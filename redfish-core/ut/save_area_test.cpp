@@ -0,0 +1,79 @@
+#include "ibm/save_area.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "gmock/gmock.h"
+
+namespace crow
+{
+namespace ibm_mc
+{
+
+class SaveAreaTest : public ::testing::Test
+{
+  protected:
+    SaveAreaTest() :
+        dir(std::filesystem::temp_directory_path() /
+            ("save_area_test_" + std::to_string(getpid())))
+    {
+        std::filesystem::create_directories(dir);
+    }
+
+    ~SaveAreaTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(SaveAreaTest, WriteKeepsRunningTotal)
+{
+    SaveArea saveArea(dir, 1000);
+    std::error_code ec;
+
+    EXPECT_TRUE(saveArea.write("file1", std::string(300, 'a'), ec));
+    EXPECT_TRUE(saveArea.write("file2", std::string(400, 'b'), ec));
+    EXPECT_EQ(700U, saveArea.totalSize(ec));
+
+    // Replacing a file only counts the growth
+    EXPECT_TRUE(saveArea.fits("file2", 700, ec));
+    EXPECT_FALSE(saveArea.fits("file2", 701, ec));
+    EXPECT_FALSE(saveArea.fits("file3", 301, ec));
+
+    EXPECT_TRUE(saveArea.write("file2", std::string(100, 'c'), ec));
+    EXPECT_EQ(400U, saveArea.totalSize(ec));
+    EXPECT_EQ(100U, std::filesystem::file_size(dir / "file2"));
+
+    EXPECT_TRUE(saveArea.remove("file1", ec));
+    EXPECT_FALSE(saveArea.remove("file1", ec));
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(100U, saveArea.totalSize(ec));
+    EXPECT_FALSE(std::filesystem::exists(dir / "file1"));
+}
+
+TEST_F(SaveAreaTest, LoadsExistingFiles)
+{
+    std::ofstream(dir / "existing") << std::string(250, 'x');
+    // Left over from an interrupted write
+    std::ofstream(dir / ".partial.tmp") << "xx";
+
+    SaveArea saveArea(dir, 1000);
+    std::error_code ec;
+    EXPECT_EQ(250U, saveArea.totalSize(ec));
+    ASSERT_EQ(1U, saveArea.list(ec).size());
+    EXPECT_EQ("existing", saveArea.list(ec).begin()->first);
+    EXPECT_FALSE(std::filesystem::exists(dir / ".partial.tmp"));
+
+    std::string data;
+    EXPECT_TRUE(saveArea.read("existing", data, ec));
+    EXPECT_EQ(std::string(250, 'x'), data);
+    EXPECT_FALSE(saveArea.read("missing", data, ec));
+    EXPECT_FALSE(ec);
+}
+
+} // namespace ibm_mc
+} // namespace crow
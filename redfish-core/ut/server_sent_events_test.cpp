@@ -0,0 +1,77 @@
+#include "server_sent_events.hpp"
+
+#include <string>
+
+#include "gmock/gmock.h"
+
+namespace crow
+{
+
+TEST(SseEventRing, FramesAndNumbersEvents)
+{
+    SseEventRing ring;
+    EXPECT_FALSE(ring.inUse());
+    EXPECT_EQ(1U, ring.push({}, "{\n  \"Id\": 1\n}"));
+    EXPECT_EQ(2U, ring.push({}, "second"));
+
+    std::shared_ptr<const SseEvent> event = ring.get(1);
+    ASSERT_NE(nullptr, event);
+    EXPECT_EQ("id: 1\ndata: {\ndata:   \"Id\": 1\ndata: }\n\n", event->framed);
+    EXPECT_EQ(nullptr, ring.get(3));
+}
+
+TEST(SseEventRing, DropsOldestEvents)
+{
+    SseEventRing ring;
+    for (size_t i = 0; i < SseEventRing::maxEvents + 10; i++)
+    {
+        ring.push({}, "event");
+    }
+    EXPECT_EQ(11U, ring.firstId());
+    EXPECT_EQ(SseEventRing::maxEvents + 11, ring.nextId());
+    EXPECT_EQ(nullptr, ring.get(10));
+    EXPECT_NE(nullptr, ring.get(11));
+
+    // Big events are bounded by size instead
+    ring.push({}, std::string(SseEventRing::maxBytes, 'a'));
+    EXPECT_EQ(ring.nextId() - 1, ring.firstId());
+}
+
+TEST(SseEventRing, ResumesAfterLastEventId)
+{
+    SseEventRing ring;
+    ring.push({}, "1");
+    ring.push({}, "2");
+
+    // New clients only get new events
+    EXPECT_EQ(3U, ring.resumeId(""));
+    EXPECT_EQ(2U, ring.resumeId("1"));
+    // Ids from before a restart, or garbage, are reported as missed
+    EXPECT_EQ(0U, ring.resumeId("7"));
+    EXPECT_EQ(0U, ring.resumeId("abc"));
+}
+
+TEST(SseFilter, EmptyListsAndTagsMatch)
+{
+    SseEvent logEvent;
+    logEvent.formatType = "Event";
+    logEvent.registryPrefix = "OpenBMC";
+    logEvent.messageKey = "ServiceStarted";
+
+    SseFilter filter;
+    EXPECT_TRUE(filter.matches(logEvent));
+
+    filter.registryPrefixes = {"Base", "OpenBMC"};
+    EXPECT_TRUE(filter.matches(logEvent));
+    filter.messageKeys = {"ServiceFailed"};
+    EXPECT_FALSE(filter.matches(logEvent));
+
+    // Untagged events go to everyone
+    EXPECT_TRUE(filter.matches(SseEvent{}));
+
+    filter = SseFilter{};
+    filter.formatType = "MetricReport";
+    EXPECT_FALSE(filter.matches(logEvent));
+}
+
+} // namespace crow
@@ -110,7 +110,12 @@ for file, json_dict, namespace, url in files:
             registry.write("},")
             registry.write("\"{}\",".format(message["Resolution"]))
             registry.write("}},")
-        registry.write("};}\n")
+        registry.write("};")
+        registry.write(
+            "constexpr RegistryIndex<{}> registryIndex = "
+            "makeRegistryIndex(registry);\n".format(
+                len(json_dict["Messages"])))
+        registry.write("}\n")
     clang_format(file)
 
 
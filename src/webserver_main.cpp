@@ -1,4 +1,5 @@
 #include <bmcweb_config.h>
+#include <fcntl.h>
 #include <systemd/sd-daemon.h>
 
 #include <app.hpp>
@@ -17,10 +18,14 @@
 #include <obmc_hypervisor.hpp>
 #include <obmc_shell.hpp>
 #include <openbmc_dbus_rest.hpp>
+#include <persistent_data.hpp>
 
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
 #include <event_dbus_monitor.hpp>
 #include <ibm/management_console_rest.hpp>
+// Each worker would grant locks from a table of its own
+static_assert(bmcwebWorkerProcesses == 0,
+              "The IBM management console needs a single process");
 #endif
 #include <redfish.hpp>
 #include <redfish_v1.hpp>
@@ -29,8 +34,10 @@
 #include <sdbusplus/server.hpp>
 #include <security_headers.hpp>
 #include <ssl_key_handler.hpp>
+#include <startup_timing.hpp>
 #include <vm_websocket.hpp>
 #include <webassets.hpp>
+#include <worker_pool.hpp>
 
 #include <memory>
 #include <string>
@@ -43,6 +50,15 @@ constexpr int defaultPort = 18080;
 
 inline void setupSocket(crow::App& app)
 {
+    int sharedFd = crow::workers::Pool::getInstance().listenFd();
+    if (sharedFd >= 0)
+    {
+        BMCWEB_LOG_INFO << "Starting worker "
+                        << crow::workers::Pool::getInstance().index()
+                        << " on socket handle " << sharedFd;
+        app.socket(sharedFd);
+        return;
+    }
     int listenFd = sd_listen_fds(0);
     if (1 == listenFd)
     {
@@ -69,8 +85,115 @@ inline void setupSocket(crow::App& app)
     }
 }
 
+// The socket the workers share, the one systemd passed or else a new one on
+// defaultPort
+inline int openSharedSocket(boost::asio::io_context& io)
+{
+    if (1 == sd_listen_fds(0) &&
+        sd_is_socket_inet(SD_LISTEN_FDS_START, AF_UNSPEC, SOCK_STREAM, 1, 0))
+    {
+        BMCWEB_LOG_INFO << "Workers share socket handle "
+                        << SD_LISTEN_FDS_START;
+        return SD_LISTEN_FDS_START;
+    }
+    BMCWEB_LOG_INFO << "Workers share port " << defaultPort;
+    boost::asio::ip::tcp::acceptor acceptor(
+        io, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v6(),
+                                           defaultPort));
+    int fd = acceptor.release();
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return fd;
+}
+
+// Keeps sessions and event subscriptions the same in all of the processes
+inline void replicateState()
+{
+    crow::workers::Pool& pool = crow::workers::Pool::getInstance();
+    pool.onMessage("session", [](const nlohmann::json& change) {
+        persistent_data::SessionStore::getInstance().applyChange(change);
+    });
+    pool.addSnapshot([]() {
+        return persistent_data::SessionStore::getInstance().snapshot();
+    });
+    pool.onMessage("event_service", [](const nlohmann::json& change) {
+        redfish::EventServiceManager::getInstance().applyChange(change);
+    });
+    pool.addSnapshot([]() {
+        return redfish::EventServiceManager::getInstance().snapshot();
+    });
+}
+
+// Watches for what the event service sends, and for what the certificate
+// follows.  With several processes, only the coordinator does.
+inline int startMonitors(boost::asio::io_context& io)
+{
+#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
+    int rc = redfish::EventServiceManager::startEventLogMonitor(io);
+    if (rc)
+    {
+        BMCWEB_LOG_ERROR << "Redfish event handler setup failed...";
+        return rc;
+    }
+    crow::startup::mark("event log monitor");
+#else
+    (void)io;
+#endif
+
+#ifdef BMCWEB_ENABLE_SSL
+    BMCWEB_LOG_INFO << "Start Hostname Monitor Service...";
+    crow::hostname_monitor::registerHostnameSignal();
+#endif
+
+#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
+    // Start BMC and Host state change dbus monitor
+    crow::dbus_monitor::registerStateChangeSignal();
+    // Start Dump created signal monitor for BMC and System Dump
+    crow::dbus_monitor::registerDumpUpdateSignal();
+    // Start BIOS Attr change dbus monitor
+    crow::dbus_monitor::registerBIOSAttrUpdateSignal();
+    // Start event log entry created monitor
+    crow::dbus_monitor::registerEventLogCreatedSignal();
+    // Start PostCode change signal
+    crow::dbus_monitor::registerPostCodeChangeSignal();
+#endif
+    crow::startup::mark("signal monitors");
+    return 0;
+}
+
+// With worker-processes set, this process starts the workers that serve
+// HTTP, keeps them running, and does what is done once for all of them
+inline int runCoordinator(boost::asio::io_context& io)
+{
+    int listenFd = openSharedSocket(io);
+#ifdef BMCWEB_ENABLE_SSL
+    // Once here, rather than by every worker at the same time
+    ensuressl::ensureOpensslKeyPresentAndValid(ensuressl::serverCertFile());
+    crow::startup::mark("certificate");
+#endif
+    replicateState();
+    // For the SSE streams of the workers
+    redfish::EventServiceManager::getInstance().getSseEvents().keepEvents();
+    crow::workers::Pool::getInstance().startCoordinator(
+        io, bmcwebWorkerProcesses, listenFd);
+    crow::startup::mark("workers");
+
+    int rc = startMonitors(io);
+    if (rc)
+    {
+        crow::workers::Pool::getInstance().stopWorkers();
+        return rc;
+    }
+    // Connections wait in the backlog of the socket until a worker is ready
+    crow::startup::Timings::getInstance().accepting();
+    io.run();
+    crow::workers::Pool::getInstance().stopWorkers();
+    return 0;
+}
+
 int main(int /*argc*/, char** /*argv*/)
 {
+    crow::startup::mark("exec");
+
     // If user has enabled logging, set level at debug so we get everything
 #ifdef BMCWEB_ENABLE_LOGGING
     crow::Logger::setLogLevel(crow::LogLevel::Debug);
@@ -85,11 +208,28 @@ int main(int /*argc*/, char** /*argv*/)
     crow::connections::systemBus =
         std::make_shared<sdbusplus::asio::connection>(*io);
 
+    persistent_data::getConfig().startFlushTimer(*io);
+    crow::startup::mark("persistent data");
+
+    if (bmcwebWorkerProcesses > 0 && !crow::workers::isWorker())
+    {
+        int rc = runCoordinator(*io);
+        persistent_data::getConfig().stopFlushTimer();
+        crow::connections::systemBus.reset();
+        return rc;
+    }
+    if (crow::workers::isWorker())
+    {
+        replicateState();
+        crow::workers::Pool::getInstance().startWorker(*io);
+    }
+
     // Static assets need to be initialized before Authorization, because auth
     // needs to build the whitelist from the static routes
 
 #ifdef BMCWEB_ENABLE_STATIC_HOSTING
     crow::webassets::requestRoutes(app);
+    crow::startup::mark("static assets");
 #endif
 
 #ifdef BMCWEB_ENABLE_KVM
@@ -99,6 +239,7 @@ int main(int /*argc*/, char** /*argv*/)
 #ifdef BMCWEB_ENABLE_REDFISH
     redfish::requestRoutes(app);
     redfish::RedfishService redfish(app);
+    crow::startup::mark("redfish routes");
 #endif
 
 #ifdef BMCWEB_ENABLE_DBUS_REST
@@ -128,7 +269,6 @@ int main(int /*argc*/, char** /*argv*/)
 
 #ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
     crow::ibm_mc::requestRoutes(app);
-    crow::ibm_mc_lock::Lock::getInstance();
 #endif
 
 #ifdef BMCWEB_ENABLE_GOOGLE_API
@@ -148,40 +288,24 @@ int main(int /*argc*/, char** /*argv*/)
     crow::nbd_proxy::requestRoutes(app);
 #endif
 
-#ifndef BMCWEB_ENABLE_REDFISH_DBUS_LOG_ENTRIES
-    int rc = redfish::EventServiceManager::startEventLogMonitor(*io);
-    if (rc)
-    {
-        BMCWEB_LOG_ERROR << "Redfish event handler setup failed...";
-        return rc;
-    }
-#endif
-
-#ifdef BMCWEB_ENABLE_SSL
-    BMCWEB_LOG_INFO << "Start Hostname Monitor Service...";
-    crow::hostname_monitor::registerHostnameSignal();
-#endif
-
-#ifdef BMCWEB_ENABLE_IBM_MANAGEMENT_CONSOLE
-    // Start BMC and Host state change dbus monitor
-    crow::dbus_monitor::registerStateChangeSignal();
-    // Start Dump created signal monitor for BMC and System Dump
-    crow::dbus_monitor::registerDumpUpdateSignal();
-    // Start BIOS Attr change dbus monitor
-    crow::dbus_monitor::registerBIOSAttrUpdateSignal();
-    // Start event log entry created monitor
-    crow::dbus_monitor::registerEventLogCreatedSignal();
-    // Start PostCode change signal
-    crow::dbus_monitor::registerPostCodeChangeSignal();
-#endif
-
 #ifdef BMCWEB_ENABLE_REDFISH_DUMP_LOG
     crow::obmc_dump::requestRoutes(app);
 #endif
+    crow::startup::mark("other routes");
+
+    if (!crow::workers::isWorker())
+    {
+        int rc = startMonitors(*io);
+        if (rc)
+        {
+            return rc;
+        }
+    }
 
     app.run();
     io->run();
 
+    persistent_data::getConfig().stopFlushTimer();
     crow::connections::systemBus.reset();
     return 0;
 }